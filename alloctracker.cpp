@@ -0,0 +1,341 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * alloctracker.cpp
+ *
+ * This file implements AllocTracker and the allocation hooks that
+ * feed it.
+ *
+ * Hooks (compiled in only with the CAFETERIA_ALLOC_HOOKS CMake
+ * option, which is off by default; without them the tracker stays
+ * off and the process keeps the platform allocator untouched):
+ *   - glibc (Linux kiosks): malloc/calloc/realloc/free are replaced
+ *     and forward to glibc's __libc_* functions. Qt allocates string
+ *     and container storage with malloc, not operator new, so this
+ *     is the only way to see MainWindow's QString traffic. C++ new
+ *     goes through malloc and is counted too.
+ *   - Elsewhere: the global operator new/delete are replaced, which
+ *     counts C++ allocations only.
+ *
+ * Do not combine with ASan/Valgrind, which install their own malloc.
+ *
+ ******************************************************************/
+
+#include "alloctracker.h"
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <cstdlib>
+#include <new>
+
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+std::atomic<bool> AllocTracker::enabled{false};
+
+namespace {
+
+/******************************************************************
+ * ThreadState
+ *
+ * Per-thread counters. Plain data with no constructor, so touching
+ * it from inside malloc never allocates.
+ ******************************************************************/
+struct ThreadState {
+    quint64 allocations;
+    quint64 bytes;
+    quint64 frees;
+    bool suspended;     // True while the tracker updates its own table
+};
+
+thread_local ThreadState threadState;
+
+inline void countAllocation(std::size_t size)
+{
+    if (AllocTracker::enabled.load(std::memory_order_relaxed) && !threadState.suspended) {
+        ++threadState.allocations;
+        threadState.bytes += size;
+    }
+}
+
+inline void countFree(void *p)
+{
+    if (p && AllocTracker::enabled.load(std::memory_order_relaxed) && !threadState.suspended) {
+        ++threadState.frees;
+    }
+}
+
+/******************************************************************
+ * OperationStats
+ *
+ * Totals for one operation name.
+ ******************************************************************/
+struct OperationStats {
+    quint64 calls = 0;
+    quint64 allocations = 0;
+    quint64 bytes = 0;
+    quint64 frees = 0;
+    quint64 maxAllocations = 0;   // Worst single call
+    long peakRssKb = 0;           // Highest process peak seen after a call
+    long rssGrowthKb = 0;         // Peak RSS increase during calls
+};
+
+QMutex statsMutex;                         // Guards operations
+QMap<QString, OperationStats> operations;  // Sorted by name for the report
+
+} // namespace
+
+// ========== ALLOCATION HOOKS ==========
+
+#if defined(CAFETERIA_ALLOC_HOOKS)
+
+#if defined(__GLIBC__)
+
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *p, size_t size);
+void __libc_free(void *p);
+
+void *malloc(size_t size) __THROW
+{
+    countAllocation(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) __THROW
+{
+    countAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, size_t size) __THROW
+{
+    // A resize counts as a new allocation plus a free of the old block
+    countAllocation(size);
+    countFree(p);
+    return __libc_realloc(p, size);
+}
+
+void free(void *p) __THROW
+{
+    countFree(p);
+    __libc_free(p);
+}
+
+} // extern "C"
+
+#else
+
+void *operator new(std::size_t size)
+{
+    countAllocation(size);
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    countAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept
+{
+    countFree(p);
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept { ::operator delete(p); }
+void operator delete(void *p, std::size_t) noexcept { ::operator delete(p); }
+void operator delete[](void *p, std::size_t) noexcept { ::operator delete(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { ::operator delete(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { ::operator delete(p); }
+
+#endif
+
+#endif // CAFETERIA_ALLOC_HOOKS
+
+// ========== TRACKER ==========
+
+/******************************************************************
+ * AllocTracker::initFromEnvironment --
+ *   Enable counting when CAFETERIA_ALLOC_TRACK is set and not "0"
+ *   and the allocation hooks are built in (warns otherwise).
+ *
+ * Parameters: none
+ * Modifies:
+ *   - enabled
+ *
+ * Returns: nothing
+ ******************************************************************/
+void AllocTracker::initFromEnvironment()
+{
+    QString value = qEnvironmentVariable("CAFETERIA_ALLOC_TRACK");
+    if (value.isEmpty() || value == "0") {
+        return;
+    }
+#if defined(CAFETERIA_ALLOC_HOOKS)
+    enabled.store(true, std::memory_order_relaxed);
+#else
+    qWarning("CAFETERIA_ALLOC_TRACK ignored: build with -DCAFETERIA_ALLOC_HOOKS=ON "
+             "to count allocations");
+#endif
+}
+
+/******************************************************************
+ * AllocTracker::threadCounts --
+ *   Running allocation totals of the calling thread.
+ ******************************************************************/
+AllocCounts AllocTracker::threadCounts()
+{
+    AllocCounts counts;
+    counts.allocations = threadState.allocations;
+    counts.bytes = threadState.bytes;
+    counts.frees = threadState.frees;
+    return counts;
+}
+
+/******************************************************************
+ * AllocTracker::peakRssKb --
+ *   Peak resident set size from getrusage(). ru_maxrss is in KiB on
+ *   Linux and in bytes on macOS.
+ *
+ * Parameters: none
+ *
+ * Returns:
+ *   peak RSS in KiB, or 0 if unavailable
+ ******************************************************************/
+long AllocTracker::peakRssKb()
+{
+#if defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(Q_OS_MACOS)
+    return long(usage.ru_maxrss / 1024);
+#else
+    return long(usage.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+}
+
+/******************************************************************
+ * AllocTracker::addOperation --
+ *   Add one completed operation to the table. The table update
+ *   itself allocates, so counting is suspended on this thread
+ *   meanwhile (an enclosing scope does not see it).
+ *
+ * Parameters:
+ *   name         - operation name (string literal)
+ *   delta        - allocations made during the operation
+ *   peakKbBefore - peak RSS when the operation started
+ *   peakKbAfter  - peak RSS when it finished
+ *
+ * Modifies:
+ *   - operations: entry for `name` updated
+ *
+ * Returns: nothing
+ ******************************************************************/
+void AllocTracker::addOperation(const char *name, const AllocCounts &delta,
+                                long peakKbBefore, long peakKbAfter)
+{
+    threadState.suspended = true;
+    {
+        QMutexLocker locker(&statsMutex);
+        OperationStats &stats = operations[QString::fromLatin1(name)];
+        ++stats.calls;
+        stats.allocations += delta.allocations;
+        stats.bytes += delta.bytes;
+        stats.frees += delta.frees;
+        stats.maxAllocations = qMax(stats.maxAllocations, delta.allocations);
+        stats.peakRssKb = qMax(stats.peakRssKb, peakKbAfter);
+        stats.rssGrowthKb += qMax(0L, peakKbAfter - peakKbBefore);
+    }
+    threadState.suspended = false;
+}
+
+/******************************************************************
+ * AllocTracker::report --
+ *   Format the per-operation table. Averages are per call.
+ *
+ * Parameters: none
+ *
+ * Returns:
+ *   fixed-width text table, or a hint if tracking is off
+ ******************************************************************/
+QString AllocTracker::report()
+{
+    if (!isEnabled()) {
+#if defined(CAFETERIA_ALLOC_HOOKS)
+        return "Allocation tracking is off.\n"
+               "Start the program with CAFETERIA_ALLOC_TRACK=1 to enable it.\n";
+#else
+        return "Allocation tracking is not built in.\n"
+               "Configure with -DCAFETERIA_ALLOC_HOOKS=ON and start the program\n"
+               "with CAFETERIA_ALLOC_TRACK=1 to enable it.\n";
+#endif
+    }
+
+    QMutexLocker locker(&statsMutex);
+
+    QString text = QString("%1%2%3%4%5%6%7%8\n")
+                       .arg("operation", -28)
+                       .arg("calls", 8)
+                       .arg("allocs/call", 12)
+                       .arg("KiB/call", 10)
+                       .arg("frees/call", 11)
+                       .arg("max allocs", 11)
+                       .arg("peak MiB", 10)
+                       .arg("+RSS KiB", 10);
+
+    for (auto it = operations.constBegin(); it != operations.constEnd(); ++it) {
+        const OperationStats &stats = it.value();
+        double calls = double(stats.calls);
+        text += QString("%1%2%3%4%5%6%7%8\n")
+                    .arg(it.key().left(27), -28)
+                    .arg(stats.calls, 8)
+                    .arg(stats.allocations / calls, 12, 'f', 1)
+                    .arg(stats.bytes / calls / 1024.0, 10, 'f', 2)
+                    .arg(stats.frees / calls, 11, 'f', 1)
+                    .arg(stats.maxAllocations, 11)
+                    .arg(stats.peakRssKb / 1024.0, 10, 'f', 1)
+                    .arg(stats.rssGrowthKb, 10);
+    }
+
+    if (operations.isEmpty()) {
+        text += "(no instrumented operations yet)\n";
+    }
+    return text;
+}
+
+/******************************************************************
+ * AllocTracker::reset --
+ *   Forget all recorded operations (e.g. after warm-up).
+ ******************************************************************/
+void AllocTracker::reset()
+{
+    threadState.suspended = true;
+    {
+        QMutexLocker locker(&statsMutex);
+        operations.clear();
+    }
+    threadState.suspended = false;
+}
@@ -0,0 +1,143 @@
+/******************************************************************
+ * alloctracker.h
+ *
+ * This header declares an opt-in heap allocation tracker. When the
+ * CAFETERIA_ALLOC_TRACK environment variable is set (to anything
+ * but "0"), every heap allocation made by the process (including
+ * Qt's QString/QVector storage) is counted per thread, and each
+ * ALLOC_SCOPE() records how many allocations and bytes the
+ * operation made and the process peak RSS after it. The manager
+ * screen and the --replay benchmark print the per-operation table.
+ *
+ * The allocation hooks replace the process allocator, so they are
+ * built only with the CAFETERIA_ALLOC_HOOKS CMake option (off by
+ * default); normal builds cannot count and leave malloc alone. In
+ * a build with the hooks, when the variable is not set, an
+ * allocation costs one relaxed atomic load on top of malloc.
+ *
+ ******************************************************************/
+
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include "tracer.h"
+
+/******************************************************************
+ * AllocCounts
+ *
+ * Allocation counters of one thread (or a difference of two
+ * readings).
+ *
+ * Members:
+ *   allocations - number of malloc/new calls
+ *   bytes       - bytes requested by those calls
+ *   frees       - number of free/delete calls
+ ******************************************************************/
+struct AllocCounts {
+    quint64 allocations = 0;
+    quint64 bytes = 0;
+    quint64 frees = 0;
+
+    AllocCounts operator-(const AllocCounts &start) const
+    {
+        AllocCounts delta;
+        delta.allocations = allocations - start.allocations;
+        delta.bytes = bytes - start.bytes;
+        delta.frees = frees - start.frees;
+        return delta;
+    }
+};
+
+/******************************************************************
+ * AllocTracker
+ *
+ * Process-wide collector. All functions are static.
+ ******************************************************************/
+class AllocTracker
+{
+public:
+    /**************************************************************
+     * initFromEnvironment --
+     *   Enables counting if CAFETERIA_ALLOC_TRACK is set. Call once
+     *   from main() before the operations of interest.
+     *
+     * isEnabled --
+     *   True if allocations are being counted.
+     *
+     * threadCounts --
+     *   Running totals for the calling thread.
+     *
+     * peakRssKb --
+     *   Peak resident set size of the process in KiB (0 where the
+     *   platform does not report it).
+     *
+     * addOperation --
+     *   Adds one completed operation to the per-operation table.
+     *
+     * report --
+     *   The per-operation table as text (fixed-width columns).
+     *
+     * reset --
+     *   Clears the per-operation table.
+     **************************************************************/
+    static void initFromEnvironment();
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static AllocCounts threadCounts();
+    static long peakRssKb();
+    static void addOperation(const char *name, const AllocCounts &delta,
+                             long peakKbBefore, long peakKbAfter);
+    static QString report();
+    static void reset();
+
+    // Used by the allocation hooks in alloctracker.cpp
+    static std::atomic<bool> enabled;
+};
+
+/******************************************************************
+ * AllocScope
+ *
+ * RAII helper: counts the allocations made on this thread between
+ * construction and destruction. Use through ALLOC_SCOPE().
+ *
+ * The name must be a string literal (it is stored as a pointer).
+ ******************************************************************/
+class AllocScope
+{
+public:
+    explicit AllocScope(const char *scopeName)
+        : name(AllocTracker::isEnabled() ? scopeName : nullptr)
+    {
+        if (name) {
+            peakKb = AllocTracker::peakRssKb();
+            start = AllocTracker::threadCounts();
+        }
+    }
+
+    ~AllocScope()
+    {
+        if (name) {
+            AllocCounts delta = AllocTracker::threadCounts() - start;
+            AllocTracker::addOperation(name, delta, peakKb, AllocTracker::peakRssKb());
+        }
+    }
+
+    AllocScope(const AllocScope &) = delete;
+    AllocScope &operator=(const AllocScope &) = delete;
+
+private:
+    const char *name;   // nullptr when tracking is disabled
+    AllocCounts start;
+    long peakKb = 0;
+};
+
+/******************************************************************
+ * ALLOC_SCOPE(name) --
+ *   Counts the allocations of the rest of the enclosing block under
+ *   the operation `name`.
+ ******************************************************************/
+#define ALLOC_SCOPE(name) AllocScope TRACE_CONCAT(allocScope_, __LINE__)(name)
+
+#endif // ALLOCTRACKER_H
@@ -0,0 +1,150 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * assetregistry.cpp
+ *
+ * This file implements AssetRegistry: one lookup per image path,
+ * a negative cache for missing pictures and the shared placeholder.
+ *
+ ******************************************************************/
+
+#include "assetregistry.h"
+#include "metrics.h"
+#include "tracer.h"
+#include <QColor>
+#include <QImageReader>
+#include <QPainter>
+#include <QPen>
+#include <QPixmap>
+#include <algorithm>
+
+/******************************************************************
+ * AssetRegistry::sync --
+ *   Resolve every image path of a new menu version. Paths already
+ *   in the cache (found or not) are not looked up again, so a hot
+ *   reload only pays for pictures it introduces.
+ *
+ * Parameters:
+ *   menu - current menu snapshot
+ *
+ * Modifies:
+ *   - assets: new paths added
+ *   - syncedVersion
+ *
+ * Returns: nothing
+ ******************************************************************/
+void AssetRegistry::sync(const MenuSnapshotPtr &menu)
+{
+    if (synced && menu->version == syncedVersion) {
+        return;
+    }
+    TRACE_SCOPE("AssetRegistry::sync");
+
+    for (const FoodItem &item : menu->items) {
+        if (!item.imagePath.isEmpty()) {
+            resolve(item.imagePath);
+        }
+    }
+
+    syncedVersion = menu->version;
+    synced = true;
+}
+
+/******************************************************************
+ * AssetRegistry::icon --
+ *   Cached icon for an image path, or the placeholder.
+ *
+ * Parameters:
+ *   path - item image path (may be empty)
+ *
+ * Returns:
+ *   icon to show; never null
+ ******************************************************************/
+QIcon AssetRegistry::icon(const QString &path)
+{
+    if (path.isEmpty()) {
+        return placeholder();
+    }
+    const Asset &asset = resolve(path);
+    return asset.found ? asset.icon : placeholder();
+}
+
+/******************************************************************
+ * AssetRegistry::missing --
+ *   Paths that failed to load, for the manager's diagnostics.
+ ******************************************************************/
+QStringList AssetRegistry::missing() const
+{
+    QStringList paths;
+    for (auto it = assets.constBegin(); it != assets.constEnd(); ++it) {
+        if (!it.value().found) {
+            paths.append(it.key());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+/******************************************************************
+ * AssetRegistry::resolve --
+ *   Look a path up once. QImageReader::canRead() only opens the
+ *   file and checks the header; the picture itself is decoded by
+ *   QIcon the first time a row is painted.
+ *
+ * Parameters:
+ *   path - non-empty image path
+ *
+ * Modifies:
+ *   - assets: entry added on the first call for this path
+ *
+ * Returns:
+ *   the cache entry
+ ******************************************************************/
+const AssetRegistry::Asset &AssetRegistry::resolve(const QString &path)
+{
+    auto it = assets.find(path);
+    if (it != assets.end()) {
+        return it.value();
+    }
+
+    Asset asset;
+    QImageReader reader(path);
+    asset.found = reader.canRead();
+    if (asset.found) {
+        asset.icon = QIcon(path);
+    } else {
+        qWarning("Menu image %s could not be loaded: %s",
+                 qPrintable(path), qPrintable(reader.errorString()));
+        Metrics::missingImagesTotal().increment();
+    }
+    return assets.insert(path, asset).value();
+}
+
+/******************************************************************
+ * AssetRegistry::placeholder --
+ *   A plate outline on a dark rounded tile, in the window's colours.
+ *   Drawn once and shared by every row without a picture.
+ ******************************************************************/
+const QIcon &AssetRegistry::placeholder()
+{
+    if (placeholderIcon.isNull()) {
+        QPixmap pixmap(PLACEHOLDER_SIZE, PLACEHOLDER_SIZE);
+        pixmap.fill(Qt::transparent);
+
+        QPainter painter(&pixmap);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor("#3d3d3d"));
+        painter.drawRoundedRect(QRectF(2, 2, PLACEHOLDER_SIZE - 4, PLACEHOLDER_SIZE - 4), 8, 8);
+
+        painter.setBrush(Qt::NoBrush);
+        painter.setPen(QPen(QColor("#d4a574"), 3));
+        painter.drawEllipse(QRectF(12, 12, PLACEHOLDER_SIZE - 24, PLACEHOLDER_SIZE - 24));
+        painter.setPen(QPen(QColor("#d4a574"), 1.5));
+        painter.drawEllipse(QRectF(20, 20, PLACEHOLDER_SIZE - 40, PLACEHOLDER_SIZE - 40));
+        painter.end();
+
+        placeholderIcon = QIcon(pixmap);
+    }
+    return placeholderIcon;
+}
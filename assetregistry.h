@@ -0,0 +1,78 @@
+/******************************************************************
+ * assetregistry.h
+ *
+ * This header declares AssetRegistry, which resolves the image
+ * paths of the menu items once per menu version instead of on
+ * every list refresh.
+ *
+ * Each distinct path is checked once with QImageReader (header
+ * only, no decode). Paths that cannot be read are remembered as
+ * missing, so a bad path costs one failed lookup per run, not one
+ * per category switch. Missing and empty paths share one generated
+ * placeholder thumbnail, which keeps every list row the same shape.
+ *
+ ******************************************************************/
+
+#ifndef ASSETREGISTRY_H
+#define ASSETREGISTRY_H
+
+#include <QHash>
+#include <QIcon>
+#include <QString>
+#include <QStringList>
+#include "menustore.h"
+
+/******************************************************************
+ * AssetRegistry
+ *
+ * GUI-thread cache of item icons. QIcon is implicitly shared, so
+ * every list row showing the same picture shares one icon (and the
+ * pixmap it decodes on first paint).
+ ******************************************************************/
+class AssetRegistry
+{
+public:
+    static const int PLACEHOLDER_SIZE = 64;   // Pixels (scaled down by the view)
+
+    /**************************************************************
+     * sync --
+     *   Resolve the image paths of a menu version that were not
+     *   seen before (no-op for the same version). Paths found
+     *   missing are logged once.
+     *
+     * icon --
+     *   Icon for an item's image path: the cached picture, or the
+     *   placeholder if the path is empty or missing. A path that
+     *   was never synced is resolved now.
+     *
+     * missing --
+     *   Paths that could not be loaded, sorted (shown when the
+     *   manager view opens).
+     **************************************************************/
+    void sync(const MenuSnapshotPtr &menu);
+    QIcon icon(const QString &path);
+    QStringList missing() const;
+
+private:
+    /**************************************************************
+     * Asset
+     *
+     * Members:
+     *   found - true if the path could be read as an image
+     *   icon  - the picture (null when missing)
+     **************************************************************/
+    struct Asset {
+        bool found = false;
+        QIcon icon;
+    };
+
+    const Asset &resolve(const QString &path);
+    const QIcon &placeholder();
+
+    QHash<QString, Asset> assets;   // Path -> result, including misses
+    QIcon placeholderIcon;          // Built on first use
+    quint64 syncedVersion = 0;
+    bool synced = false;
+};
+
+#endif // ASSETREGISTRY_H
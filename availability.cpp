@@ -0,0 +1,266 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * availability.cpp
+ *
+ * This file implements the schedule parser and AvailabilityIndex.
+ *
+ ******************************************************************/
+
+#include "availability.h"
+#include "tracer.h"
+#include <QRegularExpression>
+#include <QStringList>
+#include <algorithm>
+
+namespace {
+
+const quint8 ALL_DAYS = 0x7f;
+const quint8 WEEKDAYS = 0x1f;   // Mon-Fri
+const quint8 WEEKENDS = 0x60;   // Sat-Sun
+
+/******************************************************************
+ * Preset
+ *
+ * Named window. days == 0 means "no days given"; startMinute < 0
+ * means "no time given".
+ ******************************************************************/
+struct Preset {
+    const char *name;
+    quint8 days;
+    int startMinute;
+    int endMinute;
+};
+
+const Preset PRESETS[] = {
+    { "breakfast", 0,        7 * 60,       10 * 60 + 30 },
+    { "lunch",     0,        10 * 60 + 30, 14 * 60 + 30 },
+    { "dinner",    0,        16 * 60 + 30, 20 * 60 },
+    { "weekdays",  WEEKDAYS, -1,           -1 },
+    { "weekends",  WEEKENDS, -1,           -1 },
+    { "daily",     ALL_DAYS, -1,           -1 },
+};
+
+/******************************************************************
+ * dayIndex --
+ *   0 for "mon" ... 6 for "sun", -1 otherwise.
+ ******************************************************************/
+int dayIndex(const QString &name)
+{
+    static const QStringList DAYS = { "mon", "tue", "wed", "thu", "fri", "sat", "sun" };
+    return DAYS.indexOf(name);
+}
+
+} // namespace
+
+/******************************************************************
+ * parseAvailability --
+ *   See availability.h.
+ ******************************************************************/
+bool parseAvailability(const QString &text, QVector<AvailabilityWindow> &windows, QString *error)
+{
+    static const QRegularExpression DAY_RANGE("^([a-z]{3})(?:-([a-z]{3}))?$");
+    static const QRegularExpression TIME_RANGE("^(\\d{1,2}):(\\d{2})-(\\d{1,2}):(\\d{2})$");
+
+    windows.clear();
+    auto fail = [error](const QString &message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    const QStringList parts = text.split(';');
+    for (const QString &part : parts) {
+        const QString window = part.simplified().toLower();
+        if (window.isEmpty()) {
+            continue;   // Trailing ';'
+        }
+        const QStringList tokens = window.split(' ');
+
+        quint8 days = 0;
+        int startMinute = -1;
+        int endMinute = -1;
+        for (const QString &token : tokens) {
+            const Preset *preset = nullptr;
+            for (const Preset &candidate : PRESETS) {
+                if (token == QLatin1String(candidate.name)) {
+                    preset = &candidate;
+                }
+            }
+
+            int tokenStart = -1;
+            int tokenEnd = -1;
+            QRegularExpressionMatch match;
+            if (preset) {
+                days |= preset->days;
+                tokenStart = preset->startMinute;
+                tokenEnd = preset->endMinute;
+            } else if ((match = DAY_RANGE.match(token)).hasMatch()) {
+                int first = dayIndex(match.captured(1));
+                int last = match.captured(2).isEmpty() ? first : dayIndex(match.captured(2));
+                if (first < 0 || last < 0) {
+                    return fail(QString("unknown day in '%1'").arg(token));
+                }
+                for (int day = first;; day = (day + 1) % 7) {   // "fri-mon" wraps
+                    days |= quint8(1 << day);
+                    if (day == last) {
+                        break;
+                    }
+                }
+            } else if ((match = TIME_RANGE.match(token)).hasMatch()) {
+                tokenStart = match.captured(1).toInt() * 60 + match.captured(2).toInt();
+                tokenEnd = match.captured(3).toInt() * 60 + match.captured(4).toInt();
+                if (match.captured(2).toInt() >= 60 || match.captured(4).toInt() >= 60
+                    || tokenEnd > AvailabilityIndex::MINUTES_PER_DAY || tokenStart >= tokenEnd) {
+                    return fail(QString("bad time range '%1'").arg(token));
+                }
+            } else {
+                return fail(QString("unknown word '%1'").arg(token));
+            }
+
+            if (tokenStart >= 0) {
+                if (startMinute >= 0) {
+                    return fail(QString("two times in '%1'").arg(window));
+                }
+                startMinute = tokenStart;
+                endMinute = tokenEnd;
+            }
+        }
+
+        AvailabilityWindow parsed;
+        parsed.days = days ? days : ALL_DAYS;
+        if (startMinute >= 0) {
+            parsed.startMinute = startMinute;
+            parsed.endMinute = endMinute;
+        }
+        windows.append(parsed);
+    }
+    return true;
+}
+
+/******************************************************************
+ * AvailabilityIndex::build --
+ *   Cut the week at every window edge, mark each item in the
+ *   segments its windows cover, then merge neighbouring segments
+ *   with the same rows so every remaining edge is a real change.
+ *
+ * Parameters:
+ *   items - snapshot items (row i = items[i])
+ *
+ * Modifies:
+ *   - segmentStarts, available
+ *
+ * Returns: nothing
+ ******************************************************************/
+void AvailabilityIndex::build(const QVector<FoodItem> &items)
+{
+    TRACE_SCOPE("AvailabilityIndex::build");
+
+    QVector<QVector<AvailabilityWindow>> schedules(items.size());
+    QVector<int> starts { 0 };
+    for (int row = 0; row < items.size(); ++row) {
+        const QString &text = items[row].availability;
+        if (text.isEmpty()) {
+            continue;
+        }
+        QString error;
+        if (!parseAvailability(text, schedules[row], &error)) {
+            qWarning("Availability of %s ignored (%s): %s",
+                     qPrintable(items[row].name), qPrintable(error), qPrintable(text));
+            schedules[row].clear();
+            continue;
+        }
+        for (const AvailabilityWindow &window : schedules[row]) {
+            for (int day = 0; day < 7; ++day) {
+                if (window.days & (1 << day)) {
+                    starts.append(day * MINUTES_PER_DAY + window.startMinute);
+                    starts.append((day * MINUTES_PER_DAY + window.endMinute) % MINUTES_PER_WEEK);
+                }
+            }
+        }
+    }
+    std::sort(starts.begin(), starts.end());
+    starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+
+    auto segmentOf = [&starts](int minute) {
+        return int(std::lower_bound(starts.begin(), starts.end(), minute) - starts.begin());
+    };
+
+    QVector<QBitArray> rows(starts.size(), QBitArray(items.size()));
+    for (int row = 0; row < items.size(); ++row) {
+        if (schedules[row].isEmpty()) {
+            for (QBitArray &segment : rows) {
+                segment.setBit(row);
+            }
+            continue;
+        }
+        for (const AvailabilityWindow &window : schedules[row]) {
+            for (int day = 0; day < 7; ++day) {
+                if (!(window.days & (1 << day))) {
+                    continue;
+                }
+                int first = segmentOf(day * MINUTES_PER_DAY + window.startMinute);
+                int end = segmentOf(day * MINUTES_PER_DAY + window.endMinute);
+                for (int segment = first; segment < end; ++segment) {
+                    rows[segment].setBit(row);
+                }
+            }
+        }
+    }
+
+    segmentStarts.clear();
+    available.clear();
+    for (int segment = 0; segment < starts.size(); ++segment) {
+        if (!available.isEmpty() && available.last() == rows[segment]) {
+            continue;
+        }
+        segmentStarts.append(starts[segment]);
+        available.append(rows[segment]);
+    }
+}
+
+/******************************************************************
+ * AvailabilityIndex::minuteOfWeek --
+ *   Monday 00:00 is 0, Sunday 23:59 is MINUTES_PER_WEEK - 1.
+ ******************************************************************/
+int AvailabilityIndex::minuteOfWeek(const QDateTime &time)
+{
+    QTime clock = time.time();
+    return (time.date().dayOfWeek() - 1) * MINUTES_PER_DAY + clock.hour() * 60 + clock.minute();
+}
+
+/******************************************************************
+ * AvailabilityIndex::segmentAt --
+ *   Binary search over the segment starts.
+ ******************************************************************/
+int AvailabilityIndex::segmentAt(int minute) const
+{
+    auto next = std::upper_bound(segmentStarts.begin(), segmentStarts.end(), minute);
+    return int(next - segmentStarts.begin()) - 1;
+}
+
+/******************************************************************
+ * AvailabilityIndex::minutesUntilChange --
+ *   Distance to the next segment start. The last segment of the
+ *   week runs into the first one; if both have the same rows the
+ *   change at Monday 00:00 is skipped.
+ *
+ * Parameters:
+ *   minute - current minute of the week
+ *
+ * Returns:
+ *   minutes until the rows on sale change, or -1 for never
+ ******************************************************************/
+int AvailabilityIndex::minutesUntilChange(int minute) const
+{
+    if (!hasSchedules()) {
+        return -1;
+    }
+    int segment = segmentAt(minute);
+    if (segment + 1 < segmentStarts.size()) {
+        return segmentStarts[segment + 1] - minute;
+    }
+    int wrap = (available.last() == available.first()) ? segmentStarts[1] : 0;
+    return MINUTES_PER_WEEK - minute + wrap;
+}
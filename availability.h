@@ -0,0 +1,110 @@
+/******************************************************************
+ * availability.h
+ *
+ * This header declares the time-of-day availability of menu items
+ * (breakfast-only items, weekend specials, station hours) and the
+ * AvailabilityIndex that answers "what is on sale right now".
+ *
+ * Each item may carry a schedule string, e.g.
+ *   breakfast                  - every day 07:00-10:30
+ *   weekdays lunch             - Mon-Fri 10:30-14:30
+ *   Mon-Fri 11:00-19:00        - grill station hours
+ *   weekends; Mon-Fri 16:00-20:00
+ * Windows are separated by ';'. A window is a list of day ranges,
+ * one time range and/or preset names; missing days mean every day,
+ * a missing time means all day. An empty schedule means always.
+ *
+ * The index cuts the week (Monday 00:00 to Sunday 24:00) into
+ * segments at every point where any item starts or stops, and
+ * stores the available rows of each segment. A lookup is one
+ * binary search over the segment starts; it is rebuilt only when a
+ * new menu version is published.
+ *
+ ******************************************************************/
+
+#ifndef AVAILABILITY_H
+#define AVAILABILITY_H
+
+#include <QBitArray>
+#include <QDateTime>
+#include <QString>
+#include <QVector>
+#include "menutypes.h"
+
+/******************************************************************
+ * AvailabilityWindow
+ *
+ * One recurring window.
+ *
+ * Members:
+ *   days        - bit 0 = Monday ... bit 6 = Sunday
+ *   startMinute - first minute of the day (0-1439)
+ *   endMinute   - minute the window closes (1-1440, > startMinute)
+ ******************************************************************/
+struct AvailabilityWindow {
+    quint8 days = 0x7f;
+    int startMinute = 0;
+    int endMinute = 24 * 60;
+};
+
+/******************************************************************
+ * parseAvailability --
+ *   Parse a schedule string (see above). Day and preset names are
+ *   case-insensitive.
+ *
+ * Parameters:
+ *   text    - schedule, empty for "always"
+ *   windows - receives the windows (cleared first; empty = always)
+ *   error   - receives a message on failure (may be nullptr)
+ *
+ * Returns:
+ *   true if the whole string was understood
+ ******************************************************************/
+bool parseAvailability(const QString &text, QVector<AvailabilityWindow> &windows, QString *error = nullptr);
+
+/******************************************************************
+ * AvailabilityIndex
+ *
+ * Weekly availability of every row of one menu snapshot. Items with
+ * no schedule (or an invalid one) are always available.
+ ******************************************************************/
+class AvailabilityIndex
+{
+public:
+    static const int MINUTES_PER_DAY = 24 * 60;
+    static const int MINUTES_PER_WEEK = 7 * MINUTES_PER_DAY;
+
+    /**************************************************************
+     * build --
+     *   Parse every item's schedule and precompute the segments.
+     *   Invalid schedules are reported with qWarning().
+     *
+     * minuteOfWeek --
+     *   Minutes since Monday 00:00 (local time) for a time.
+     *
+     * segmentAt --
+     *   Segment that contains a minute of the week.
+     *
+     * isAvailable --
+     *   Whether a snapshot row is on sale during a segment.
+     *
+     * minutesUntilChange --
+     *   Minutes from `minute` until the next segment starts, or -1
+     *   if availability never changes (no schedules at all).
+     *
+     * hasSchedules --
+     *   True if any item has a schedule.
+     **************************************************************/
+    void build(const QVector<FoodItem> &items);
+    static int minuteOfWeek(const QDateTime &time);
+    int segmentAt(int minute) const;
+    bool isAvailable(int row, int segment) const { return available[segment].testBit(row); }
+    int minutesUntilChange(int minute) const;
+    bool hasSchedules() const { return segmentStarts.size() > 1; }
+
+private:
+    QVector<int> segmentStarts { 0 };   // Sorted minutes of the week, [0] == 0
+    QVector<QBitArray> available;       // Segment -> rows on sale
+};
+
+#endif // AVAILABILITY_H
@@ -0,0 +1,151 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * catalogstore.cpp
+ *
+ * This file implements string interning and the struct-of-arrays
+ * catalog columns used by menu snapshots.
+ *
+ ******************************************************************/
+
+#include "catalogstore.h"
+#include <cmath>
+
+// ========== STRING POOL ==========
+
+/******************************************************************
+ * StringPool::intern --
+ *   Look the string up; add it if it has not been seen.
+ *
+ * Parameters:
+ *   text - string to intern
+ *
+ * Modifies:
+ *   - strings, ids: new entry for unseen strings
+ *
+ * Returns:
+ *   the string's ID
+ ******************************************************************/
+int StringPool::intern(const QString &text)
+{
+    auto found = ids.constFind(text);
+    if (found != ids.constEnd()) {
+        return found.value();
+    }
+
+    int id = strings.size();
+    strings.append(text);
+    ids.insert(text, id);
+    return id;
+}
+
+// ========== MONEY ==========
+
+/******************************************************************
+ * toCents / fromCents --
+ *   Dollars <-> integer cents. Rounds to the nearest cent so that
+ *   10.99 becomes 1099, not 1098.
+ ******************************************************************/
+qint32 toCents(double dollars)
+{
+    return qint32(std::llround(dollars * 100.0));
+}
+
+double fromCents(qint32 cents)
+{
+    return cents / 100.0;
+}
+
+// ========== CATALOG COLUMNS ==========
+
+/******************************************************************
+ * CatalogColumns::categoryId --
+ *   Category tables are tiny (a few dozen entries), so a linear
+ *   scan beats hashing here.
+ *
+ * Parameters:
+ *   name - category name
+ *
+ * Returns:
+ *   category ID, or -1 if no item is in that category
+ ******************************************************************/
+int CatalogColumns::categoryId(const QString &name) const
+{
+    return categoryNames.indexOf(name);
+}
+
+/******************************************************************
+ * CatalogColumns::rowsInCategory --
+ *   Scan the contiguous category column for matches.
+ *
+ * Parameters:
+ *   categoryId - ID from categoryId()
+ *
+ * Returns:
+ *   matching rows, in menu order
+ ******************************************************************/
+QVector<int> CatalogColumns::rowsInCategory(int categoryId) const
+{
+    QVector<int> rows;
+    if (categoryId < 0) {
+        return rows;
+    }
+
+    const quint16 wanted = quint16(categoryId);
+    const quint16 *column = categoryIds.constData();
+    const int count = categoryIds.size();
+    for (int row = 0; row < count; ++row) {
+        if (column[row] == wanted) {
+            rows.append(row);
+        }
+    }
+    return rows;
+}
+
+/******************************************************************
+ * buildCatalogColumns --
+ *   See catalogstore.h. Category IDs are local to the snapshot
+ *   (0..number of categories - 1) so they fit in 16 bits; the pool
+ *   only guarantees the strings are shared.
+ ******************************************************************/
+CatalogColumns buildCatalogColumns(QVector<FoodItem> &items,
+                                   StringPool &categoryPool,
+                                   StringPool &imagePool)
+{
+    CatalogColumns columns;
+    columns.itemIds.reserve(items.size());
+    columns.categoryIds.reserve(items.size());
+    columns.priceCents.reserve(items.size());
+    columns.rowByName.reserve(items.size());
+
+    QHash<int, int> localCategory;   // pool ID -> snapshot category ID
+
+    for (int row = 0; row < items.size(); ++row) {
+        FoodItem &item = items[row];
+
+        int poolId = categoryPool.intern(item.category);
+        item.category = categoryPool.string(poolId);
+        if (!item.imagePath.isEmpty()) {
+            item.imagePath = imagePool.shared(item.imagePath);
+        }
+
+        auto local = localCategory.constFind(poolId);
+        int categoryId;
+        if (local == localCategory.constEnd()) {
+            categoryId = columns.categoryNames.size();
+            columns.categoryNames.append(item.category);
+            localCategory.insert(poolId, categoryId);
+        } else {
+            categoryId = local.value();
+        }
+
+        columns.itemIds.append(item.id);
+        columns.categoryIds.append(quint16(categoryId));
+        columns.priceCents.append(toCents(item.price));
+        if (!columns.rowByName.contains(item.name)) {
+            columns.rowByName.insert(item.name, row);   // First wins
+        }
+    }
+
+    return columns;
+}
@@ -0,0 +1,115 @@
+/******************************************************************
+ * catalogstore.h
+ *
+ * This header declares the compact catalog layout used by menu
+ * snapshots:
+ *   - StringPool interns repeated strings (categories, image paths)
+ *     so every item shares one copy of "Main Dishes" instead of
+ *     carrying its own heap string.
+ *   - CatalogColumns keeps the hot fields (item ID, category ID,
+ *     price in cents) in parallel contiguous arrays, struct-of-arrays
+ *     style, so category filters and price scans walk a few small
+ *     arrays instead of whole FoodItem records.
+ *
+ ******************************************************************/
+
+#ifndef CATALOGSTORE_H
+#define CATALOGSTORE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "menutypes.h"
+
+/******************************************************************
+ * StringPool
+ *
+ * Maps each distinct string to a small integer ID and keeps one
+ * shared QString per ID. QString is implicitly shared, so copies
+ * handed out by string() cost a pointer, not a heap buffer.
+ ******************************************************************/
+class StringPool
+{
+public:
+    /**************************************************************
+     * intern --
+     *   ID of the string, adding it to the pool if it is new.
+     *
+     * string --
+     *   The pooled copy for an ID.
+     *
+     * shared --
+     *   Convenience: the pooled copy equal to `text`.
+     **************************************************************/
+    int intern(const QString &text);
+    const QString &string(int id) const { return strings[id]; }
+    QString shared(const QString &text) { return strings[intern(text)]; }
+    int size() const { return strings.size(); }
+
+private:
+    QVector<QString> strings;     // ID -> pooled string
+    QHash<QString, int> ids;      // pooled string -> ID
+};
+
+/******************************************************************
+ * CatalogColumns
+ *
+ * Struct-of-arrays view of one menu snapshot. Row i in every array
+ * describes snapshot item i.
+ *
+ * Members:
+ *   itemIds       - stable item ID per row
+ *   categoryIds   - index into categoryNames per row
+ *   priceCents    - price in cents per row
+ *   categoryNames - distinct categories, by category ID
+ *   rowByName     - item name -> row, for O(1) lookups
+ ******************************************************************/
+struct CatalogColumns {
+    QVector<qint32> itemIds;
+    QVector<quint16> categoryIds;
+    QVector<qint32> priceCents;
+    QVector<QString> categoryNames;
+    QHash<QString, int> rowByName;
+
+    /**************************************************************
+     * categoryId --
+     *   ID of a category name, or -1 if no item uses it.
+     *
+     * rowsInCategory --
+     *   Rows whose category ID matches, in menu order.
+     *
+     * rowOf --
+     *   Row of the named item, or -1.
+     **************************************************************/
+    int categoryId(const QString &name) const;
+    QVector<int> rowsInCategory(int categoryId) const;
+    int rowOf(const QString &name) const { return rowByName.value(name, -1); }
+};
+
+/******************************************************************
+ * toCents / fromCents --
+ *   Convert between dollar doubles (menu file, UI) and the integer
+ *   cents stored in CatalogColumns.
+ ******************************************************************/
+qint32 toCents(double dollars);
+double fromCents(qint32 cents);
+
+/******************************************************************
+ * buildCatalogColumns --
+ *   Intern the category and image strings of `items` in place
+ *   (so identical strings share storage) and build the columns.
+ *
+ * Parameters:
+ *   items          - snapshot items; category/imagePath replaced
+ *                    by their pooled copies
+ *   categoryPool   - pool for category names
+ *   imagePool      - pool for image paths
+ *
+ * Returns:
+ *   columns for the items
+ ******************************************************************/
+CatalogColumns buildCatalogColumns(QVector<FoodItem> &items,
+                                   StringPool &categoryPool,
+                                   StringPool &imagePool);
+
+#endif // CATALOGSTORE_H
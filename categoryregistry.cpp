@@ -0,0 +1,212 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * categoryregistry.cpp
+ *
+ * This file implements CategoryRegistry: per-category item counts
+ * and price ranges maintained incrementally.
+ *
+ ******************************************************************/
+
+#include "categoryregistry.h"
+#include "catalogstore.h"
+
+// ========== CATEGORY STATS ==========
+
+/******************************************************************
+ * CategoryStats::minPrice / maxPrice --
+ *   Cheapest and most expensive price in the category (0 if the
+ *   category is empty).
+ ******************************************************************/
+double CategoryStats::minPrice() const
+{
+    return priceCounts.isEmpty() ? 0.0 : fromCents(priceCounts.firstKey());
+}
+
+double CategoryStats::maxPrice() const
+{
+    return priceCounts.isEmpty() ? 0.0 : fromCents(priceCounts.lastKey());
+}
+
+// ========== UPDATES ==========
+
+/******************************************************************
+ * CategoryRegistry::rebuild --
+ *   Count every item from scratch.
+ *
+ * Parameters:
+ *   items - full menu
+ *
+ * Modifies:
+ *   - stats: replaced
+ *
+ * Returns: nothing
+ ******************************************************************/
+void CategoryRegistry::rebuild(const QVector<FoodItem> &items)
+{
+    stats.clear();
+    for (const FoodItem &item : items) {
+        addItem(item);
+    }
+}
+
+/******************************************************************
+ * CategoryRegistry::addItem --
+ *   Count one item in its category, creating the category if this
+ *   is its first item.
+ *
+ * Parameters:
+ *   item - item being added to the menu
+ *
+ * Modifies:
+ *   - stats: one category updated or appended
+ *
+ * Returns:
+ *   true if the category is new
+ ******************************************************************/
+bool CategoryRegistry::addItem(const FoodItem &item)
+{
+    int index = indexOf(item.category);
+    bool created = false;
+    if (index < 0) {
+        CategoryStats category;
+        category.name = item.category;
+        stats.append(category);
+        index = stats.size() - 1;
+        created = true;
+    }
+
+    CategoryStats &category = stats[index];
+    ++category.itemCount;
+    ++category.priceCounts[toCents(item.price)];
+    return created;
+}
+
+/******************************************************************
+ * CategoryRegistry::removeItem --
+ *   Uncount one item. Empty categories are dropped so they no
+ *   longer show in the combo box.
+ *
+ * Parameters:
+ *   item - item being removed from the menu
+ *
+ * Modifies:
+ *   - stats: one category updated or removed
+ *
+ * Returns:
+ *   true if the category became empty and was removed
+ ******************************************************************/
+bool CategoryRegistry::removeItem(const FoodItem &item)
+{
+    int index = indexOf(item.category);
+    if (index < 0) {
+        return false;
+    }
+
+    CategoryStats &category = stats[index];
+    --category.itemCount;
+
+    qint32 cents = toCents(item.price);
+    auto price = category.priceCounts.find(cents);
+    if (price != category.priceCounts.end() && --price.value() <= 0) {
+        category.priceCounts.erase(price);
+    }
+
+    if (category.itemCount <= 0) {
+        stats.removeAt(index);
+        return true;
+    }
+    return false;
+}
+
+/******************************************************************
+ * CategoryRegistry::changePrice --
+ *   Move one item from its old price bucket to the new one.
+ *
+ * Parameters:
+ *   category - item's category
+ *   oldPrice - price before the edit
+ *   newPrice - price after the edit
+ *
+ * Modifies:
+ *   - stats: price buckets of one category
+ *
+ * Returns: nothing
+ ******************************************************************/
+void CategoryRegistry::changePrice(const QString &category, double oldPrice, double newPrice)
+{
+    int index = indexOf(category);
+    if (index < 0) {
+        return;
+    }
+
+    QMap<qint32, int> &prices = stats[index].priceCounts;
+    auto price = prices.find(toCents(oldPrice));
+    if (price != prices.end() && --price.value() <= 0) {
+        prices.erase(price);
+    }
+    ++prices[toCents(newPrice)];
+}
+
+// ========== QUERIES ==========
+
+/******************************************************************
+ * CategoryRegistry::names --
+ *   Category names in menu order (for the combo box and dialogs).
+ ******************************************************************/
+QStringList CategoryRegistry::names() const
+{
+    QStringList result;
+    for (const CategoryStats &category : stats) {
+        result << category.name;
+    }
+    return result;
+}
+
+/******************************************************************
+ * CategoryRegistry::find --
+ *   Stats for one category, or nullptr if it has no items.
+ ******************************************************************/
+const CategoryStats *CategoryRegistry::find(const QString &name) const
+{
+    int index = indexOf(name);
+    return index < 0 ? nullptr : &stats[index];
+}
+
+/******************************************************************
+ * CategoryRegistry::summary --
+ *   Short description such as "6 items, $2.99 - $4.99".
+ *
+ * Parameters:
+ *   name - category name
+ *
+ * Returns:
+ *   summary text, or empty if the category does not exist
+ ******************************************************************/
+QString CategoryRegistry::summary(const QString &name) const
+{
+    const CategoryStats *category = find(name);
+    if (!category) {
+        return QString();
+    }
+    return QString("%1 item%2, $%3 - $%4")
+        .arg(category->itemCount)
+        .arg(category->itemCount == 1 ? "" : "s")
+        .arg(category->minPrice(), 0, 'f', 2)
+        .arg(category->maxPrice(), 0, 'f', 2);
+}
+
+/******************************************************************
+ * CategoryRegistry::indexOf --
+ *   Position of a category in stats, or -1. Linear: there are only
+ *   a few dozen categories.
+ ******************************************************************/
+int CategoryRegistry::indexOf(const QString &name) const
+{
+    for (int i = 0; i < stats.size(); ++i) {
+        if (stats[i].name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
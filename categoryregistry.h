@@ -0,0 +1,85 @@
+/******************************************************************
+ * categoryregistry.h
+ *
+ * This header declares CategoryRegistry, the list of menu
+ * categories derived from the loaded menu data (instead of four
+ * hard-coded names). For each category it keeps the item count and
+ * the price range, updated incrementally on every menu mutation so
+ * the category combo box and summaries never rescan the menu.
+ *
+ ******************************************************************/
+
+#ifndef CATEGORYREGISTRY_H
+#define CATEGORYREGISTRY_H
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "menutypes.h"
+
+/******************************************************************
+ * CategoryStats
+ *
+ * Summary of one category.
+ *
+ * Members:
+ *   name        - category name as it appears in the menu data
+ *   itemCount   - number of menu items in the category
+ *   priceCounts - price in cents -> number of items at that price
+ *                 (a small multiset, so the min/max survive removals
+ *                 without a rescan)
+ ******************************************************************/
+struct CategoryStats {
+    QString name;
+    int itemCount = 0;
+    QMap<qint32, int> priceCounts;
+
+    double minPrice() const;
+    double maxPrice() const;
+};
+
+/******************************************************************
+ * CategoryRegistry
+ *
+ * Categories in first-seen menu order. Copyable (implicitly shared
+ * containers), so each menu snapshot carries its own version.
+ ******************************************************************/
+class CategoryRegistry
+{
+public:
+    /**************************************************************
+     * Updates
+     *
+     * rebuild()     - recount from scratch (file loads).
+     * addItem()     - counts one new item. Returns true if its
+     *                 category is new.
+     * removeItem()  - uncounts one item. Returns true if its
+     *                 category is now empty and was dropped.
+     * changePrice() - moves one item between price buckets.
+     **************************************************************/
+    void rebuild(const QVector<FoodItem> &items);
+    bool addItem(const FoodItem &item);
+    bool removeItem(const FoodItem &item);
+    void changePrice(const QString &category, double oldPrice, double newPrice);
+
+    /**************************************************************
+     * Queries
+     *
+     * categories() - stats for every category, in menu order.
+     * names()      - category names, in menu order.
+     * find()       - stats for one category, or nullptr.
+     * summary()    - "12 items, $2.99 - $4.99" for display.
+     **************************************************************/
+    const QVector<CategoryStats> &categories() const { return stats; }
+    QStringList names() const;
+    const CategoryStats *find(const QString &name) const;
+    QString summary(const QString &name) const;
+
+private:
+    QVector<CategoryStats> stats;
+
+    int indexOf(const QString &name) const;
+};
+
+#endif // CATEGORYREGISTRY_H
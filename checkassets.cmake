@@ -0,0 +1,73 @@
+# checkassets.cmake
+#
+# Build-time check of the image resources. Run by the build before
+# Cafeteria_Menu is compiled:
+#
+#   cmake -DQRC=resources.qrc -DMENU=default_menu.csv -P checkassets.cmake
+#
+# Fails the build when
+#   - a file listed in the .qrc does not exist (rcc would stop with a
+#     less helpful message, or not at all when the .qrc is not part
+#     of the target), or
+#   - a default menu item names an image that is not in the .qrc (the
+#     program would look it up on every list refresh and show
+#     nothing).
+
+if(NOT QRC OR NOT MENU)
+    message(FATAL_ERROR "checkassets.cmake: QRC and MENU must be set")
+endif()
+
+get_filename_component(qrc_dir "${QRC}" DIRECTORY)
+file(STRINGS "${QRC}" qrc_lines ENCODING UTF-8)
+
+# Resource paths (":/prefix/file") of every file in the .qrc
+set(resources "")
+set(errors "")
+set(prefix "/")
+set(line_number 0)
+foreach(line IN LISTS qrc_lines)
+    math(EXPR line_number "${line_number} + 1")
+    if(line MATCHES "<qresource[^>]*prefix=\"([^\"]*)\"")
+        set(prefix "${CMAKE_MATCH_1}")
+        if(NOT prefix MATCHES "/$")
+            string(APPEND prefix "/")
+        endif()
+    elseif(line MATCHES "<qresource")
+        set(prefix "/")
+    endif()
+    if(line MATCHES "<file([^>]*)>([^<]+)</file>")
+        set(attributes "${CMAKE_MATCH_1}")
+        set(file "${CMAKE_MATCH_2}")
+        set(alias "${file}")
+        if(attributes MATCHES "alias=\"([^\"]+)\"")
+            set(alias "${CMAKE_MATCH_1}")
+        endif()
+        if(NOT EXISTS "${qrc_dir}/${file}")
+            list(APPEND errors "${QRC}:${line_number}: ${file} does not exist")
+        endif()
+        list(APPEND resources ":${prefix}${alias}")
+    endif()
+endforeach()
+
+# Image column of the default menu (same layout as defaultmenu.cmake)
+file(STRINGS "${MENU}" menu_lines ENCODING UTF-8)
+set(line_number 0)
+foreach(line IN LISTS menu_lines)
+    math(EXPR line_number "${line_number} + 1")
+    string(STRIP "${line}" line)
+    if(line STREQUAL "" OR line MATCHES "^#")
+        continue()
+    endif()
+    if(line MATCHES "^[^,]*,[^,]*,[^,]*,[^,]*,([^,]*)")
+        set(image "${CMAKE_MATCH_1}")
+        list(FIND resources ":/images/images/${image}" found)
+        if(NOT image STREQUAL "" AND found EQUAL -1)
+            list(APPEND errors "${MENU}:${line_number}: image ${image} is not in ${QRC}")
+        endif()
+    endif()
+endforeach()
+
+if(errors)
+    list(JOIN errors "\n" message)
+    message(FATAL_ERROR "Missing menu resources:\n${message}")
+endif()
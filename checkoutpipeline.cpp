@@ -0,0 +1,298 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * checkoutpipeline.cpp
+ *
+ * This file implements CheckoutPipeline. Stages 1-2 run inside
+ * submit(); stage 3 waits for the PaymentService's authorized()
+ * signal; stages 4-5 run on a one-thread pool and report back to
+ * the GUI thread with a queued call (same pattern as the menu file
+ * watcher).
+ *
+ ******************************************************************/
+
+#include "checkoutpipeline.h"
+#include "orderengine.h"
+#include "inventory.h"
+#include "metrics.h"
+#include "tracer.h"
+#include <QDir>
+#include <QFile>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QtGlobal>
+
+namespace {
+
+/******************************************************************
+ * csvField --
+ *   Quote a field for the order log if it contains a separator or
+ *   quote.
+ ******************************************************************/
+QString csvField(const QString &value)
+{
+    if (!value.contains(',') && !value.contains('"')) {
+        return value;
+    }
+    QString quoted = value;
+    quoted.replace("\"", "\"\"");
+    return "\"" + quoted + "\"";
+}
+
+/******************************************************************
+ * appendOrderLog --
+ *   Append one order to the CSV log:
+ *   time,order,total,coupon,auth,items ("2x Burger;1x Fries").
+ *   A header row is written when the file is new.
+ *
+ * Returns:
+ *   true on success
+ ******************************************************************/
+bool appendOrderLog(const QString &fileName, const PipelineOrder &order)
+{
+    QFile file(fileName);
+    bool isNew = !file.exists();
+    if (!file.open(QIODevice::Append | QIODevice::Text)) {
+        return false;
+    }
+
+    QStringList items;
+    for (const OrderItem &line : order.lines) {
+        items << QString("%1x %2").arg(line.quantity).arg(line.name);
+    }
+
+    QTextStream out(&file);
+    if (isNew) {
+        out << "time,order,total,coupon,auth,items\n";
+    }
+    out << order.placedAt.toString(Qt::ISODate) << ','
+        << order.id << ','
+        << QString::number(order.totals.total, 'f', 2) << ','
+        << csvField(order.totals.couponCode) << ','
+        << csvField(order.authCode) << ','
+        << csvField(items.join(';')) << '\n';
+    out.flush();
+    return file.error() == QFile::NoError;
+}
+
+/******************************************************************
+ * spoolReceipt --
+ *   Write the receipt to its own file in spoolDir, for the printer
+ *   daemon (or a later reprint) to pick up.
+ *
+ * Returns:
+ *   path of the receipt file, or empty on failure
+ ******************************************************************/
+QString spoolReceipt(const QString &spoolDir, const PipelineOrder &order)
+{
+    if (!QDir().mkpath(spoolDir)) {
+        return QString();
+    }
+
+    QString fileName = QString::fromLatin1("%1/receipt-%2-%3.txt")
+                           .arg(spoolDir)
+                           .arg(order.placedAt.toString("yyyyMMdd-hhmmss"))
+                           .arg(order.id, 4, 10, QChar('0'));
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return QString();
+    }
+    file.write(order.receiptText.toUtf8());
+    return file.commit() ? fileName : QString();
+}
+
+} // namespace
+
+/******************************************************************
+ * CheckoutPipeline::CheckoutPipeline --
+ *   Connect to the payment service. One writer thread keeps the
+ *   order log in checkout order.
+ ******************************************************************/
+CheckoutPipeline::CheckoutPipeline(PaymentService *payment,
+                                   const QString &orderLogFile,
+                                   const QString &spoolDir,
+                                   QObject *parent)
+    : QObject(parent), payment(payment), orderLogFile(orderLogFile), spoolDir(spoolDir)
+{
+    writer.setMaxThreadCount(1);
+    connect(payment, &PaymentService::authorized, this, &CheckoutPipeline::onAuthorized);
+}
+
+/******************************************************************
+ * CheckoutPipeline::~CheckoutPipeline --
+ *   Let queued log/spool writes finish so no paid order is lost.
+ *   Orders still waiting for authorization are dropped (they were
+ *   never charged); checkout already committed their stock, so it
+ *   goes back on sale, as for a declined payment.
+ ******************************************************************/
+CheckoutPipeline::~CheckoutPipeline()
+{
+    writer.waitForDone();
+
+    for (auto order = pending.constBegin(); order != pending.constEnd(); ++order) {
+        for (const OrderItem &line : order->lines) {
+            stock->refund(line.itemId, line.stockUnits);
+        }
+    }
+}
+
+/******************************************************************
+ * CheckoutPipeline::submit --
+ *   Stages 1-2 and the start of stage 3.
+ *
+ * Parameters:
+ *   engine     - engine whose cart is checked out
+ *   couponCode - coupon as entered, or empty for none
+ *
+ * Modifies:
+ *   - engine: cart cleared, checkout metrics updated
+ *   - pending: order added until authorization completes
+ *   - stock: the engine's inventory
+ *
+ * Returns:
+ *   the new order number
+ ******************************************************************/
+quint64 CheckoutPipeline::submit(OrderEngine &engine, const QString &couponCode)
+{
+    TRACE_SCOPE("CheckoutPipeline::submit");
+
+    PipelineOrder order;
+    order.id = nextOrderId++;
+    order.placedAt = QDateTime::currentDateTime();
+
+    // Stage 1: unknown codes are reported and then ignored
+    emit stageChanged(order.id, CouponValidation);
+    QString code = couponCode.trimmed();
+    if (!code.isEmpty() && !engine.isValidCoupon(code)) {
+        emit couponRejected(order.id, code);
+    }
+
+    // Stage 2: price, print and free the cart for the next customer
+    emit stageChanged(order.id, Pricing);
+    const std::pmr::vector<OrderItem> &cart = engine.cartItems();
+    order.lines.reserve(int(cart.size()));
+    for (const OrderItem &line : cart) {
+        order.lines.append(line);
+    }
+    order.totals = engine.checkout(couponCode, order.receiptText);
+    stock = engine.inventory();
+
+    // Stage 3: the service answers through onAuthorized()
+    pending.insert(order.id, order);
+    authTimers[order.id].start();
+    emit stageChanged(order.id, PaymentAuthorization);
+
+    PaymentRequest request;
+    request.orderId = order.id;
+    request.amount = qRound64(order.totals.total * 100.0) / 100.0;
+    payment->authorize(request);
+
+    return order.id;
+}
+
+/******************************************************************
+ * CheckoutPipeline::onAuthorized --
+ *   End of stage 3. Approved orders get the payment line on their
+ *   receipt and move on to logging; declined orders stop here.
+ *
+ * Parameters:
+ *   result - answer from the payment service
+ *
+ * Modifies:
+ *   - pending, authTimers: order removed
+ *   - payment metrics
+ *
+ * Returns: nothing
+ ******************************************************************/
+void CheckoutPipeline::onAuthorized(const PaymentResult &result)
+{
+    auto it = pending.find(result.orderId);
+    if (it == pending.end()) {
+        return;   // Not one of ours (shared service)
+    }
+    PipelineOrder order = it.value();
+    pending.erase(it);
+    Metrics::paymentLatency().record(authTimers.take(order.id).nsecsElapsed());
+
+    if (!result.approved) {
+        Metrics::paymentDeclinesTotal().increment();
+        emit stageChanged(order.id, Declined);
+        emit orderDeclined(order, result.message);
+        return;
+    }
+
+    order.authCode = result.authCode;
+    order.receiptText += QString::fromLatin1("Order #%1   Payment approved: %2\n")
+                             .arg(order.id)
+                             .arg(order.authCode);
+    order.receiptText += "========================================\n";
+
+    logAndSpool(order);
+}
+
+/******************************************************************
+ * CheckoutPipeline::logAndSpool --
+ *   Stages 4-5 on the writer thread, then report completion on
+ *   this object's thread. A failed write is reported with
+ *   qWarning() but does not undo a paid order.
+ *
+ * Parameters:
+ *   order - approved order
+ *
+ * Modifies:
+ *   - writing: +1 until the order completes
+ *
+ * Returns: nothing
+ ******************************************************************/
+void CheckoutPipeline::logAndSpool(const PipelineOrder &order)
+{
+    ++writing;
+    emit stageChanged(order.id, OrderLogging);
+
+    QString logFile = orderLogFile;
+    QString receiptDir = spoolDir;
+
+    writer.start([this, order, logFile, receiptDir]() mutable {
+        TRACE_SCOPE("CheckoutPipeline::logAndSpool");
+
+        if (!appendOrderLog(logFile, order)) {
+            qWarning("Could not log order %llu to %s", order.id, qPrintable(logFile));
+        }
+
+        quint64 id = order.id;
+        QMetaObject::invokeMethod(this, [this, id]() {
+            emit stageChanged(id, ReceiptSpooling);
+        }, Qt::QueuedConnection);
+
+        order.receiptFile = spoolReceipt(receiptDir, order);
+        if (order.receiptFile.isEmpty()) {
+            qWarning("Could not spool the receipt of order %llu to %s", order.id, qPrintable(receiptDir));
+        }
+
+        QMetaObject::invokeMethod(this, [this, order]() {
+            --writing;
+            Metrics::ordersTotal().increment();   // Paid orders only
+            emit stageChanged(order.id, Completed);
+            emit orderCompleted(order);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/******************************************************************
+ * CheckoutPipeline::stageName --
+ *   Text for status messages, e.g. "authorizing payment".
+ ******************************************************************/
+QString CheckoutPipeline::stageName(Stage stage)
+{
+    switch (stage) {
+    case CouponValidation:     return "checking coupon";
+    case Pricing:              return "pricing";
+    case PaymentAuthorization: return "authorizing payment";
+    case OrderLogging:         return "logging order";
+    case ReceiptSpooling:      return "spooling receipt";
+    case Completed:            return "completed";
+    case Declined:             return "declined";
+    }
+    return QString();
+}
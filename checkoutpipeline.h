@@ -0,0 +1,149 @@
+/******************************************************************
+ * checkoutpipeline.h
+ *
+ * This header declares CheckoutPipeline, which runs a checkout as a
+ * chain of asynchronous stages instead of one blocking call:
+ *
+ *   1. Coupon validation   (GUI thread, immediate)
+ *   2. Pricing             (GUI thread, immediate; the cart is
+ *                           cleared so the next customer can start)
+ *   3. Payment authorization (PaymentService, asynchronous)
+ *   4. Order logging       (worker thread, appends to the order log)
+ *   5. Receipt spooling    (worker thread, one file per receipt)
+ *
+ * Each stage hands its result to the next through the event loop,
+ * so the GUI keeps responding while the payment is authorized and
+ * the files are written, and several orders can be in flight.
+ *
+ ******************************************************************/
+
+#ifndef CHECKOUTPIPELINE_H
+#define CHECKOUTPIPELINE_H
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <memory>
+#include "menutypes.h"
+#include "payment.h"
+
+class Inventory;
+class OrderEngine;
+
+/******************************************************************
+ * PipelineOrder
+ *
+ * One order as it moves through the pipeline.
+ *
+ * Members:
+ *   id          - order number (per session, starting at 1)
+ *   placedAt    - when checkout was pressed
+ *   lines       - cart lines at pricing time
+ *   totals      - priced totals
+ *   receiptText - receipt (payment line added once authorized)
+ *   authCode    - payment authorization code
+ *   receiptFile - spooled receipt file (empty if spooling failed)
+ ******************************************************************/
+struct PipelineOrder {
+    quint64 id = 0;
+    QDateTime placedAt;
+    QVector<OrderItem> lines;
+    OrderTotals totals;
+    QString receiptText;
+    QString authCode;
+    QString receiptFile;
+};
+
+/******************************************************************
+ * CheckoutPipeline
+ *
+ * Signals are emitted on the thread that owns the pipeline (the GUI
+ * thread), so receivers may touch widgets directly.
+ ******************************************************************/
+class CheckoutPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Stage {
+        CouponValidation,
+        Pricing,
+        PaymentAuthorization,
+        OrderLogging,
+        ReceiptSpooling,
+        Completed,
+        Declined
+    };
+
+    /**************************************************************
+     * CheckoutPipeline(payment, orderLogFile, spoolDir, parent)
+     *   - payment: authorization service (not owned)
+     *   - orderLogFile: CSV log, one line per paid order
+     *   - spoolDir: directory for receipt files (created on demand)
+     **************************************************************/
+    CheckoutPipeline(PaymentService *payment,
+                     const QString &orderLogFile,
+                     const QString &spoolDir,
+                     QObject *parent = nullptr);
+    ~CheckoutPipeline();
+
+    /**************************************************************
+     * submit --
+     *   Run stages 1 and 2 on the engine's cart (which is cleared)
+     *   and start authorization. Returns the order number; the
+     *   remaining stages report through the signals below.
+     *
+     * inFlight --
+     *   Orders submitted but not yet completed or declined.
+     *
+     * stageName --
+     *   Human-readable stage name for status messages.
+     **************************************************************/
+    quint64 submit(OrderEngine &engine, const QString &couponCode);
+    int inFlight() const { return int(pending.size()) + writing; }
+    static QString stageName(Stage stage);
+
+signals:
+    /**************************************************************
+     * couponRejected --
+     *   The entered coupon code is unknown; the order continues
+     *   without a discount.
+     *
+     * stageChanged --
+     *   An order entered a new stage.
+     *
+     * orderCompleted --
+     *   Payment approved, order logged, receipt spooled.
+     *
+     * orderDeclined --
+     *   Payment was declined; nothing was logged. The order's
+     *   lines are included so the cart can be restored.
+     **************************************************************/
+    void couponRejected(quint64 orderId, const QString &code);
+    void stageChanged(quint64 orderId, CheckoutPipeline::Stage stage);
+    void orderCompleted(const PipelineOrder &order);
+    void orderDeclined(const PipelineOrder &order, const QString &reason);
+
+private slots:
+    void onAuthorized(const PaymentResult &result);
+
+private:
+    PaymentService *payment;
+    QString orderLogFile;
+    QString spoolDir;
+    quint64 nextOrderId = 1;
+    std::shared_ptr<Inventory> stock;             // Committed by checkout; refunded if never paid
+
+    QMap<quint64, PipelineOrder> pending;         // Awaiting authorization
+    QMap<quint64, QElapsedTimer> authTimers;      // Started per pending order
+    int writing = 0;                              // Orders in stages 4-5
+    QThreadPool writer;                           // One worker; orders written in order
+
+    void logAndSpool(const PipelineOrder &order);
+};
+
+#endif // CHECKOUTPIPELINE_H
@@ -0,0 +1,56 @@
+# defaultmenu.cmake
+#
+# Generates defaultmenu_data.h (the rows of DefaultMenu::ENTRIES,
+# see defaultmenu.h) from default_menu.csv. Run by the build:
+#
+#   cmake -DINPUT=default_menu.csv -DOUTPUT=defaultmenu_data.h -P defaultmenu.cmake
+#
+# Malformed rows stop the build with the file and line number. The
+# output is only rewritten when it changes, so editing a comment in
+# the CSV does not recompile the engine.
+
+if(NOT INPUT OR NOT OUTPUT)
+    message(FATAL_ERROR "defaultmenu.cmake: INPUT and OUTPUT must be set")
+endif()
+
+file(STRINGS "${INPUT}" lines ENCODING UTF-8)
+
+set(rows "")
+set(line_number 0)
+foreach(line IN LISTS lines)
+    math(EXPR line_number "${line_number} + 1")
+    string(STRIP "${line}" line)
+    if(line STREQUAL "" OR line MATCHES "^#")
+        continue()
+    endif()
+
+    # plu,name,price,category,image[,availability] (no quotes, commas or backslashes in fields)
+    if(NOT line MATCHES "^([1-9][0-9]*),([^,\"\\\\]+),([0-9]+(\\.[0-9]+)?),([^,\"\\\\]+),([^,\"\\\\]*)(,([^,\"\\\\]*))?$")
+        message(FATAL_ERROR "${INPUT}:${line_number}: expected plu,name,price,category,image[,availability] but got: ${line}")
+    endif()
+    set(plu "${CMAKE_MATCH_1}")
+    set(name "${CMAKE_MATCH_2}")
+    set(price "${CMAKE_MATCH_3}")
+    set(category "${CMAKE_MATCH_5}")
+    set(image "${CMAKE_MATCH_6}")
+    set(availability "${CMAKE_MATCH_8}")
+
+    set(image_path "")
+    if(NOT image STREQUAL "")
+        set(image_path ":/images/images/${image}")
+    endif()
+
+    string(APPEND rows "    {${plu}, u\"${name}\", ${price}, u\"${category}\", u\"${image_path}\", u\"${availability}\"},\n")
+endforeach()
+
+if(rows STREQUAL "")
+    message(FATAL_ERROR "${INPUT}: no menu rows")
+endif()
+
+set(content "// Generated by defaultmenu.cmake from default_menu.csv. Do not edit.\n")
+string(APPEND content "// {plu, name, price, category, imagePath, availability}\n")
+string(APPEND content "${rows}")
+
+file(WRITE "${OUTPUT}.tmp" "${content}")
+configure_file("${OUTPUT}.tmp" "${OUTPUT}" COPYONLY)
+file(REMOVE "${OUTPUT}.tmp")
@@ -0,0 +1,70 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * defaultmenu.cpp
+ *
+ * This file implements the runtime accessors of the compiled
+ * default menu (defaultmenu.h).
+ *
+ ******************************************************************/
+
+#include "defaultmenu.h"
+
+namespace DefaultMenu {
+
+/******************************************************************
+ * DefaultMenu::indexOf --
+ *   Look a name up in the compile-time name index.
+ *
+ * Parameters:
+ *   name - item name
+ *
+ * Returns:
+ *   index into ENTRIES, or -1 if it is not a default item
+ ******************************************************************/
+int indexOf(const QString &name)
+{
+    return find(reinterpret_cast<const char16_t *>(name.utf16()), int(name.size()));
+}
+
+/******************************************************************
+ * DefaultMenu::text --
+ *   Wrap a table string. The literal lives for the whole run, so
+ *   the QString can point at it; a later edit detaches as usual.
+ ******************************************************************/
+QString text(const char16_t *value)
+{
+    return QString::fromRawData(reinterpret_cast<const QChar *>(value), length(value));
+}
+
+/******************************************************************
+ * DefaultMenu::item --
+ *   FoodItem for one table entry (id is assigned by the store).
+ ******************************************************************/
+FoodItem item(const Entry &entry)
+{
+    FoodItem food;
+    food.name = text(entry.name);
+    food.price = entry.price;
+    food.category = text(entry.category);
+    food.imagePath = text(entry.imagePath);
+    food.availability = text(entry.availability);
+    return food;
+}
+
+/******************************************************************
+ * DefaultMenu::items --
+ *   Every default item in table order. One allocation for the
+ *   vector; the strings share the table.
+ ******************************************************************/
+QVector<FoodItem> items()
+{
+    QVector<FoodItem> menu;
+    menu.reserve(COUNT);
+    for (const Entry &entry : ENTRIES) {
+        menu.append(item(entry));
+    }
+    return menu;
+}
+
+} // namespace DefaultMenu
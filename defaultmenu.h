@@ -0,0 +1,185 @@
+/******************************************************************
+ * defaultmenu.h
+ *
+ * This header declares the built-in default menu as a constexpr
+ * table. The rows are generated at build time from
+ * default_menu.csv (see defaultmenu.cmake), so the program starts
+ * without a menu file with no parsing and no per-item string
+ * allocations: item names, categories and image paths point
+ * straight into the table (QString::fromRawData).
+ *
+ * A perfect hash over the item names is also computed by the
+ * compiler, so "is this a default item?" is one hash and one
+ * string compare.
+ *
+ ******************************************************************/
+
+#ifndef DEFAULTMENU_H
+#define DEFAULTMENU_H
+
+#include <QString>
+#include <QVector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "menutypes.h"
+
+namespace DefaultMenu {
+
+/******************************************************************
+ * Entry
+ *
+ * One default item. Strings are UTF-16 literals so they can back a
+ * QString without a copy.
+ ******************************************************************/
+struct Entry {
+    int plu;                        // Keypad code (see pluindex.h)
+    const char16_t *name;
+    double price;
+    const char16_t *category;
+    const char16_t *imagePath;      // Empty: no picture
+    const char16_t *availability;   // Empty: always (see availability.h)
+};
+
+constexpr Entry ENTRIES[] = {
+#include "defaultmenu_data.h"
+};
+
+constexpr int COUNT = int(sizeof(ENTRIES) / sizeof(ENTRIES[0]));
+
+// ========== COMPILE-TIME CHECKS AND NAME INDEX ==========
+
+constexpr int length(const char16_t *text)
+{
+    int size = 0;
+    while (text[size]) {
+        ++size;
+    }
+    return size;
+}
+
+constexpr bool equals(const char16_t *a, int aLength, const char16_t *b)
+{
+    for (int i = 0; i < aLength; ++i) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+    return b[aLength] == 0;
+}
+
+/******************************************************************
+ * nameHash --
+ *   FNV-1a over UTF-16 code units, with the seed as offset basis.
+ ******************************************************************/
+constexpr std::uint32_t nameHash(const char16_t *name, int nameLength, std::uint32_t seed)
+{
+    std::uint32_t hash = seed;
+    for (int i = 0; i < nameLength; ++i) {
+        hash ^= std::uint32_t(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+constexpr int NAME_BITS = 7;
+constexpr int NAME_SLOTS = 1 << NAME_BITS;
+static_assert(COUNT > 0 && COUNT < NAME_SLOTS / 2, "Default menu size does not fit the name index");
+
+constexpr int nameSlot(const char16_t *name, int nameLength, std::uint32_t seed)
+{
+    return int(nameHash(name, nameLength, seed) >> (32 - NAME_BITS));
+}
+
+/******************************************************************
+ * findSeed --
+ *   First seed for which every default name gets its own slot, or
+ *   0 (e.g. for duplicate names).
+ ******************************************************************/
+constexpr std::uint32_t findSeed()
+{
+    for (std::uint32_t seed = 2166136261u, tries = 0; tries < 10000; ++seed, ++tries) {
+        bool used[NAME_SLOTS] = {};
+        bool perfect = true;
+        for (int i = 0; i < COUNT && perfect; ++i) {
+            int slot = nameSlot(ENTRIES[i].name, length(ENTRIES[i].name), seed);
+            perfect = !used[slot];
+            used[slot] = true;
+        }
+        if (perfect) {
+            return seed;
+        }
+    }
+    return 0;
+}
+
+constexpr std::uint32_t SEED = findSeed();
+static_assert(SEED != 0, "default_menu.csv: item names must be unique");
+
+constexpr std::array<std::int8_t, NAME_SLOTS> buildNameSlots()
+{
+    std::array<std::int8_t, NAME_SLOTS> slots{};
+    for (int i = 0; i < NAME_SLOTS; ++i) {
+        slots[i] = -1;
+    }
+    for (int i = 0; i < COUNT; ++i) {
+        slots[nameSlot(ENTRIES[i].name, length(ENTRIES[i].name), SEED)] = std::int8_t(i);
+    }
+    return slots;
+}
+
+constexpr std::array<std::int8_t, NAME_SLOTS> NAME_INDEX = buildNameSlots();
+
+/******************************************************************
+ * find --
+ *   Index of the default item with this name, or -1.
+ ******************************************************************/
+constexpr int find(const char16_t *name, int nameLength)
+{
+    int index = NAME_INDEX[std::size_t(nameSlot(name, nameLength, SEED))];
+    return (index >= 0 && equals(name, nameLength, ENTRIES[index].name)) ? index : -1;
+}
+
+constexpr bool pluCodesValid()
+{
+    for (int i = 0; i < COUNT; ++i) {
+        if (ENTRIES[i].plu <= 0 || ENTRIES[i].plu >= 500) {
+            return false;   // 500 and up are for manager-added items
+        }
+        for (int j = i + 1; j < COUNT; ++j) {
+            if (ENTRIES[i].plu == ENTRIES[j].plu) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(pluCodesValid(), "default_menu.csv: PLU codes must be unique and below 500");
+static_assert(find(ENTRIES[0].name, length(ENTRIES[0].name)) == 0, "Default menu name index is broken");
+static_assert(find(ENTRIES[COUNT - 1].name, length(ENTRIES[COUNT - 1].name)) == COUNT - 1,
+              "Default menu name index is broken");
+
+// ========== RUNTIME ACCESS ==========
+
+/******************************************************************
+ * indexOf --
+ *   Index of the default item with this name, or -1.
+ *
+ * text --
+ *   QString over a table string (no allocation, no copy).
+ *
+ * item --
+ *   FoodItem for one entry.
+ *
+ * items --
+ *   The whole default menu, in table order.
+ ******************************************************************/
+int indexOf(const QString &name);
+QString text(const char16_t *value);
+FoodItem item(const Entry &entry);
+QVector<FoodItem> items();
+
+} // namespace DefaultMenu
+
+#endif // DEFAULTMENU_H
@@ -0,0 +1,254 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * inventory.cpp
+ *
+ * This file implements Inventory with lock-free atomics. Only the
+ * available counter decides whether a sale may happen; reserved and
+ * sold are bookkeeping for the manager view.
+ *
+ ******************************************************************/
+
+#include "inventory.h"
+#include "metrics.h"
+
+/******************************************************************
+ * Inventory::Inventory --
+ *   Start with no chunks: every item is untracked.
+ ******************************************************************/
+Inventory::Inventory(QObject *parent)
+    : QObject(parent)
+{
+    for (std::atomic<Chunk *> &chunk : chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+Inventory::~Inventory()
+{
+    for (std::atomic<Chunk *> &chunk : chunks) {
+        delete chunk.load(std::memory_order_relaxed);
+    }
+}
+
+/******************************************************************
+ * Inventory::find --
+ *   Counter of an item, or nullptr if its chunk was never created
+ *   (or the ID is out of range). Never allocates.
+ ******************************************************************/
+Inventory::Counter *Inventory::find(int itemId) const
+{
+    if (itemId <= 0 || (itemId >> CHUNK_BITS) >= MAX_CHUNKS) {
+        return nullptr;
+    }
+    Chunk *chunk = chunks[itemId >> CHUNK_BITS].load(std::memory_order_acquire);
+    return chunk ? &chunk->counters[itemId & (CHUNK_SIZE - 1)] : nullptr;
+}
+
+/******************************************************************
+ * Inventory::counter --
+ *   Counter of an item, creating its chunk on first use. If two
+ *   threads create the same chunk, one compare-and-swap wins and
+ *   the other copy is thrown away.
+ *
+ * Returns:
+ *   the counter, or nullptr if the ID is out of range
+ ******************************************************************/
+Inventory::Counter *Inventory::counter(int itemId)
+{
+    if (itemId <= 0 || (itemId >> CHUNK_BITS) >= MAX_CHUNKS) {
+        return nullptr;
+    }
+    std::atomic<Chunk *> &slot = chunks[itemId >> CHUNK_BITS];
+    Chunk *chunk = slot.load(std::memory_order_acquire);
+    if (!chunk) {
+        Chunk *fresh = new Chunk;
+        if (slot.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) {
+            chunk = fresh;
+        } else {
+            delete fresh;   // chunk now holds the winner
+        }
+    }
+    return &chunk->counters[itemId & (CHUNK_SIZE - 1)];
+}
+
+/******************************************************************
+ * Inventory::reserve --
+ *   Take units with a compare-and-swap loop on the available
+ *   counter, so concurrent carts can never take more than there is.
+ *   Untracked items (no chunk, or unlimited) return at once: no
+ *   allocation and no counter is written.
+ *
+ * Parameters:
+ *   itemId   - MenuStore item ID
+ *   quantity - units wanted (> 0)
+ *   tracked  - if not null, set to whether the units were counted
+ *
+ * Modifies:
+ *   - the item's counters; soldOutChanged() if it ran out
+ *
+ * Returns:
+ *   true if the units were reserved (or the item is not tracked)
+ ******************************************************************/
+bool Inventory::reserve(int itemId, int quantity, bool *tracked)
+{
+    if (tracked) {
+        *tracked = false;
+    }
+    Counter *item = find(itemId);
+    if (!item) {
+        return true;   // No item of this chunk was ever tracked
+    }
+
+    int current = item->available.load(std::memory_order_acquire);
+    do {
+        if (current == UNLIMITED) {
+            return true;
+        }
+        if (current < quantity) {
+            Metrics::soldOutRejectionsTotal().increment();
+            return false;
+        }
+    } while (!item->available.compare_exchange_weak(current, current - quantity,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_relaxed));
+    item->reserved.fetch_add(quantity, std::memory_order_relaxed);
+    if (tracked) {
+        *tracked = true;
+    }
+
+    if (current == quantity) {
+        emit soldOutChanged(itemId, true);
+    }
+    return true;
+}
+
+/******************************************************************
+ * Inventory::release --
+ *   Give reserved units back. An item that stopped being tracked
+ *   meanwhile stays unlimited.
+ ******************************************************************/
+void Inventory::release(int itemId, int quantity)
+{
+    Counter *item = find(itemId);
+    if (!item || quantity <= 0) {
+        return;
+    }
+    item->reserved.fetch_sub(quantity, std::memory_order_relaxed);
+
+    int current = item->available.load(std::memory_order_relaxed);
+    while (current != UNLIMITED
+           && !item->available.compare_exchange_weak(current, current + quantity,
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_relaxed)) {
+    }
+    if (current == 0) {
+        emit soldOutChanged(itemId, false);
+    }
+}
+
+/******************************************************************
+ * Inventory::commit --
+ *   Reserved units were paid for. Available does not change.
+ ******************************************************************/
+void Inventory::commit(int itemId, int quantity)
+{
+    Counter *item = find(itemId);
+    if (!item || quantity <= 0) {
+        return;
+    }
+    item->reserved.fetch_sub(quantity, std::memory_order_relaxed);
+    item->sold.fetch_add(quantity, std::memory_order_relaxed);
+}
+
+/******************************************************************
+ * Inventory::refund --
+ *   Committed units go back on sale.
+ ******************************************************************/
+void Inventory::refund(int itemId, int quantity)
+{
+    Counter *item = find(itemId);
+    if (!item || quantity <= 0) {
+        return;
+    }
+    item->sold.fetch_sub(quantity, std::memory_order_relaxed);
+
+    int current = item->available.load(std::memory_order_relaxed);
+    while (current != UNLIMITED
+           && !item->available.compare_exchange_weak(current, current + quantity,
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_relaxed)) {
+    }
+    if (current == 0) {
+        emit soldOutChanged(itemId, false);
+    }
+}
+
+/******************************************************************
+ * Inventory::setStock --
+ *   Set the units on hand. Units reserved by open carts are part
+ *   of that count, so available becomes units - reserved (at least
+ *   0). A cart that reserves during the edit may be counted against
+ *   the old value; stock edits are rare, sales are not, so sales
+ *   never wait for this.
+ *
+ * Parameters:
+ *   itemId - MenuStore item ID
+ *   units  - units on hand, or UNTRACKED
+ *
+ * Modifies:
+ *   - the item's available counter; soldOutChanged() on a
+ *     transition
+ *
+ * Returns: nothing
+ ******************************************************************/
+void Inventory::setStock(int itemId, int units)
+{
+    Counter *item = counter(itemId);
+    if (!item) {
+        return;
+    }
+
+    int target = UNLIMITED;
+    if (units != UNTRACKED) {
+        target = qMax(0, units - item->reserved.load(std::memory_order_relaxed));
+    }
+    int previous = item->available.exchange(target, std::memory_order_acq_rel);
+
+    bool wasSoldOut = (previous == 0);
+    bool soldOut = (target == 0);
+    if (wasSoldOut != soldOut) {
+        emit soldOutChanged(itemId, soldOut);
+    }
+}
+
+/******************************************************************
+ * Inventory::available --
+ *   Units that can still be reserved, or UNTRACKED.
+ ******************************************************************/
+int Inventory::available(int itemId) const
+{
+    const Counter *item = find(itemId);
+    if (!item) {
+        return UNTRACKED;
+    }
+    int units = item->available.load(std::memory_order_acquire);
+    return units == UNLIMITED ? UNTRACKED : units;
+}
+
+/******************************************************************
+ * Inventory::onHand --
+ *   Units in the kitchen: not yet reserved plus in open carts.
+ ******************************************************************/
+int Inventory::onHand(int itemId) const
+{
+    const Counter *item = find(itemId);
+    if (!item) {
+        return UNTRACKED;
+    }
+    int units = item->available.load(std::memory_order_acquire);
+    if (units == UNLIMITED) {
+        return UNTRACKED;
+    }
+    return units + item->reserved.load(std::memory_order_relaxed);
+}
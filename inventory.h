@@ -0,0 +1,119 @@
+/******************************************************************
+ * inventory.h
+ *
+ * This header declares Inventory, the per-item stock counters.
+ *
+ * A unit moves through three counters:
+ *   available --reserve()--> reserved --commit()--> sold
+ *             <--release()--          <--refund()--
+ * reserve() runs when an item is added to a cart, commit() at
+ * checkout and release() when a cart is cleared, so two terminals
+ * can never sell the same last Tiramisu. Items nobody tracks cost
+ * one lookup per reserve() and nothing else.
+ *
+ * Every item has its own cache-line-sized block of atomics, and the
+ * table from item ID to block is never locked, so terminals selling
+ * different items never touch the same memory, and terminals
+ * selling the same item only race on one compare-and-swap.
+ *
+ ******************************************************************/
+
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+#include <QObject>
+#include <atomic>
+#include <limits>
+
+/******************************************************************
+ * Inventory
+ *
+ * Stock for every item, by MenuStore item ID. Items are not tracked
+ * (unlimited) until the manager sets their stock. Thread-safe; may
+ * be shared by several OrderEngines through a std::shared_ptr.
+ ******************************************************************/
+class Inventory : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int UNTRACKED = -1;   // available() of an unlimited item
+
+    explicit Inventory(QObject *parent = nullptr);
+    ~Inventory() override;
+
+    /**************************************************************
+     * Order flow
+     *
+     * reserve() - takes units for a cart. Returns false (and takes
+     *             nothing) if fewer are available. For an item
+     *             that is not tracked nothing is counted and
+     *             *tracked is set to false; callers pass only the
+     *             tracked units to the functions below.
+     * release() - gives a cart's units back (cart cleared).
+     * commit()  - the cart's units were paid for.
+     * refund()  - committed units go back on sale (payment
+     *             declined after checkout).
+     **************************************************************/
+    bool reserve(int itemId, int quantity, bool *tracked = nullptr);
+    void release(int itemId, int quantity);
+    void commit(int itemId, int quantity);
+    void refund(int itemId, int quantity);
+
+    /**************************************************************
+     * Manager access
+     *
+     * setStock()  - units on hand, including units reserved by
+     *               open carts; UNTRACKED stops counting. Units
+     *               that went into carts while the item was not
+     *               tracked are not known and not subtracted.
+     * available() - units that can still be added to carts, or
+     *               UNTRACKED.
+     * onHand()    - available plus reserved, or UNTRACKED.
+     * isSoldOut() - tracked and nothing available.
+     **************************************************************/
+    void setStock(int itemId, int units);
+    int available(int itemId) const;
+    int onHand(int itemId) const;
+    bool isSoldOut(int itemId) const { return available(itemId) == 0; }
+
+signals:
+    /**************************************************************
+     * soldOutChanged --
+     *   An item sold out or came back. Only emitted on these
+     *   transitions, never per unit, so busy items do not flood the
+     *   event loop. May be emitted from any thread.
+     **************************************************************/
+    void soldOutChanged(int itemId, bool soldOut);
+
+private:
+    static const int UNLIMITED = std::numeric_limits<int>::max();
+    static const int CHUNK_BITS = 8;
+    static const int CHUNK_SIZE = 1 << CHUNK_BITS;   // Counters per chunk
+    static const int MAX_CHUNKS = 1024;              // Item IDs below 262144
+
+    /**************************************************************
+     * Counter
+     *
+     * One item. Aligned to a cache line so two hot items never
+     * share one (no false sharing between terminals).
+     **************************************************************/
+    struct alignas(64) Counter {
+        std::atomic<int> available { UNLIMITED };
+        std::atomic<int> reserved { 0 };
+        std::atomic<int> sold { 0 };
+    };
+
+    struct Chunk {
+        Counter counters[CHUNK_SIZE];
+    };
+
+    // Chunks are created on first use with a compare-and-swap and
+    // live as long as the inventory, so lookups never lock
+    std::atomic<Chunk *> chunks[MAX_CHUNKS];
+
+    Counter *find(int itemId) const;
+    Counter *counter(int itemId);
+};
+
+#endif // INVENTORY_H
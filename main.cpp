@@ -2,35 +2,143 @@
  * main.cpp
  *
  * This file contains the entry point for the Qt application.
- * It creates a QApplication object, constructs the MainWindow,
- * shows it on the screen, and then starts the event loop.
+ * It creates a QApplication object, loads the shared catalog,
+ * constructs one MainWindow per screen, shows them and then starts
+ * the event loop. CAFETERIA_SCREENS sets the number of customer
+ * windows for multi-screen kiosk towers (default 1); window i is
+ * placed on screen i when that many screens are attached.
+ * CAFETERIA_UI_RECORD records the interactions for the UI replay
+ * tool (see uirecorder.h).
+ *
+ * When started with "--replay <script>", it instead runs the
+ * ordering logic headless (QCoreApplication, no widgets) and
+ * replays the script for load testing (see orderreplay.h).
  *
  ******************************************************************/
 
 #include "mainwindow.h"
+#include "sharedcatalog.h"
+#include "orderreplay.h"
+#include "stallwatchdog.h"
+#include "uirecorder.h"
+#include "tracer.h"
+#include "metrics.h"
+#include "alloctracker.h"
 #include <QApplication>
+#include <QCoreApplication>
+#include <QScreen>
+#include <QTimer>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/******************************************************************
+ * isHeadless --
+ *   Checks the raw command line for "--replay" before any Qt
+ *   application object exists, so headless runs never create a
+ *   QApplication (and never need a display).
+ *
+ * Parameters:
+ *   argc - number of command-line arguments
+ *   argv - array of C-strings containing the arguments
+ *
+ * Returns:
+ *   true if "--replay" (or "--replay=...") was given
+ ******************************************************************/
+static bool isHeadless(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--replay") == 0 || std::strncmp(argv[i], "--replay=", 9) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/******************************************************************
+ * screenCount --
+ *   Number of customer windows from CAFETERIA_SCREENS (1 if unset
+ *   or invalid, at most MAX_SCREENS).
+ ******************************************************************/
+static int screenCount()
+{
+    const int MAX_SCREENS = 16;
+    bool ok = false;
+    int count = qEnvironmentVariableIntValue("CAFETERIA_SCREENS", &ok);
+    if (!ok || count < 1) {
+        return 1;
+    }
+    return qMin(count, MAX_SCREENS);
+}
 
 /******************************************************************
  * main --
  *   Program entry point. Initializes the Qt application,
- *   creates the main window, and starts the event loop.
+ *   creates the main windows, and starts the event loop.
  *
  * Parameters:
  *   argc - number of command-line arguments
  *   argv - array of C-strings containing the arguments
  *
  * Returns:
- *   int - exit code from QApplication::exec()
+ *   int - exit code from QApplication::exec(), or from the replay
+ *         run in headless mode
  ******************************************************************/
 int main(int argc, char *argv[])
 {
+    // Record trace spans if CAFETERIA_TRACE names an output file
+    Tracer::initFromEnvironment();
+
+    // Count heap allocations per operation if CAFETERIA_ALLOC_TRACK is set
+    AllocTracker::initFromEnvironment();
+
+    // Headless replay: ordering logic only, no widgets
+    if (isHeadless(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        MetricsFileWriter metricsWriter;
+        OrderReplay replay;
+        int result = replay.run(app.arguments());
+        metricsWriter.writeNow();
+        Tracer::flush();
+        return result;
+    }
+
     // Create the Qt application object (handles GUI + event loop)
     QApplication a(argc, argv);
 
-    // Create and show the main window for the cafeteria system
-    MainWindow w;
-    w.show();
+    // Dump metrics periodically if CAFETERIA_METRICS_FILE is set
+    MetricsFileWriter metricsWriter;
+
+    // Log GUI thread stalls (CAFETERIA_STALL_BUDGET_MS, default 100 ms);
+    // started below, once the event loop runs
+    StallWatchdog watchdog;
+
+    // Menu, stock, coupons and icons are loaded once for all screens
+    SharedCatalog catalog;
+    catalog.load();
+
+    // Record interactions if CAFETERIA_UI_RECORD names an output file
+    UiRecorder recorder;
+
+    // One customer window per screen, each with its own cart
+    std::vector<std::unique_ptr<MainWindow>> windows;
+    const QList<QScreen *> screens = QGuiApplication::screens();
+    for (int i = 0; i < screenCount(); ++i) {
+        windows.push_back(std::make_unique<MainWindow>(&catalog, i));
+        recorder.attach(windows.back().get(), i);
+        if (i > 0 && i < screens.size()) {
+            windows.back()->move(screens[i]->availableGeometry().topLeft());
+        }
+        windows.back()->show();
+    }
+    QTimer::singleShot(0, &watchdog, &StallWatchdog::start);
+
+    // Enter the Qt event loop; program ends when the last window closes
+    int result = a.exec();
+    windows.clear();   // Before the catalog they share
 
-    // Enter the Qt event loop; program ends when the window closes
-    return a.exec();
+    // Final metrics and trace files (do nothing when disabled)
+    metricsWriter.writeNow();
+    Tracer::flush();
+    return result;
 }
@@ -9,56 +9,55 @@
  *   - Coupon and tax calculation
  *   - Manager view: add/remove items, edit prices, save menu
  *   - Secret numeric code to access manager view
+ *   - Non-modal toasts for confirmations of finished actions, and
+ *     an optional fast lane mode without prompts
+ *   - PLU keypad fast entry ("2*101" Enter)
  *
  ******************************************************************/
 
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "tracer.h"
+#include "alloctracker.h"
+#include "metrics.h"
 #include <QMessageBox>
+#include <QScrollBar>
+#include <QHeaderView>
 #include <QInputDialog>
-#include <QFile>
-#include <QTextStream>
+#include <QFileDialog>
+#include <QAbstractSpinBox>
+#include <QElapsedTimer>
+#include <QDateTime>
 #include <QApplication>
-#include <QDateTime>   
-#include <cmath>       
+#include <QCloseEvent>
+#include <QWindow>
+#include <QSet>
+#include <algorithm>
 using namespace std;
 
-/******************************************************************
- * round2 --
- *   Helper function that rounds a double to 2 decimal places.
- *
- *   ADAPTED FROM Elliots's receipt.cpp.
- *   Original idea: format money values cleanly on a printed receipt.
- *   Same logic is used in our Qt-based receipt display.
- *
- * Parameters:
- *   num - double value to round
- *
- * Returns:
- *   double rounded to 2 decimal places
- ******************************************************************/
-static double round2(double num)
-{
-    return round(num * 100.0) / 100.0;
-}
-
 /******************************************************************
  * MainWindow::MainWindow --
- *   Constructor. Sets up the UI, applies the style sheet, loads
- *   menu/coupon data, and initializes the starting customer view.
+ *   Constructor. Sets up the UI, applies the style sheet, restores
+ *   this screen's cart and initializes the starting customer view.
+ *   The menu and coupons come from the (already loaded) catalog.
  *
  * Parameters:
- *   parent - pointer to parent widget (usually nullptr)
+ *   catalog - data shared by all screens of this process
+ *   screen  - index of this window's screen (0 = first)
+ *   parent  - pointer to parent widget (usually nullptr)
  *
  * Modifies:
  *   - UI widgets: icon sizes, style, combo box contents
- *   - Internal data structures: menuItems, coupons
+ *   - Internal data structures: engine (cart)
  *
  * Returns: nothing
  ******************************************************************/
-MainWindow::MainWindow(QWidget *parent)
+MainWindow::MainWindow(SharedCatalog *catalog, int screen, QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
+    , catalog(catalog)
+    , screen(screen)
+    , engine(catalog->menuStore(), catalog->inventory(), catalog->coupons())
 {
     // Create all widgets from the .ui file
     ui->setupUi(this);
@@ -67,11 +66,66 @@ MainWindow::MainWindow(QWidget *parent)
     ui->itemsListWidget->setIconSize(QSize(64, 64));   // Large icons for customer menu
     ui->itemsListWidget->setSpacing(4);                // Small gap between rows
 
-    // Slightly smaller icons for manager item list
-    ui->managerItemsListWidget->setIconSize(QSize(32, 32));
+    // Manager item table: a model over the menu snapshot. Rows have a
+    // fixed height so the view only lays out and formats what is
+    // visible, even for very large catalogs.
+    managerModel = new MenuTableModel(this);
+    ui->managerItemsTableView->setModel(managerModel);
+    ui->managerItemsTableView->setItemDelegateForColumn(MenuTableModel::PriceColumn, new PriceDelegate(this));
+    ui->managerItemsTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->managerItemsTableView->verticalHeader()->setDefaultSectionSize(32);
+    ui->managerItemsTableView->verticalHeader()->hide();
+    ui->managerItemsTableView->horizontalHeader()->setSectionResizeMode(MenuTableModel::NameColumn, QHeaderView::Stretch);
+    ui->managerItemsTableView->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);  // Menu order
+    ui->managerItemsTableView->setSortingEnabled(true);
+
+    // Apply inline price edits after the editor has closed
+    connect(managerModel, &MenuTableModel::priceEditRequested,
+            this, &MainWindow::onPriceEditRequested, Qt::QueuedConnection);
+
+    // Stock: edited in the table, sold-out changes shown everywhere
+    managerModel->setInventory(engine.inventory());
+    connect(managerModel, &MenuTableModel::stockEditRequested,
+            this, &MainWindow::onStockEditRequested, Qt::QueuedConnection);
+    connect(engine.inventory().get(), &Inventory::soldOutChanged,
+            this, &MainWindow::onSoldOutChanged, Qt::QueuedConnection);
+
+    // Short confirmations are shown as toasts, not message boxes
+    toasts = new ToastNotifier(this);
+
+    // Breakfast/lunch switchovers; armed by updateItemsList()
+    availabilityTimer = new QTimer(this);
+    availabilityTimer->setSingleShot(true);
+    availabilityTimer->setTimerType(Qt::PreciseTimer);
+    connect(availabilityTimer, &QTimer::timeout, this, &MainWindow::onAvailabilityTimeout);
+
+    // Upsell suggestions under the cart; refreshed after cart changes
+    ui->upsellLabel->hide();
+    ui->upsellListWidget->hide();
+    upsellTimer = new QTimer(this);
+    upsellTimer->setSingleShot(true);
+    upsellTimer->setInterval(0);
+    connect(upsellTimer, &QTimer::timeout, this, &MainWindow::onUpsellTimeout);
+
+    // Checkout runs as an asynchronous pipeline against the payment
+    // service (a local mock until a real terminal is plugged in)
+    paymentService = new MockPaymentService(this);
+    paymentService->configureFromEnvironment();
+    checkoutPipeline = new CheckoutPipeline(paymentService, screenFile(ORDER_LOG_FILE),
+                                            screenFile(RECEIPT_SPOOL_DIR), this);
+    connect(checkoutPipeline, &CheckoutPipeline::couponRejected, this, &MainWindow::onCouponRejected);
+    connect(checkoutPipeline, &CheckoutPipeline::stageChanged, this, &MainWindow::onCheckoutStageChanged);
+    connect(checkoutPipeline, &CheckoutPipeline::orderCompleted, this, &MainWindow::onOrderCompleted);
+    connect(checkoutPipeline, &CheckoutPipeline::orderDeclined, this, &MainWindow::onOrderDeclined);
+    checkoutStatusLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(checkoutStatusLabel);
+
+    // Fast lane mode can be preset for rush hour from the environment
+    QString fastLaneValue = qEnvironmentVariable("CAFETERIA_FAST_LANE");
+    ui->fastLaneCheckBox->setChecked(!fastLaneValue.isEmpty() && fastLaneValue != "0");
 
     // Set window title shown in the title bar
-    setWindowTitle("Cafeteria Ordering System");
+    setWindowTitle(screenTitle("Cafeteria Ordering System"));
 
     // Load window icon from the Qt resource file
     QIcon icon(":/images/images/logo.png");
@@ -124,6 +178,19 @@ MainWindow::MainWindow(QWidget *parent)
     QComboBox:hover {
         border: 2px solid #8b6f47;
     }
+
+    /* ===== QLineEdit (menu search) ===== */
+    QLineEdit {
+        background-color: #331e0e;
+        color: #d4a574;
+        border: 2px solid #4a3426;
+        border-radius: 5px;
+        padding: 5px;
+        min-height: 25px;
+    }
+    QLineEdit:focus {
+        border: 2px solid #8b6f47;
+    }
     QComboBox::drop-down {
         subcontrol-origin: padding;
         subcontrol-position: center right;
@@ -166,6 +233,24 @@ MainWindow::MainWindow(QWidget *parent)
         background-color: #3d2a1a;
     }
 
+    QTableView {
+        background-color: #331e0e;
+        alternate-background-color: #2d1f14;
+        color: #d4a574;
+        border: 2px solid #4a3426;
+        border-radius: 5px;
+        gridline-color: #3d2a1a;
+        selection-background-color: #4a3426;
+        selection-color: #f4d4a4;
+    }
+    QHeaderView::section {
+        background-color: #4a3426;
+        color: #f4d4a4;
+        padding: 6px;
+        border: none;
+        border-right: 1px solid #6b4d35;
+    }
+
     QTextEdit {
         background-color: #331e0e;
         color: #d4a574;
@@ -301,15 +386,16 @@ MainWindow::MainWindow(QWidget *parent)
     // Install event filter so we can detect secret numeric key sequence
     qApp->installEventFilter(this);
 
-    // Load menu items and coupons from text files (or create defaults)
-    loadMenuItems();
-    loadCoupons();
+    // Bring back this screen's cart after a crash
+    journal.open(screenFile(SESSION_FILE));
+    restoreSession();
+
+    // Fill the customer combo box with the categories in the menu data
+    updateCategoryList();
 
-    // Setup categories for the customer combo box
-    ui->categoryComboBox->addItem("Main Dishes");
-    ui->categoryComboBox->addItem("Side Items");
-    ui->categoryComboBox->addItem("Beverages");
-    ui->categoryComboBox->addItem("Desserts");
+    // Menu edits from any screen and files pushed while we are running
+    connect(catalog, &SharedCatalog::menuChanged, this, &MainWindow::onMenuChanged);
+    connect(catalog, &SharedCatalog::couponsChanged, this, &MainWindow::onCouponsChanged);
 
     // Initialize displays in customer view
     updateItemsList();
@@ -340,188 +426,111 @@ MainWindow::~MainWindow()
 // ========== FILE HANDLING ==========
 
 /******************************************************************
- * MainWindow::loadMenuItems --
- *   Load menu items from the menu file. If the file does not exist,
- *   create a default menu with hard-coded items, then save it.
+ * MainWindow::screenFile --
+ *   File name for this screen. The first screen keeps the plain
+ *   name, so a single-screen kiosk uses the same files as before.
  *
- *   ADAPTED FROM Sai's "Food Menu.cpp":
- *     - Original was a console menu with these same items and prices.
- *     - Here, we store them in a QVector<FoodItem> with category and
- *       imagePath so they can be used in the Qt GUI.
- *
- * Parameters: none
- * Modifies:
- *   - menuItems: cleared and then filled with items
- *   - MENU_FILE: created/overwritten when default items are written
+ * Parameters:
+ *   name - first screen's file or directory name
  *
- * Returns: nothing
+ * Returns:
+ *   e.g. "orders_2.csv" or "receipts_2" for the second screen
  ******************************************************************/
-void MainWindow::loadMenuItems()
+QString MainWindow::screenFile(const QString &name) const
 {
-    menuItems.clear();
-    QFile file(MENU_FILE);
-
-    // If file doesn't exist, create default menu items in memory
-    if (!file.exists()) {
-        FoodItem item;
-
-        // Main Dishes
-        item.name = "Cheese Burger"; item.price = 10.99; item.category = "Main Dishes"; item.imagePath = ":/images/images/Cheeseburger.png";
-        menuItems.append(item);
-        item.name = "Club Sandwich"; item.price = 10.99; item.category = "Main Dishes"; item.imagePath = ":/images/images/clubsandwitch.png";
-        menuItems.append(item);
-        item.name = "Macaroni and Cheese"; item.price = 8.99; item.category = "Main Dishes"; item.imagePath = ":/images/images/MacaroniandCheese.png";
-        menuItems.append(item);
-        item.name = "Chicken Strips"; item.price = 10.99; item.category = "Main Dishes"; item.imagePath = ":/images/images/ChickenStrips.png";
-        menuItems.append(item);
-        item.name = "Caesar Salad"; item.price = 8.99; item.category = "Main Dishes"; item.imagePath = ":/images/images/CaesarSalad.png";
-        menuItems.append(item);
-        item.name = "Spaghetti Bolognese"; item.price = 14.99; item.category = "Main Dishes"; item.imagePath = ":/images/images/SpaghettiBolognese.png";
-        menuItems.append(item);
-        item.name = "Chicken Wrap"; item.price = 10.99; item.category = "Main Dishes"; item.imagePath = ":/images/images/ChickenWrap.png";
-        menuItems.append(item);
-        item.name = "Breakfast Sandwich"; item.price = 10.99; item.category = "Main Dishes"; item.imagePath = ":/images/images/BreakfastSandwich.png";
-        menuItems.append(item);
-
-        // Side Items
-        item.name = "Fries"; item.price = 3.99; item.category = "Side Items"; item.imagePath = ":/images/images/Fries.png";
-        menuItems.append(item);
-        item.name = "Mashed Potatoes"; item.price = 3.99; item.category = "Side Items"; item.imagePath = ":/images/images/MashedPotatoes.png";
-        menuItems.append(item);
-        item.name = "Roasted Vegetables"; item.price = 3.99; item.category = "Side Items"; item.imagePath = ":/images/images/RoastedVegetables.png";
-        menuItems.append(item);
-        item.name = "Hashbrowns"; item.price = 3.99; item.category = "Side Items"; item.imagePath = ":/images/images/Hashbrowns.png";
-        menuItems.append(item);
-        item.name = "Tater Tots"; item.price = 3.99; item.category = "Side Items"; item.imagePath = ":/images/images/TaterTots.png";
-        menuItems.append(item);
-        item.name = "Onion Rings"; item.price = 3.99; item.category = "Side Items"; item.imagePath = ":/images/images/OnionRings.png";
-        menuItems.append(item);
-
-        // Beverages
-        item.name = "Soda"; item.price = 2.99; item.category = "Beverages"; item.imagePath = ":/images/images/Soda.png";
-        menuItems.append(item);
-        item.name = "Iced Tea"; item.price = 2.99; item.category = "Beverages"; item.imagePath = ":/images/images/IcedTea.png";
-        menuItems.append(item);
-        item.name = "Tea"; item.price = 2.99; item.category = "Beverages"; item.imagePath = ":/images/images/Tea.png";
-        menuItems.append(item);
-        item.name = "Coffee"; item.price = 4.99; item.category = "Beverages"; item.imagePath = ":/images/images/Coffee.png";
-        menuItems.append(item);
-        item.name = "Iced Coffee"; item.price = 4.99; item.category = "Beverages"; item.imagePath = ":/images/images/IcedCoffee.png";
-        menuItems.append(item);
-        item.name = "Milkshake"; item.price = 4.99; item.category = "Beverages"; item.imagePath = ":/images/images/Milkshake.png";
-        menuItems.append(item);
-
-        // Desserts
-        item.name = "Chocolate Chip Cookie"; item.price = 4.99; item.category = "Desserts"; item.imagePath = ":/images/images/ChocolateChipCookie.png";
-        menuItems.append(item);
-        item.name = "Cheese Cake"; item.price = 7.99; item.category = "Desserts"; item.imagePath = ":/images/images/CheeseCake.png";
-        menuItems.append(item);
-        item.name = "Carrot Cake"; item.price = 7.99; item.category = "Desserts"; item.imagePath = ":/images/images/CarrotCake.png";
-        menuItems.append(item);
-        item.name = "Brownies"; item.price = 4.99; item.category = "Desserts"; item.imagePath = ":/images/images/Brownies.png";
-        menuItems.append(item);
-        item.name = "Apple Pie"; item.price = 7.99; item.category = "Desserts"; item.imagePath = ":/images/images/ApplePie.png";
-        menuItems.append(item);
-        item.name = "Banana Split"; item.price = 7.99; item.category = "Desserts"; item.imagePath = ":/images/images/BananaSplit.png";
-        menuItems.append(item);
-        item.name = "Tiramisu"; item.price = 7.99; item.category = "Desserts"; item.imagePath = ":/images/images/Tiramisu.png";
-        menuItems.append(item);
-
-        // Write default items to the menu file for next run
-        saveMenuItems();
-        return;
+    if (screen == 0) {
+        return name;
     }
+    int dot = name.lastIndexOf('.');
+    QString suffix = QString("_%1").arg(screen + 1);
+    return dot < 0 ? name + suffix : name.left(dot) + suffix + name.mid(dot);
+}
 
-    // If the file exists, load items line by line
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        while (!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList parts = line.split(',');
-            if (parts.size() >= 3) {
-                FoodItem item;
-                item.name = parts[0];
-                item.price = parts[1].toDouble();
-                item.category = parts[2];
-                item.imagePath = (parts.size() == 4) ? parts[3] : "";
-                menuItems.append(item);
-            }
-        }
-        file.close();
+/******************************************************************
+ * MainWindow::screenTitle --
+ *   Window title for this screen, so the manager can tell the
+ *   windows of a kiosk tower apart.
+ *
+ * Parameters:
+ *   title - title of the first screen
+ *
+ * Returns:
+ *   e.g. "Cafeteria Ordering System (Screen 2)"
+ ******************************************************************/
+QString MainWindow::screenTitle(const QString &title) const
+{
+    if (screen == 0) {
+        return title;
     }
+    return QString("%1 (Screen %2)").arg(title).arg(screen + 1);
 }
 
 /******************************************************************
- * MainWindow::loadCoupons --
- *   Load coupon codes and discount percentages from file. If the
- *   file doesn't exist, default coupons are created and saved.
+ * MainWindow::saveMenuItems --
+ *   Save all current menu items to the menu file, one per line.
+ *   The menu is shared, so this saves the edits of every screen.
  *
  * Parameters: none
  * Modifies:
- *   - coupons: cleared and then filled with entries
- *   - COUPON_FILE: created/overwritten when default coupons written
+ *   - menu file: overwritten with current menu contents
  *
  * Returns: nothing
  ******************************************************************/
-void MainWindow::loadCoupons()
+void MainWindow::saveMenuItems()
 {
-    coupons.clear();
-    QFile file(COUPON_FILE);
-
-    // If file doesn't exist, create default coupon set
-    if (!file.exists()) {
-        coupons["10OFF"]   = 0.10;  // 10% off
-        coupons["20OFF"]   = 0.20;  // 20% off
-        coupons["SAVE15"]  = 0.15;  // 15% off
-        coupons["STUDENT"] = 0.25;  // 25% off
-
-        // Save default coupons to file
-        if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QTextStream out(&file);
-            for (auto it = coupons.begin(); it != coupons.end(); ++it) {
-                out << it.key() << "," << it.value() << "\n";
-            }
-            file.close();
-        }
-        return;
-    }
+    TRACE_SCOPE("saveMenuItems");
+    ALLOC_SCOPE("save menu");
 
-    // Load coupons from file: CODE,discount
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        while (!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList parts = line.split(',');
-            if (parts.size() == 2) {
-                coupons[parts[0]] = parts[1].toDouble();
-            }
-        }
-        file.close();
-    }
+    catalog->saveMenu();
 }
 
 /******************************************************************
- * MainWindow::saveMenuItems --
- *   Save all current menu items to the menu file, one per line.
- *
- * Format:
- *   name,price,category,imagePath
+ * MainWindow::restoreSession --
+ *   Put back the cart the journal recorded before a crash or
+ *   reboot. The catalog has already restored unsaved menu edits.
+ *   Cart lines go through addToCart(), so they reserve stock and
+ *   take today's prices; lines whose item is gone are dropped.
  *
  * Parameters: none
  * Modifies:
- *   - MENU_FILE: overwritten with current menu contents
+ *   - engine: cart filled
  *
  * Returns: nothing
  ******************************************************************/
-void MainWindow::saveMenuItems()
+void MainWindow::restoreSession()
 {
-    QFile file(MENU_FILE);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&file);
-        for (const FoodItem &item : menuItems) {
-            out << item.name << "," << item.price << "," << item.category << "," << item.imagePath << "\n";
+    TRACE_SCOPE("restoreSession");
+    QElapsedTimer timer;
+    timer.start();
+
+    // Only the first screen tells the manager about restored edits
+    bool menuRestored = (screen == 0) && catalog->menuRestored();
+
+    QVector<OrderItem> lines;
+    int restored = 0;
+    if (journal.readCart(lines)) {
+        for (const OrderItem &line : lines) {
+            if (engine.addToCart(line.name, line.quantity)) {
+                ++restored;
+            }
         }
-        file.close();
+    }
+
+    if (!menuRestored && lines.isEmpty()) {
+        return;
+    }
+    qInfo("Session restored in %lld ms: %d of %d cart line(s)%s",
+          static_cast<long long>(timer.elapsed()), restored, int(lines.size()),
+          menuRestored ? ", unsaved menu edits" : "");
+
+    if (restored > 0) {
+        toasts->info(QString("Your order was restored (%1 item(s)).").arg(restored));
+    }
+    if (restored < lines.size()) {
+        toasts->warning(QString("%1 item(s) of your order are no longer available.").arg(lines.size() - restored));
+    }
+    if (menuRestored) {
+        toasts->info("Unsaved menu changes were restored. Use \"Save Changes\" to keep them.");
     }
 }
 
@@ -539,6 +548,7 @@ void MainWindow::saveMenuItems()
  *
  * Modifies:
  *   - keystrokeBuffer: appends numeric keys
+ *   - orderTaps: counts clicks and key presses
  *   - UI: may switch to manager view on correct password
  *
  * Returns:
@@ -547,28 +557,42 @@ void MainWindow::saveMenuItems()
  ******************************************************************/
 bool MainWindow::eventFilter(QObject *obj, QEvent *event)
 {
-    Q_UNUSED(obj);
+    // The filter is application-wide; other screens handle their own
+    if (!ownsEvent(obj)) {
+        return QMainWindow::eventFilter(obj, event);
+    }
+
+    countTap(obj, event);
 
     // Capture keyboard events in customer view only
     if (event->type() == QEvent::KeyPress && ui->stackedWidget->currentIndex() == 0) {
         QKeyEvent *keyEvent = static_cast<QKeyEvent*>(event);
         QString keyText = keyEvent->text();
 
-        // Only process number keys (secret code is numeric)
-        if (!keyText.isEmpty() && keyText[0].isDigit()) {
+        // Only process number keys (secret code is numeric), once per
+        // key: at window level, where every key arrives first. The
+        // code is checked before PLU entry below sees the key, so
+        // typing it works the same whether or not a text field has
+        // focus
+        if (obj->isWindowType() && !keyText.isEmpty() && keyText[0].isDigit()) {
             keystrokeBuffer += keyText;
 
-            // Keep only last 4 characters (length of "6677")
-            if (keystrokeBuffer.length() > 4) {
-                keystrokeBuffer = keystrokeBuffer.right(4);
+            // Keep only the last characters (length of the code)
+            if (keystrokeBuffer.length() > SECRET_CODE.length()) {
+                keystrokeBuffer = keystrokeBuffer.right(SECRET_CODE.length());
             }
 
             // Show typed keys briefly in status bar (debug / hint)
-            statusBar()->showMessage(QString("Keys: %1 (type '67' for manager access)").arg(keystrokeBuffer), 3000);
+            statusBar()->showMessage(QString("Keys: %1 (type '%2' for manager access)")
+                                         .arg(keystrokeBuffer)
+                                         .arg(SECRET_CODE),
+                                     3000);
 
             // Check if secret code was entered
             if (keystrokeBuffer == SECRET_CODE) {
                 keystrokeBuffer.clear();
+                pluEntry.clear();
+                updatePluEntryLabel(0);
                 statusBar()->clearMessage();
 
                 // Prompt for manager password
@@ -582,10 +606,10 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
                     // Correct password: go to manager mode
                     switchToManagerView();
                     updateManagerItemsList();
-                    QMessageBox::information(this, "Manager Mode", "Welcome to Manager Mode!");
+                    toasts->info("Welcome to Manager Mode!");
                 } else if (ok) {
                     // User pressed OK but password was wrong
-                    QMessageBox::warning(this, "Access Denied", "Incorrect password!");
+                    toasts->warning("Access denied: incorrect password!");
                     statusBar()->showMessage("Welcome to Cafeteria Ordering System");
                 } else {
                     // User cancelled dialog
@@ -595,6 +619,12 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
                 return true; // Event handled, do not pass further
             }
         }
+
+        // PLU keypad entry takes the key at window level (before any
+        // widget sees it). Non-digit PLU keys reset the code buffer.
+        if (obj == windowHandle() && handlePluKey(keyEvent)) {
+            return true;
+        }
     }
 
     // Pass event to default handler for all other cases
@@ -602,435 +632,1345 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
 }
 
 /******************************************************************
- * MainWindow::keyPressEvent --
- *   Override of the base class key press handler. Currently just
- *   calls the base implementation; the real secret-code logic is
- *   in eventFilter().
+ * MainWindow::ownsEvent --
+ *   With several screens every window's application filter sees
+ *   every event. An event is ours if it goes to one of our widgets,
+ *   to our window, or to a dialog opened over our window.
  *
  * Parameters:
- *   event - key event
+ *   obj - receiver of the event
  *
- * Returns: nothing
+ * Returns:
+ *   true if this window should handle the event
  ******************************************************************/
-void MainWindow::keyPressEvent(QKeyEvent *event)
+bool MainWindow::ownsEvent(QObject *obj) const
 {
-    QMainWindow::keyPressEvent(event);
+    if (QWidget *widget = qobject_cast<QWidget *>(obj)) {
+        // Dialogs are windows of their own, parented to ours
+        for (QWidget *top = widget->window(); top; ) {
+            if (top == this) {
+                return true;
+            }
+            top = top->parentWidget() ? top->parentWidget()->window() : nullptr;
+        }
+        return false;
+    }
+    if (QWindow *window = qobject_cast<QWindow *>(obj)) {
+        for (; window; window = window->transientParent()) {
+            if (window == windowHandle()) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return false;
 }
 
-// ========== VIEW SWITCHING ==========
-
 /******************************************************************
- * MainWindow::switchToCustomerView --
- *   Switch the stacked widget to show the customer interface.
+ * MainWindow::addFailureReason --
+ *   Explain why addToCart() refused an item that is on the menu.
  *
- * Parameters: none
- * Modifies:
- *   - stackedWidget current index
- *   - window title
+ * Parameters:
+ *   itemName - item that was refused
+ *   quantity - units asked for
  *
- * Returns: nothing
+ * Returns:
+ *   a message for the customer, or an empty string if the item is
+ *   not on the menu (callers keep their own message for that)
  ******************************************************************/
-void MainWindow::switchToCustomerView()
+QString MainWindow::addFailureReason(const QString &itemName, int quantity) const
 {
-    ui->stackedWidget->setCurrentIndex(0);
-    setWindowTitle("Cafeteria Ordering System");
+    FoodItem item;
+    if (!engine.findMenuItem(itemName, item)) {
+        return QString();
+    }
+    int available = engine.inventory()->available(item.id);
+    if (available == 0) {
+        return QString("%1 is sold out").arg(itemName);
+    }
+    if (available != Inventory::UNTRACKED && available < quantity) {
+        return QString("Only %1 %2 left").arg(available).arg(itemName);
+    }
+    return QString();
 }
 
 /******************************************************************
- * MainWindow::switchToManagerView --
- *   Switch the stacked widget to show the manager interface.
- *
- * Parameters: none
- * Modifies:
- *   - stackedWidget current index
- *   - window title
+ * MainWindow::countTap --
+ *   Count one cashier input for the current order. Every click and
+ *   key press reaches the application filter first for its window
+ *   (including dialog windows) and then again for each widget it is
+ *   delivered or propagated to, so only the window delivery is
+ *   counted. Key auto-repeat is ignored.
  *
- * Returns: nothing
- ******************************************************************/
-void MainWindow::switchToManagerView()
-{
-    ui->stackedWidget->setCurrentIndex(1);
-    setWindowTitle("Cafeteria Ordering System - MANAGER MODE");
-}
-
-// ========== CUSTOMER MENU FUNCTIONS ==========
-
-/******************************************************************
- * MainWindow::updateItemsList --
- *   Update the customer list of items based on the currently
- *   selected category in the combo box.
+ * Parameters:
+ *   obj   - receiver of the event
+ *   event - event seen by eventFilter()
  *
- * Parameters: none
  * Modifies:
- *   - itemsListWidget: cleared and repopulated
+ *   - orderTaps: +1 for a tap in the customer view
  *
  * Returns: nothing
  ******************************************************************/
-void MainWindow::updateItemsList()
+void MainWindow::countTap(QObject *obj, QEvent *event)
 {
-    ui->itemsListWidget->clear();
-    QString selectedCategory = ui->categoryComboBox->currentText();
-
-    // Filter items by category and add them with icons
-    for (const FoodItem &item : menuItems) {
-        if (item.category == selectedCategory) {
-            QString displayText = QString("%1 - $%2")
-            .arg(item.name)
-                .arg(item.price, 0, 'f', 2);
-            QListWidgetItem *listItem = new QListWidgetItem(displayText);
-
-            // Add icon if image path exists
-            if (!item.imagePath.isEmpty()) {
-                QIcon icon(item.imagePath);
-                if (!icon.isNull()) {
-                    listItem->setIcon(icon);
-                }
-            }
-
-            // Set item height for better image + text spacing
-            listItem->setSizeHint(QSize(0, 60));
-
-            ui->itemsListWidget->addItem(listItem);
-        }
+    if (!obj->isWindowType() || ui->stackedWidget->currentIndex() != 0) {
+        return;
+    }
+    if (event->type() == QEvent::MouseButtonPress
+        || (event->type() == QEvent::KeyPress && !static_cast<QKeyEvent *>(event)->isAutoRepeat())) {
+        ++orderTaps;
     }
 }
 
 /******************************************************************
- * MainWindow::updateCartDisplay --
- *   Rebuild the cart text area based on the current cart contents.
+ * MainWindow::handlePluKey --
+ *   Apply one key to the PLU entry. Entries look like "101" or
+ *   "2*101" (quantity, '*' or 'x', code) and are committed with
+ *   Enter; Backspace deletes a key and Escape clears the entry.
+ *   Digits from the numeric keypad are always PLU keys; other
+ *   digits are left alone while a text field (search box, spin
+ *   box) has focus. The time taken for each key, including adding
+ *   the item on Enter, is recorded in microseconds.
+ *
+ * Parameters:
+ *   keyEvent - key press delivered to the main window
  *
- * Parameters: none
  * Modifies:
- *   - cartTextEdit: shows a formatted summary of the cart and
- *                   current subtotal
+ *   - pluEntry, keystrokeBuffer (reset by non-digit PLU keys)
+ *   - cart, on Enter
  *
- * Returns: nothing
+ * Returns:
+ *   true if the key was used for PLU entry
  ******************************************************************/
-void MainWindow::updateCartDisplay()
+bool MainWindow::handlePluKey(QKeyEvent *keyEvent)
 {
-    ui->cartTextEdit->clear();
-    double subtotal = 0.0;
+    QWidget *focus = QApplication::focusWidget();
+    bool textField = qobject_cast<QLineEdit *>(focus) || qobject_cast<QAbstractSpinBox *>(focus);
+    if (textField && !(keyEvent->modifiers() & Qt::KeypadModifier)) {
+        return false;
+    }
 
-    QString cartText = "========== SHOPPING CART ==========\n\n";
+    QElapsedTimer timer;
+    timer.start();
 
-    if (cart.isEmpty()) {
-        cartText += "Your cart is empty.\n";
-    } else {
-        // List each item with quantity, price, and line total
-        for (const OrderItem &item : cart) {
-            double itemTotal = item.price * item.quantity;
-            subtotal += itemTotal;
-            cartText += QString("%1 x %2\n  @ $%3 each = $%4\n\n")
-                            .arg(item.quantity)
-                            .arg(item.name)
-                            .arg(item.price, 0, 'f', 2)
-                            .arg(itemTotal, 0, 'f', 2);
+    QString text = keyEvent->text();
+    int key = keyEvent->key();
+    bool digit = !text.isEmpty() && text[0].isDigit();
+
+    if (digit) {
+        if (pluEntry.size() >= 8) {
+            return true;   // Swallow runaway input
         }
-        cartText += "-----------------------------------\n";
-        cartText += QString("Subtotal: $%1\n").arg(subtotal, 0, 'f', 2);
+        pluEntry += text[0];
+    } else if ((text == "*" || text.compare("x", Qt::CaseInsensitive) == 0)
+               && !pluEntry.isEmpty() && !pluEntry.contains('*')) {
+        pluEntry += '*';
+    } else if (key == Qt::Key_Backspace && !pluEntry.isEmpty()) {
+        pluEntry.chop(1);
+    } else if (key == Qt::Key_Escape && !pluEntry.isEmpty()) {
+        pluEntry.clear();
+    } else if ((key == Qt::Key_Return || key == Qt::Key_Enter) && !pluEntry.isEmpty()) {
+        commitPluEntry();
+    } else {
+        return false;
     }
 
-    ui->cartTextEdit->setPlainText(cartText);
-}
+    if (!digit) {
+        keystrokeBuffer.clear();
+    }
 
-/******************************************************************
- * MainWindow::on_categoryComboBox_currentIndexChanged --
- *   Slot called when the user selects a different category.
- *
- * Parameters:
- *   index - index of the selected category (unused)
- *
- * Modifies:
- *   - itemsListWidget: updated with new category items
- *
- * Returns: nothing
- ******************************************************************/
-void MainWindow::on_categoryComboBox_currentIndexChanged(int index)
-{
-    Q_UNUSED(index);
-    updateItemsList();
+    qint64 elapsed = timer.nsecsElapsed();
+    Metrics::pluKeystrokeLatency().record(elapsed);
+    updatePluEntryLabel(elapsed);
+    return true;
 }
 
 /******************************************************************
- * MainWindow::on_addToCartButton_clicked --
- *   Slot called when the user presses "Add to Cart". It adds the
- *   selected menu item with the chosen quantity to the cart.
+ * MainWindow::commitPluEntry --
+ *   Resolve the typed code and add the item to the cart. Default
+ *   menu codes use the compile-time perfect hash; codes of items
+ *   the manager added use the runtime table.
  *
  * Parameters: none
  * Modifies:
- *   - cart: item added or quantity increased
- *   - cartTextEdit: updated display
+ *   - pluEntry: cleared
+ *   - cart and cartTextEdit: item added
  *
  * Returns: nothing
  ******************************************************************/
-void MainWindow::on_addToCartButton_clicked()
+void MainWindow::commitPluEntry()
 {
-    // Get selected item from the menu list
-    QListWidgetItem *selectedItem = ui->itemsListWidget->currentItem();
-    if (!selectedItem) {
-        QMessageBox::warning(this, "No Selection", "Please select an item to add.");
-        return;
+    TRACE_SCOPE("commitPluEntry");
+
+    QString entry = pluEntry;
+    pluEntry.clear();
+
+    int quantity = 1;
+    QString codeText = entry;
+    int star = entry.indexOf('*');
+    if (star >= 0) {
+        quantity = entry.left(star).toInt();
+        codeText = entry.mid(star + 1);
     }
 
-    // Get quantity from spin box
-    int quantity = ui->quantitySpinBox->value();
-    if (quantity <= 0) {
-        QMessageBox::warning(this, "Invalid Quantity", "Please enter a quantity greater than 0.");
+    bool ok = false;
+    int code = codeText.toInt(&ok);
+    if (!ok || quantity <= 0 || quantity > ui->quantitySpinBox->maximum()) {
+        toasts->warning(QString("Invalid PLU entry '%1'").arg(entry));
         return;
     }
 
-    // Parse item name from display text "Name - $Price"
-    QString displayText = selectedItem->text();
-    QString itemName = displayText.split(" - ")[0];
-
-    // Find the corresponding FoodItem in menuItems
-    for (const FoodItem &item : menuItems) {
-        if (item.name == itemName) {
-            // Check if item already exists in cart
-            bool found = false;
-            for (OrderItem &orderItem : cart) {
-                if (orderItem.name == itemName) {
-                    orderItem.quantity += quantity;
-                    found = true;
-                    break;
-                }
-            }
+    MenuSnapshotPtr menu = engine.menuSnapshot();
+    catalog->pluIndex().sync(menu);
+    QString itemName = catalog->pluIndex().resolve(code);
+    if (itemName.isEmpty()) {
+        toasts->warning(QString("Unknown PLU %1").arg(code));
+        return;
+    }
 
-            // If not in cart, add a brand new OrderItem
-            if (!found) {
-                OrderItem newItem;
-                newItem.name = item.name;
-                newItem.price = item.price;
-                newItem.quantity = quantity;
-                cart.append(newItem);
-            }
+    // Codes are known all day, but the item may be out of its hours
+    int row = menu->columns.rowOf(itemName);
+    if (row >= 0 && !menu->availability.isAvailable(row, currentSegment(menu))) {
+        toasts->warning(QString("%1 is not available now (%2)").arg(itemName).arg(menu->items[row].availability));
+        return;
+    }
 
-            updateCartDisplay();
-            QMessageBox::information(this, "Added to Cart",
-                                     QString("Added %1 x %2 to cart!").arg(quantity).arg(itemName));
-            ui->quantitySpinBox->setValue(1); // Reset quantity to 1
+    {
+        ALLOC_SCOPE("plu entry");
+        if (!engine.addToCart(itemName, quantity)) {
+            QString reason = addFailureReason(itemName, quantity);
+            toasts->warning(!reason.isEmpty() ? reason
+                                              : QString("PLU %1 (%2) is not on the menu").arg(code).arg(itemName));
             return;
         }
+        updateCartDisplay();
     }
+    statusBar()->showMessage(QString("Added %1 x %2 (PLU %3)").arg(quantity).arg(itemName).arg(code), 3000);
 }
 
 /******************************************************************
- * MainWindow::on_clearCartButton_clicked --
- *   Slot called when the user presses "Clear Cart". It asks for
- *   confirmation and then removes all items from the cart.
+ * MainWindow::updatePluEntryLabel --
+ *   Show the entry being typed and how long the last key took.
+ *
+ * Parameters:
+ *   keyNs - handling time of the last key in ns (0 = not shown)
  *
- * Parameters: none
  * Modifies:
- *   - cart: cleared on confirmation
- *   - cartTextEdit: updated display
+ *   - pluEntryLabel
  *
  * Returns: nothing
  ******************************************************************/
-void MainWindow::on_clearCartButton_clicked()
+void MainWindow::updatePluEntryLabel(qint64 keyNs)
 {
-    if (cart.isEmpty()) {
-        QMessageBox::information(this, "Cart Empty", "Your cart is already empty.");
-        return;
-    }
-
-    QMessageBox::StandardButton reply;
-    reply = QMessageBox::question(this, "Clear Cart", "Are you sure you want to clear your cart?",
-                                  QMessageBox::Yes | QMessageBox::No);
-
-    if (reply == QMessageBox::Yes) {
-        cart.clear();
-        updateCartDisplay();
-        QMessageBox::information(this, "Cart Cleared", "Your cart has been cleared.");
+    QString text = pluEntry.isEmpty() ? QString("PLU: type [qty *] code, then Enter")
+                                      : QString("PLU: %1_").arg(QString(pluEntry).replace('*', " x "));
+    if (keyNs > 0) {
+        text += QString("   (%1 us)").arg(keyNs / 1000.0, 0, 'f', 1);
     }
+    ui->pluEntryLabel->setText(text);
 }
 
 /******************************************************************
- * MainWindow::on_checkoutButton_clicked --
- *   Slot called when the user presses "Checkout". It calculates
- *   subtotal, applies coupon (if valid), adds tax, then shows a
- *   formatted receipt.
+ * MainWindow::recordCompletedOrder --
+ *   Book the taps of an order that was just paid, per mode, and
+ *   show the running taps-per-order averages for the standard and
+ *   fast lane flows side by side. Declined orders are not booked,
+ *   so the averages match cafeteria_orders_total.
+ *
+ * Parameters:
+ *   taps          - taps the order took
+ *   fastLaneOrder - it was entered in fast lane mode
  *
- * Parameters: none
  * Modifies:
- *   - cart: cleared after successful checkout
+ *   - Metrics: order taps counters
  *
  * Returns: nothing
  ******************************************************************/
-void MainWindow::on_checkoutButton_clicked()
+void MainWindow::recordCompletedOrder(int taps, bool fastLaneOrder)
 {
-    if (cart.isEmpty()) {
-        QMessageBox::warning(this, "Empty Cart", "Your cart is empty. Please add items before checkout.");
-        return;
-    }
-
-    // Calculate subtotal
-    double subtotal = 0.0;
-    for (const OrderItem &item : cart) {
-        subtotal += item.price * item.quantity;
-    }
-
-    // Ask user for optional coupon code
-    bool ok;
-    QString couponCode = QInputDialog::getText(this, "Coupon Code",
-                                               "Enter coupon code (or leave blank):",
-                                               QLineEdit::Normal,
-                                               "", &ok);
-
-    double discountPercent = 0.0;
-    if (ok && !couponCode.isEmpty()) {
-        couponCode = couponCode.toUpper();
-        if (coupons.contains(couponCode)) {
-            discountPercent = coupons[couponCode];
-        } else {
-            QMessageBox::warning(this, "Invalid Coupon", "Coupon code not recognized. Proceeding without discount.");
-            couponCode.clear();
-        }
-    }
-
-    // Calculate discount and apply it
-    double discountAmount = subtotal * discountPercent;
-    double afterDiscount = subtotal - discountAmount;
-
-    // Add tax based on discounted amount
-    double taxAmount = afterDiscount * TAX_RATE;
-
-    // Final total
-    double total = afterDiscount + taxAmount;
-
-    // Show receipt dialog
-    // NOTE: showReceipt() is now adapted from receipt.cpp and uses round2()
-    // for consistent money formatting and adds date/time at the bottom.
-    showReceipt(subtotal, discountAmount, taxAmount, total, couponCode);
+    Metrics::orderTapsTotal().increment(quint64(taps));
+    if (fastLaneOrder) {
+        Metrics::fastLaneOrdersTotal().increment();
+        Metrics::fastLaneTapsTotal().increment(quint64(taps));
+    }
+
+    quint64 fastOrders = Metrics::fastLaneOrdersTotal().value();
+    quint64 fastTaps = Metrics::fastLaneTapsTotal().value();
+    quint64 standardOrders = Metrics::ordersTotal().value() - fastOrders;
+    quint64 standardTaps = Metrics::orderTapsTotal().value() - fastTaps;
+
+    QString average = QString::fromLatin1("Order done in %1 taps (average: %2 standard, %3 fast lane)")
+                          .arg(taps)
+                          .arg(standardOrders ? QString::number(double(standardTaps) / standardOrders, 'f', 1) : QString("-"))
+                          .arg(fastOrders ? QString::number(double(fastTaps) / fastOrders, 'f', 1) : QString("-"));
+    statusBar()->showMessage(average, 10000);
+}
 
-    // Clear cart for next customer
-    cart.clear();
-    updateCartDisplay();
+/******************************************************************
+ * MainWindow::keyPressEvent --
+ *   Override of the base class key press handler. Currently just
+ *   calls the base implementation; the real secret-code logic is
+ *   in eventFilter().
+ *
+ * Parameters:
+ *   event - key event
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::keyPressEvent(QKeyEvent *event)
+{
+    QMainWindow::keyPressEvent(event);
 }
 
 /******************************************************************
- * MainWindow::showReceipt --
- *   Build a text receipt showing each item, the subtotal, discount,
- *   tax, and total, then display it in a QMessageBox.
- *
- *   ADAPTED FROM Elliot's receipt.cpp:
- *     - Kept the idea of listing items and showing subtotal, tax,
- *       and total with clean 2-decimal formatting.
- *     - REMOVED his separate 7% PST. This program only applies
- *       a single 5% tax based on BC tax on food (TAX_RATE).
- *     - Uses round2() for all money values (same logic as their
- *       console version).
- *     - Adds date and time at the bottom using QDateTime instead
- *       of <ctime> since we are using Qt.
+ * MainWindow::closeEvent --
+ *   The screen is closed while the others may keep selling: give
+ *   its cart's reserved stock back. The journal is not touched, so
+ *   the cart is restored (and reserved again) on the next start.
  *
  * Parameters:
- *   subtotal   - sum of item costs before discount
- *   discount   - discount amount in dollars
- *   tax        - tax amount in dollars (already 5% of discounted)
- *   total      - final amount to pay
- *   couponCode - text of coupon applied (may be empty)
+ *   event - close event
  *
  * Modifies:
- *   - Shows a dialog box with the receipt text
+ *   - engine: cart cleared, its stock released
  *
  * Returns: nothing
  ******************************************************************/
-void MainWindow::showReceipt(double subtotal, double discount, double tax, double total, QString couponCode)
+void MainWindow::closeEvent(QCloseEvent *event)
 {
-    // Round all monetary values to 2 decimal places (adapted from receipt.cpp)
-    subtotal = round2(subtotal);
-    discount = round2(discount);
-    tax      = round2(tax);
-    total    = round2(total);
-
-    QString receipt;
-    receipt += "========================================\n";
-    receipt += "           CAFETERIA RECEIPT\n";
-    receipt += "========================================\n\n";
-
-    // Header row similar in spirit to teammate's receipt (Item / Price)
-    receipt += QString("%1%2%3\n")
-                   .arg("Qty",  -5)
-                   .arg("Item", -20)
-                   .arg("Price", 10);
-    receipt += "----------------------------------------\n";
-
-    // List all items in the cart (one row per OrderItem)
-    for (const OrderItem &item : cart) {
-        double itemTotal = item.price * item.quantity;
-
-        // Each row: quantity, name (trimmed to 20 chars), line total
-        receipt += QString("%1%2%3\n")
-                       .arg(item.quantity, -5)
-                       .arg(item.name.left(20), -20)
-                       .arg(itemTotal, 10, 'f', 2);
-    }
-
-    receipt += "----------------------------------------\n";
-
-    // Show subtotal
-    receipt += QString("%1%2\n")
-                   .arg("Subtotal:", -25)
-                   .arg(subtotal, 10, 'f', 2);
-
-    // Show discount if any
-    if (discount > 0.0) {
-        QString label = QString("Discount (%1):").arg(couponCode);
-        receipt += QString("%1-%2\n")
-                       .arg(label, -25)
-                       .arg(discount, 9, 'f', 2);
-    }
-
-    // NOTE: Only 5% tax is used (TAX_RATE).
-    // Teammate's receipt.cpp had both GST (5%) and PST (7%).
-    receipt += QString("%1%2\n")
-                   .arg("Tax (5%):", -25)
-                   .arg(tax, 10, 'f', 2);
-
-    receipt += "----------------------------------------\n";
-    receipt += QString("%1%2\n")
-                   .arg("TOTAL:", -25)
-                   .arg(total, 10, 'f', 2);
-    receipt += "========================================\n\n";
-
-    // Add date and time at the bottom (Qt version of ctime in receipt.cpp)
-    QDateTime now = QDateTime::currentDateTime();
-    receipt += "Date and Time: " + now.toString("yyyy-MM-dd hh:mm:ss") + "\n";
-    receipt += "========================================\n";
-
-    QMessageBox receiptBox;
-    receiptBox.setWindowTitle("Order Receipt");
-    receiptBox.setText(receipt);
-    receiptBox.setIcon(QMessageBox::Information);
-    receiptBox.exec();
+    engine.clearCart();
+    QMainWindow::closeEvent(event);
 }
 
-// ========== MANAGER MENU FUNCTIONS ==========
+// ========== VIEW SWITCHING ==========
 
 /******************************************************************
- * MainWindow::updateManagerItemsList --
- *   Repopulate the manager list widget with all menu items.
+ * MainWindow::switchToCustomerView --
+ *   Switch the stacked widget to show the customer interface.
  *
  * Parameters: none
  * Modifies:
- *   - managerItemsListWidget: cleared and filled with "[category] name - $price"
+ *   - stackedWidget current index
+ *   - window title
+ *   - orderTaps: reset
  *
  * Returns: nothing
  ******************************************************************/
-void MainWindow::updateManagerItemsList()
+void MainWindow::switchToCustomerView()
 {
-    ui->managerItemsListWidget->clear();
-
-    for (const FoodItem &item : menuItems) {
-        QString displayText = QString("[%1] %2 - $%3")
-        .arg(item.category)
-            .arg(item.name)
-            .arg(item.price, 0, 'f', 2);
-        ui->managerItemsListWidget->addItem(displayText);
-    }
+    ui->stackedWidget->setCurrentIndex(0);
+    orderTaps = 0;   // Manager work is not part of the next order
+    setWindowTitle(screenTitle("Cafeteria Ordering System"));
 }
 
 /******************************************************************
- * MainWindow::on_managerBackButton_clicked --
+ * MainWindow::switchToManagerView --
+ *   Switch the stacked widget to show the manager interface and
+ *   warn about menu pictures that could not be loaded (customers
+ *   see the placeholder for them).
+ *
+ * Parameters: none
+ * Modifies:
+ *   - stackedWidget current index
+ *   - window title
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::switchToManagerView()
+{
+    TRACE_SCOPE("switchToManagerView");
+
+    ui->stackedWidget->setCurrentIndex(1);
+    setWindowTitle(screenTitle("Cafeteria Ordering System - MANAGER MODE"));
+
+    const int SHOWN_PATHS = 3;
+    QStringList missing = catalog->assets().missing();
+    if (!missing.isEmpty()) {
+        QString paths = QStringList(missing.mid(0, SHOWN_PATHS)).join(", ");
+        if (missing.size() > SHOWN_PATHS) {
+            paths += QString(" and %1 more").arg(missing.size() - SHOWN_PATHS);
+        }
+        toasts->warning(QString("%1 menu picture(s) not found: %2").arg(missing.size()).arg(paths));
+    }
+}
+
+// ========== CUSTOMER MENU FUNCTIONS ==========
+
+/******************************************************************
+ * MainWindow::updateItemsList --
+ *   Update the customer list of items. If the search box has text,
+ *   show the best search matches from every category; otherwise
+ *   show the items in the category selected in the combo box.
+ *   Items outside their availability window are left out.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - itemsListWidget: cleared and repopulated
+ *   - shownVersion, shownSegment, availabilityTimer
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::updateItemsList()
+{
+    TRACE_SCOPE("updateItemsList");
+
+    // The snapshot cannot change while we read it, even if the menu
+    // is edited meanwhile
+    MenuSnapshotPtr menu = engine.menuSnapshot();
+    ui->itemsListWidget->clear();
+    catalog->pluIndex().sync(menu);   // PLU tooltips
+    catalog->assets().sync(menu);     // Icons, once per menu version
+
+    // "What is on sale now" is one lookup in the precomputed index;
+    // each row is then a bit test, not a schedule evaluation
+    int segment = currentSegment(menu);
+    const QVector<int> rows = listedRows(menu);
+    for (int row : rows) {
+        if (menu->availability.isAvailable(row, segment)) {
+            addItemToList(menu->items[row]);
+        }
+    }
+
+    shownVersion = menu->version;
+    shownSegment = segment;
+    scheduleAvailabilityCheck(menu);
+}
+
+/******************************************************************
+ * MainWindow::patchItemsList --
+ *   Bring the customer list up to the current menu after a delta.
+ *   The list and the rows it should show are walked side by side,
+ *   matched by the item ID in Qt::UserRole: rows of items that are
+ *   no longer listed are removed, rows of the delta's items are
+ *   redrawn or inserted, and every other row is left alone.
+ *
+ * Parameters:
+ *   delta - items added, removed and changed
+ *
+ * Modifies:
+ *   - itemsListWidget: the rows of the delta's items
+ *   - shownVersion, shownSegment, availabilityTimer
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::patchItemsList(const MenuDelta &delta)
+{
+    TRACE_SCOPE("patchItemsList");
+
+    MenuSnapshotPtr menu = engine.menuSnapshot();
+    const QVector<qint32> &itemIds = menu->columns.itemIds;
+    catalog->pluIndex().sync(menu);
+    catalog->assets().sync(menu);
+
+    // Changed items carry their live ID; added ones are found by name
+    QSet<int> touched;
+    for (const FoodItem &item : delta.changed) {
+        touched.insert(item.id);
+    }
+    for (const FoodItem &item : delta.added) {
+        int row = menu->columns.rowOf(item.name);
+        if (row >= 0) {
+            touched.insert(itemIds[row]);
+        }
+    }
+
+    int segment = currentSegment(menu);
+    QVector<int> wanted;
+    QSet<int> wantedIds;
+    const QVector<int> rows = listedRows(menu);
+    for (int row : rows) {
+        if (menu->availability.isAvailable(row, segment)) {
+            wanted.append(row);
+            wantedIds.insert(itemIds[row]);
+        }
+    }
+
+    QListWidget *list = ui->itemsListWidget;
+    int position = 0;
+    for (int row : wanted) {
+        while (position < list->count()
+               && !wantedIds.contains(list->item(position)->data(Qt::UserRole).toInt())) {
+            delete list->takeItem(position);   // Removed, or moved off this list
+        }
+        QListWidgetItem *shown = list->item(position);   // nullptr past the end
+        bool keep = shown && shown->data(Qt::UserRole).toInt() == itemIds[row]
+                    && !touched.contains(itemIds[row]);
+        if (!keep) {
+            if (shown && shown->data(Qt::UserRole).toInt() == itemIds[row]) {
+                delete list->takeItem(position);
+            }
+            addItemToList(menu->items[row], position);
+        }
+        ++position;
+    }
+    while (list->count() > position) {
+        delete list->takeItem(position);
+    }
+
+    shownVersion = menu->version;
+    shownSegment = segment;
+    scheduleAvailabilityCheck(menu);
+}
+
+/******************************************************************
+ * MainWindow::listedRows --
+ *   Rows the customer list would show if everything were on sale.
+ *
+ * Parameters:
+ *   menu - snapshot the rows refer to
+ *
+ * Returns:
+ *   search matches (ranked) or the selected category (menu order)
+ ******************************************************************/
+QVector<int> MainWindow::listedRows(const MenuSnapshotPtr &menu)
+{
+    QVector<int> rows;
+
+    // Search results come from the n-gram index, already ranked
+    QString query = ui->searchLineEdit->text();
+    if (!query.trimmed().isEmpty()) {
+        const QVector<FoodItem> matches = catalog->searchIndex().search(query);
+        rows.reserve(matches.size());
+        for (const FoodItem &item : matches) {
+            int row = menu->columns.rowOf(item.name);
+            if (row >= 0) {
+                rows.append(row);
+            }
+        }
+        return rows;
+    }
+
+    // The filter scans the compact category ID column, not strings
+    int categoryId = menu->columns.categoryId(ui->categoryComboBox->currentText());
+    return menu->columns.rowsInCategory(categoryId);
+}
+
+/******************************************************************
+ * MainWindow::currentSegment --
+ *   Availability segment of a snapshot for the current local time.
+ ******************************************************************/
+int MainWindow::currentSegment(const MenuSnapshotPtr &menu)
+{
+    return menu->availability.segmentAt(AvailabilityIndex::minuteOfWeek(QDateTime::currentDateTime()));
+}
+
+/******************************************************************
+ * MainWindow::scheduleAvailabilityCheck --
+ *   Arm availabilityTimer for the start of the minute in which the
+ *   shown menu next changes. Long waits are cut to
+ *   MAX_AVAILABILITY_WAIT_MS so a clock change or a suspended
+ *   machine is noticed; an early wake-up just re-arms.
+ *
+ * Parameters:
+ *   menu - snapshot the customer list shows
+ *
+ * Modifies:
+ *   - availabilityTimer: started, or stopped if nothing is
+ *     scheduled
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::scheduleAvailabilityCheck(const MenuSnapshotPtr &menu)
+{
+    QDateTime now = QDateTime::currentDateTime();
+    int minutes = menu->availability.minutesUntilChange(AvailabilityIndex::minuteOfWeek(now));
+    if (minutes < 0) {
+        availabilityTimer->stop();
+        return;
+    }
+
+    QTime clock = now.time();
+    qint64 waitMs = qint64(minutes) * 60000 - clock.second() * 1000 - clock.msec();
+    availabilityTimer->start(int(qBound<qint64>(1, waitMs, MAX_AVAILABILITY_WAIT_MS)));
+}
+
+/******************************************************************
+ * MainWindow::onAvailabilityTimeout --
+ *   Switch the customer list to the items on sale now. Rows keep
+ *   their order, so one pass over the listed rows removes the
+ *   items that went off sale and inserts the ones that came on,
+ *   without rebuilding the list or losing the customer's place.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - itemsListWidget: changed rows removed/inserted
+ *   - shownSegment, availabilityTimer
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::onAvailabilityTimeout()
+{
+    TRACE_SCOPE("onAvailabilityTimeout");
+
+    MenuSnapshotPtr menu = engine.menuSnapshot();
+    if (menu->version != shownVersion) {
+        updateItemsList();   // Segments belong to one menu version
+        return;
+    }
+
+    int segment = currentSegment(menu);
+    if (segment == shownSegment) {
+        scheduleAvailabilityCheck(menu);   // Woke up early
+        return;
+    }
+    TRACE_SCOPE("availabilitySwitchover");
+
+    QListWidget *list = ui->itemsListWidget;
+    const AvailabilityIndex &availability = menu->availability;
+    int position = 0;
+    int added = 0;
+    int removed = 0;
+
+    list->setUpdatesEnabled(false);
+    const QVector<int> rows = listedRows(menu);
+    for (int row : rows) {
+        bool wasShown = availability.isAvailable(row, shownSegment);
+        bool isShown = availability.isAvailable(row, segment);
+        if (wasShown && !isShown) {
+            delete list->takeItem(position);
+            ++removed;
+            continue;
+        }
+        if (isShown && !wasShown) {
+            addItemToList(menu->items[row], position);
+            ++added;
+        }
+        if (isShown) {
+            ++position;
+        }
+    }
+    list->setUpdatesEnabled(true);
+
+    shownSegment = segment;
+    scheduleAvailabilityCheck(menu);
+    upsellTimer->start();   // Suggestions follow the schedule too
+
+    if (added > 0 || removed > 0) {
+        statusBar()->showMessage(QString("Menu switched over: %1 items now available, %2 no longer available")
+                                     .arg(added)
+                                     .arg(removed),
+                                 5000);
+    }
+}
+
+/******************************************************************
+ * MainWindow::updateCategoryList --
+ *   Refill the category combo box from the snapshot's category
+ *   registry (no menu scan). The current selection is kept if the
+ *   category still exists. Each entry's tooltip shows its item
+ *   count and price range.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - categoryComboBox: entries replaced
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::updateCategoryList()
+{
+    MenuSnapshotPtr menu = engine.menuSnapshot();
+    const CategoryRegistry &categories = menu->categories;
+    QString selected = ui->categoryComboBox->currentText();
+
+    // Avoid a list refresh per inserted entry
+    ui->categoryComboBox->blockSignals(true);
+    ui->categoryComboBox->clear();
+    for (const CategoryStats &category : categories.categories()) {
+        ui->categoryComboBox->addItem(category.name);
+        ui->categoryComboBox->setItemData(ui->categoryComboBox->count() - 1,
+                                          categories.summary(category.name),
+                                          Qt::ToolTipRole);
+    }
+    int index = ui->categoryComboBox->findText(selected);
+    ui->categoryComboBox->setCurrentIndex(index >= 0 ? index : 0);
+    ui->categoryComboBox->blockSignals(false);
+}
+
+/******************************************************************
+ * MainWindow::addItemToList --
+ *   Add one menu item (text "Name - $Price" plus icon) to the
+ *   customer list.
+ *
+ * Parameters:
+ *   item     - menu item to show
+ *   position - list row to insert at, or -1 to append
+ *
+ * Modifies:
+ *   - itemsListWidget: one row added
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::addItemToList(const FoodItem &item, int position)
+{
+    QString displayText = QString("%1 - $%2")
+    .arg(item.name)
+        .arg(item.price, 0, 'f', 2);
+    QListWidgetItem *listItem = new QListWidgetItem(displayText);
+    listItem->setData(Qt::UserRole, item.id);   // Rows are found again by item ID
+
+    // Sold out items stay listed but cannot be picked
+    if (engine.inventory()->isSoldOut(item.id)) {
+        listItem->setText(QString("%1 - Sold out").arg(item.name));
+        listItem->setFlags(listItem->flags() & ~(Qt::ItemIsEnabled | Qt::ItemIsSelectable));
+    }
+
+    // Cached icon, or the shared placeholder if the item has no picture
+    listItem->setIcon(catalog->assets().icon(item.imagePath));
+
+    // Set item height for better image + text spacing
+    listItem->setSizeHint(QSize(0, 60));
+
+    // Keypad code for fast entry
+    int code = catalog->pluIndex().codeFor(item.name);
+    if (code != 0) {
+        listItem->setToolTip(QString("PLU %1").arg(code));
+    }
+
+    if (position < 0) {
+        ui->itemsListWidget->addItem(listItem);
+    } else {
+        ui->itemsListWidget->insertItem(position, listItem);
+    }
+}
+
+/******************************************************************
+ * MainWindow::updateCartDisplay --
+ *   Rebuild the cart text area based on the current cart contents.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - cartTextEdit: shows a formatted summary of the cart and
+ *                   current subtotal
+ *   - upsellTimer: started
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::updateCartDisplay()
+{
+    TRACE_SCOPE("updateCartDisplay");
+
+    // Formatted by the engine in the order arena
+    ui->cartTextEdit->setPlainText(engine.buildCartText());
+
+    // Every cart change ends here: keep the crash journal current
+    journal.recordCart(engine.cartItems());
+
+    // Suggestions follow once this event has been handled
+    upsellTimer->start();
+}
+
+/******************************************************************
+ * MainWindow::on_categoryComboBox_currentIndexChanged --
+ *   Slot called when the user selects a different category.
+ *
+ * Parameters:
+ *   index - index of the selected category (unused)
+ *
+ * Modifies:
+ *   - itemsListWidget: updated with new category items
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_categoryComboBox_currentIndexChanged(int index)
+{
+    TRACE_SCOPE("on_categoryComboBox_currentIndexChanged");
+
+    ALLOC_SCOPE("category switch");
+    Q_UNUSED(index);
+    updateItemsList();
+}
+
+/******************************************************************
+ * MainWindow::on_searchLineEdit_textChanged --
+ *   Slot called on every keystroke in the search box. Refreshes
+ *   the item list with the matches (or the selected category when
+ *   the box is cleared).
+ *
+ * Parameters:
+ *   text - current search text (unused; read in updateItemsList)
+ *
+ * Modifies:
+ *   - itemsListWidget: updated with search results
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_searchLineEdit_textChanged(const QString &text)
+{
+    TRACE_SCOPE("on_searchLineEdit_textChanged");
+
+    ALLOC_SCOPE("search keystroke");
+    Q_UNUSED(text);
+    updateItemsList();
+}
+
+/******************************************************************
+ * MainWindow::on_addToCartButton_clicked --
+ *   Slot called when the user presses "Add to Cart". It adds the
+ *   selected menu item with the chosen quantity to the cart.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - cart: item added or quantity increased
+ *   - cartTextEdit: updated display
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_addToCartButton_clicked()
+{
+    TRACE_SCOPE("on_addToCartButton_clicked");
+
+    // Get selected item from the menu list
+    QListWidgetItem *selectedItem = ui->itemsListWidget->currentItem();
+    if (!selectedItem) {
+        toasts->warning("Please select an item to add.");
+        return;
+    }
+
+    // Get quantity from spin box
+    int quantity = ui->quantitySpinBox->value();
+    if (quantity <= 0) {
+        toasts->warning("Please enter a quantity greater than 0.");
+        return;
+    }
+
+    // The row carries the item ID; the name comes from the current menu
+    int itemId = selectedItem->data(Qt::UserRole).toInt();
+    MenuSnapshotPtr menu = engine.menuSnapshot();
+    int row = menu->columns.itemIds.indexOf(itemId);
+    if (row < 0) {
+        toasts->warning("That item is no longer available.");
+        return;
+    }
+    QString itemName = menu->items[row].name;
+
+    // Add to the cart (merges with an existing line for the same item)
+    {
+        ALLOC_SCOPE("add to cart");
+        if (!engine.addToCart(itemName, quantity)) {
+            QString reason = addFailureReason(itemName, quantity);
+            if (reason.isEmpty()) {
+                reason = QString("%1 is no longer available").arg(itemName);
+            }
+            toasts->warning(reason);
+            return;
+        }
+        updateCartDisplay();
+    }
+    toasts->info(QString("Added %1 x %2 to cart!").arg(quantity).arg(itemName));
+    ui->quantitySpinBox->setValue(1); // Reset quantity to 1
+}
+
+/******************************************************************
+ * MainWindow::on_upsellListWidget_itemClicked --
+ *   Slot called when the user taps a suggestion. One of the item
+ *   is added to the cart, the same way as with "Add to Cart".
+ *
+ * Parameters:
+ *   item - tapped suggestion ("Name - $Price", name in UserRole)
+ *
+ * Modifies:
+ *   - cart: item added or quantity increased
+ *   - cartTextEdit: updated display
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_upsellListWidget_itemClicked(QListWidgetItem *item)
+{
+    TRACE_SCOPE("on_upsellListWidget_itemClicked");
+
+    QString itemName = item->data(Qt::UserRole).toString();
+    {
+        ALLOC_SCOPE("add to cart");
+        if (!engine.addToCart(itemName, 1)) {
+            QString reason = addFailureReason(itemName, 1);
+            if (!reason.isEmpty()) {
+                toasts->warning(reason);
+            }
+            return;
+        }
+        updateCartDisplay();
+    }
+    toasts->info(QString("Added 1 x %1 to cart!").arg(itemName));
+}
+
+/******************************************************************
+ * MainWindow::onUpsellTimeout --
+ *   Show what other customers bought with the items in the cart.
+ *   Only items of the upsell categories that are on sale now and
+ *   not sold out are offered; the panel is hidden when there is
+ *   nothing to offer.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - upsellListWidget, upsellLabel
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::onUpsellTimeout()
+{
+    TRACE_SCOPE("onUpsellTimeout");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QStringList cart;
+    for (const OrderItem &line : engine.cartItems()) {
+        cart << line.name;
+    }
+
+    MenuSnapshotPtr menu = engine.menuSnapshot();
+    int segment = currentSegment(menu);
+    const QStringList &categories = catalog->upsellCategories();
+    QStringList names = catalog->upsellIndex().suggest(cart, UPSELL_COUNT, [&](const QString &name) {
+        int row = menu->columns.rowOf(name);
+        return row >= 0
+               && categories.contains(menu->items[row].category)
+               && menu->availability.isAvailable(row, segment)
+               && !engine.inventory()->isSoldOut(menu->items[row].id);
+    });
+
+    QListWidget *list = ui->upsellListWidget;
+    list->clear();
+    for (const QString &name : names) {
+        const FoodItem &item = menu->items[menu->columns.rowOf(name)];
+        QListWidgetItem *listItem = new QListWidgetItem(QString("%1 - $%2").arg(item.name).arg(item.price, 0, 'f', 2));
+        listItem->setData(Qt::UserRole, item.name);
+        list->addItem(listItem);
+    }
+    ui->upsellLabel->setVisible(!names.isEmpty());
+    list->setVisible(!names.isEmpty());
+
+    Metrics::upsellQueryDuration().record(timer.nsecsElapsed());
+}
+
+/******************************************************************
+ * MainWindow::on_clearCartButton_clicked --
+ *   Slot called when the user presses "Clear Cart". It asks for
+ *   confirmation (except in fast lane mode) and then removes all
+ *   items from the cart.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - cart: cleared on confirmation
+ *   - cartTextEdit: updated display
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_clearCartButton_clicked()
+{
+    TRACE_SCOPE("on_clearCartButton_clicked");
+
+    if (engine.cartItems().empty()) {
+        toasts->info("Your cart is already empty.");
+        return;
+    }
+
+    if (!fastLane) {
+        QMessageBox::StandardButton reply;
+        reply = QMessageBox::question(this, "Clear Cart", "Are you sure you want to clear your cart?",
+                                      QMessageBox::Yes | QMessageBox::No);
+        if (reply != QMessageBox::Yes) {
+            return;
+        }
+    }
+
+    engine.clearCart();
+    updateCartDisplay();
+    toasts->info("Your cart has been cleared.");
+}
+
+/******************************************************************
+ * MainWindow::on_fastLaneCheckBox_toggled --
+ *   Slot for the "Fast Lane" check box in manager view.
+ *
+ * Parameters:
+ *   checked - true to turn fast lane mode on
+ *
+ * Modifies:
+ *   - fastLane
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_fastLaneCheckBox_toggled(bool checked)
+{
+    fastLane = checked;
+}
+
+/******************************************************************
+ * MainWindow::on_checkoutButton_clicked --
+ *   Slot called when the user presses "Checkout". It asks for a
+ *   coupon (not in fast lane mode) and hands the cart to the
+ *   checkout pipeline, which prices it and clears the cart at once.
+ *   Payment, logging and the receipt follow asynchronously (see
+ *   onOrderCompleted), so the next customer can start right away.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - cart: cleared when the order is submitted
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_checkoutButton_clicked()
+{
+    TRACE_SCOPE("on_checkoutButton_clicked");
+
+    if (engine.cartItems().empty()) {
+        toasts->warning("Your cart is empty. Please add items before checkout.");
+        return;
+    }
+
+    // Ask user for optional coupon code (fast lane: no coupons)
+    QString couponCode;
+    if (!fastLane) {
+        bool ok;
+        couponCode = QInputDialog::getText(this, "Coupon Code",
+                                           "Enter coupon code (or leave blank):",
+                                           QLineEdit::Normal,
+                                           "", &ok);
+
+        if (!ok) {
+            couponCode.clear();
+        }
+    }
+
+    // Coupon check and pricing happen now (unknown coupons are
+    // reported through onCouponRejected); the engine clears the cart
+    quint64 orderId;
+    {
+        ALLOC_SCOPE("checkout");
+        orderId = checkoutPipeline->submit(engine, couponCode);
+    }
+
+    // Taps are booked when the payment is approved
+    paymentTaps.insert(orderId, qMakePair(orderTaps, fastLane));
+    orderTaps = 0;
+
+    updateCartDisplay();
+    toasts->info(QString("Order #%1 sent for payment").arg(orderId));
+}
+
+/******************************************************************
+ * MainWindow::onCouponRejected --
+ *   Pipeline stage 1 found an unknown coupon code.
+ ******************************************************************/
+void MainWindow::onCouponRejected(quint64 orderId, const QString &code)
+{
+    Q_UNUSED(orderId);
+    toasts->warning(QString("Coupon code '%1' not recognized. Proceeding without discount.").arg(code));
+}
+
+/******************************************************************
+ * MainWindow::onCheckoutStageChanged --
+ *   Keep the "orders in progress" indicator in the status bar up
+ *   to date.
+ *
+ * Parameters:
+ *   orderId - order that changed stage (unused)
+ *   stage   - its new stage (unused)
+ *
+ * Modifies:
+ *   - checkoutStatusLabel
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::onCheckoutStageChanged(quint64 orderId, CheckoutPipeline::Stage stage)
+{
+    Q_UNUSED(orderId);
+    Q_UNUSED(stage);
+
+    int inFlight = checkoutPipeline->inFlight();
+    checkoutStatusLabel->setText(inFlight > 0
+                                     ? QString("%1 order(s) in progress - %2").arg(inFlight).arg(paymentService->name())
+                                     : QString());
+}
+
+/******************************************************************
+ * MainWindow::onOrderCompleted --
+ *   An order was paid, logged and spooled. The receipt is shown in
+ *   a receipt window; in fast lane mode it goes to the cart box
+ *   instead, but only while no new order has been started.
+ *
+ * Parameters:
+ *   order - completed order (receipt includes the payment line)
+ *
+ * Modifies:
+ *   - receipt window or cartTextEdit
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::onOrderCompleted(const PipelineOrder &order)
+{
+    TRACE_SCOPE("onOrderCompleted");
+
+    // Paid orders teach every screen's upsell panel
+    QStringList names;
+    for (const OrderItem &line : order.lines) {
+        names << line.name;
+    }
+    catalog->upsellIndex().addOrder(names);
+
+    QPair<int, bool> taps = paymentTaps.take(order.id);
+    recordCompletedOrder(taps.first, taps.second);
+
+    if (!fastLane) {
+        showReceipt(order.receiptText);
+        return;
+    }
+
+    if (engine.cartItems().empty()) {
+        ui->cartTextEdit->setPlainText(order.receiptText);
+    }
+    toasts->info(QString("Order #%1 paid: $%2").arg(order.id).arg(order.totals.total, 0, 'f', 2));
+}
+
+/******************************************************************
+ * MainWindow::onOrderDeclined --
+ *   Payment for an order was declined. If the cashier has not
+ *   started another order yet, the declined order is put back in
+ *   the cart so it can be retried; otherwise the message says that
+ *   it was not (the new order is not touched). The order is not
+ *   counted as a completed order.
+ *
+ * Parameters:
+ *   order  - declined order
+ *   reason - message from the payment service
+ *
+ * Modifies:
+ *   - inventory: the order's units are back on sale
+ *   - cart: restored when it is empty (reserving the units again)
+ *   - paymentTaps: the order's taps dropped
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::onOrderDeclined(const PipelineOrder &order, const QString &reason)
+{
+    TRACE_SCOPE("onOrderDeclined");
+
+    paymentTaps.remove(order.id);
+
+    QString message = QString("Payment for order #%1 ($%2) declined: %3")
+                          .arg(order.id)
+                          .arg(order.totals.total, 0, 'f', 2)
+                          .arg(reason);
+
+    // Checkout committed the stock; nothing was sold after all
+    for (const OrderItem &line : order.lines) {
+        engine.inventory()->refund(line.itemId, line.stockUnits);
+    }
+
+    if (engine.cartItems().empty()) {
+        for (const OrderItem &line : order.lines) {
+            engine.addToCart(line.name, line.quantity);
+        }
+        updateCartDisplay();
+        message += " - items returned to the cart.";
+    } else {
+        message += " - a new order was already started, so the items were not returned to the cart."
+                   " Please enter them again.";
+    }
+    toasts->error(message);
+}
+
+/******************************************************************
+ * MainWindow::showReceipt --
+ *   Display a receipt in a non-modal QMessageBox, so the next order
+ *   can be started while it is still open. A new receipt replaces
+ *   the previous window. The receipt text itself is built by
+ *   OrderEngine::buildReceiptText() during checkout.
+ *
+ * Parameters:
+ *   receiptText - formatted receipt
+ *
+ * Modifies:
+ *   - Shows a dialog box with the receipt text
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::showReceipt(const QString &receiptText)
+{
+    TRACE_SCOPE("showReceipt");
+
+    if (!receiptBox) {
+        receiptBox = new QMessageBox(this);
+        receiptBox->setWindowTitle("Order Receipt");
+        receiptBox->setIcon(QMessageBox::Information);
+        receiptBox->setWindowModality(Qt::NonModal);
+    }
+    receiptBox->setText(receiptText);
+    receiptBox->show();
+    receiptBox->raise();
+}
+
+// ========== MANAGER MENU FUNCTIONS ==========
+
+/******************************************************************
+ * MainWindow::updateManagerItemsList --
+ *   Point the manager table at the current menu snapshot. The
+ *   table keeps its sort column, filter and (when the items are
+ *   the same) its selection.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - managerModel: shows the current snapshot
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::updateManagerItemsList()
+{
+    TRACE_SCOPE("updateManagerItemsList");
+
+    ALLOC_SCOPE("manager table refresh");
+    managerModel->setSnapshot(engine.menuSnapshot());
+}
+
+/******************************************************************
+ * MainWindow::selectedManagerItems --
+ *   Names of the items selected in the manager table, in view
+ *   order.
+ *
+ * Parameters: none
+ *
+ * Returns:
+ *   selected item names (empty if nothing is selected)
+ ******************************************************************/
+QStringList MainWindow::selectedManagerItems() const
+{
+    QModelIndexList rows = ui->managerItemsTableView->selectionModel()->selectedRows();
+    std::sort(rows.begin(), rows.end());
+
+    QStringList names;
+    for (const QModelIndex &row : rows) {
+        names << managerModel->itemName(row.row());
+    }
+    return names;
+}
+
+/******************************************************************
+ * MainWindow::on_managerFilterLineEdit_textChanged --
+ *   Slot called on every keystroke in the manager filter box.
+ *
+ * Parameters:
+ *   text - filter text (matches name or category)
+ *
+ * Modifies:
+ *   - managerModel: visible rows
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_managerFilterLineEdit_textChanged(const QString &text)
+{
+    TRACE_SCOPE("on_managerFilterLineEdit_textChanged");
+
+    managerModel->setFilterText(text);
+}
+
+/******************************************************************
+ * MainWindow::onPriceEditRequested --
+ *   Slot for inline price edits in the manager table.
+ *
+ * Parameters:
+ *   name  - item whose price was edited
+ *   price - new price
+ *
+ * Modifies:
+ *   - engine menu, searchIndex, managerModel
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::onPriceEditRequested(const QString &name, double price)
+{
+    FoodItem item;
+    if (!engine.findMenuItem(name, item) || !engine.setItemPrice(name, price)) {
+        return;
+    }
+    item.price = price;
+    catalog->searchIndex().updateItem(item);
+    MenuDelta delta;
+    delta.changed.append(item);
+    catalog->menuEdited(delta);
+    statusBar()->showMessage(QString("%1 now $%2").arg(name).arg(price, 0, 'f', 2), 5000);
+}
+
+/******************************************************************
+ * MainWindow::onStockEditRequested --
+ *   Apply a stock count typed into the manager table.
+ *
+ * Parameters:
+ *   name  - item whose Stock cell was edited
+ *   units - units on hand, or Inventory::UNTRACKED
+ *
+ * Modifies:
+ *   - inventory: the item's counters
+ *   - managerModel: the item's Stock cell
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::onStockEditRequested(const QString &name, int units)
+{
+    FoodItem item;
+    if (!engine.findMenuItem(name, item)) {
+        return;
+    }
+    engine.inventory()->setStock(item.id, units);
+    managerModel->refreshStock(item.id);
+
+    if (units == Inventory::UNTRACKED) {
+        statusBar()->showMessage(QString("%1 no longer counted").arg(name), 5000);
+    } else {
+        statusBar()->showMessage(QString("%1 stock set to %2").arg(name).arg(units), 5000);
+    }
+}
+
+/******************************************************************
+ * MainWindow::onSoldOutChanged --
+ *   Redraw one item after it sold out or came back. Only that row
+ *   of the customer list is replaced; selection and scrolling of
+ *   the other rows are kept.
+ *
+ * Parameters:
+ *   itemId  - MenuStore item ID
+ *   soldOut - new state
+ *
+ * Modifies:
+ *   - itemsListWidget: the item's row, if listed
+ *   - managerModel: the item's Stock cell
+ *   - upsellTimer: started (sold-out items are not suggested)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::onSoldOutChanged(int itemId, bool soldOut)
+{
+    TRACE_SCOPE("onSoldOutChanged");
+
+    managerModel->refreshStock(itemId);
+    upsellTimer->start();
+
+    MenuSnapshotPtr menu = engine.menuSnapshot();
+    const FoodItem *item = nullptr;
+    for (const FoodItem &candidate : menu->items) {
+        if (candidate.id == itemId) {
+            item = &candidate;
+            break;
+        }
+    }
+    if (!item) {
+        return;
+    }
+
+    for (int position = 0; position < ui->itemsListWidget->count(); ++position) {
+        if (ui->itemsListWidget->item(position)->data(Qt::UserRole).toInt() == itemId) {
+            delete ui->itemsListWidget->takeItem(position);
+            addItemToList(*item, position);
+            break;
+        }
+    }
+
+    statusBar()->showMessage(soldOut ? QString("%1 sold out").arg(item->name)
+                                     : QString("%1 back in stock").arg(item->name), 5000);
+}
+
+/******************************************************************
+ * MainWindow::on_managerBackButton_clicked --
  *   Slot for the "Back" button in manager view. Switches back to
  *   customer view and refreshes the menu list in case changes were
  *   made.
@@ -1045,6 +1985,7 @@ void MainWindow::updateManagerItemsList()
 void MainWindow::on_managerBackButton_clicked()
 {
     switchToCustomerView();
+    updateCategoryList(); // Categories may have been added or emptied
     updateItemsList(); // Refresh in case prices or items changed
 }
 
@@ -1055,7 +1996,7 @@ void MainWindow::on_managerBackButton_clicked()
  *
  * Parameters: none
  * Modifies:
- *   - menuItems: appended with new item
+ *   - engine menu: appended with new item
  *
  * Returns: nothing
  ******************************************************************/
@@ -1070,11 +2011,13 @@ void MainWindow::on_addItemButton_clicked()
     double price = QInputDialog::getDouble(this, "Add Item", "Enter price:", 0.00, 0.00, 10000.00, 2, &ok);
     if (!ok) return;
 
-    // Let manager choose which category the new item belongs to
-    QStringList categories;
-    categories << "Main Dishes" << "Side Items" << "Beverages" << "Desserts";
-    QString category = QInputDialog::getItem(this, "Add Item", "Select category:", categories, 0, false, &ok);
-    if (!ok) return;
+    // Let manager choose which category the new item belongs to. The
+    // list comes from the menu data; typing a new name creates a new
+    // category (e.g. a new station).
+    QStringList categories = engine.menuSnapshot()->categories.names();
+    QString category = QInputDialog::getItem(this, "Add Item", "Select or type a category:", categories, 0, true, &ok);
+    category = category.trimmed();
+    if (!ok || category.isEmpty()) return;
 
     // Add item to internal menu; no image is assigned by default
     FoodItem newItem;
@@ -1082,111 +2025,369 @@ void MainWindow::on_addItemButton_clicked()
     newItem.price = price;
     newItem.category = category;
     newItem.imagePath = "";  // No image for manually added items
-    menuItems.append(newItem);
+    engine.addMenuItem(newItem);
+    catalog->searchIndex().addItem(newItem);
+    MenuDelta delta;
+    delta.added.append(newItem);   // Windows find it by name (the store assigns the ID)
+    catalog->menuEdited(delta);
 
-    updateManagerItemsList();
-    QMessageBox::information(this, "Success", "Item added successfully!");
+    toasts->info("Item added successfully!");
 }
 
 /******************************************************************
  * MainWindow::on_removeItemButton_clicked --
- *   Slot for "Remove Item" in manager view. Deletes the selected
- *   item from menuItems after confirmation.
+ *   Slot for "Remove Selected" in manager view. Deletes every
+ *   selected item after one confirmation, as a single menu update
+ *   that is saved at once (like the other bulk operations, however
+ *   many items are selected).
  *
  * Parameters: none
  * Modifies:
- *   - menuItems: one element removed
+ *   - engine menu: selected elements removed
+ *   - menu file: saved once, with any other unsaved edits
  *
  * Returns: nothing
  ******************************************************************/
 void MainWindow::on_removeItemButton_clicked()
 {
-    QListWidgetItem *selectedItem = ui->managerItemsListWidget->currentItem();
-    if (!selectedItem) {
-        QMessageBox::warning(this, "No Selection", "Please select an item to remove.");
+    QStringList names = selectedManagerItems();
+    if (names.isEmpty()) {
+        toasts->warning("Please select an item to remove.");
         return;
     }
 
-    // Parse item name from text "[Category] Name - $Price"
-    QString displayText = selectedItem->text();
-    QString itemName = displayText.split("] ")[1].split(" - ")[0];
-
     // Confirm deletion with the manager
+    QString question = (names.size() == 1)
+                           ? QString("Are you sure you want to remove '%1'?").arg(names[0])
+                           : QString("Are you sure you want to remove these %1 items?").arg(names.size());
     QMessageBox::StandardButton reply;
-    reply = QMessageBox::question(this, "Confirm Deletion",
-                                  QString("Are you sure you want to remove '%1'?").arg(itemName),
+    reply = QMessageBox::question(this, "Confirm Deletion", question + saveNotice(),
                                   QMessageBox::Yes | QMessageBox::No);
 
-    if (reply == QMessageBox::Yes) {
-        // Search menuItems for that name and remove it
-        for (int i = 0; i < menuItems.size(); ++i) {
-            if (menuItems[i].name == itemName) {
-                menuItems.removeAt(i);
-                break;
-            }
-        }
-
-        updateManagerItemsList();
-        QMessageBox::information(this, "Success", "Item removed successfully!");
+    if (reply != QMessageBox::Yes) {
+        return;
     }
+
+    applyBulkDelta(engine.removalDelta(names));
 }
 
 /******************************************************************
  * MainWindow::on_editPriceButton_clicked --
  *   Slot for "Edit Price" in manager view. Prompts for a new price
- *   for the selected item and updates menuItems.
+ *   for the selected item and updates the menu.
  *
  * Parameters: none
  * Modifies:
- *   - menuItems: price of one item changed
+ *   - engine menu: price of one item changed
  *
  * Returns: nothing
  ******************************************************************/
 void MainWindow::on_editPriceButton_clicked()
 {
-    QListWidgetItem *selectedItem = ui->managerItemsListWidget->currentItem();
-    if (!selectedItem) {
-        QMessageBox::warning(this, "No Selection", "Please select an item to edit.");
+    QModelIndex current = ui->managerItemsTableView->currentIndex();
+    if (!current.isValid()) {
+        toasts->warning("Please select an item to edit.");
         return;
     }
 
-    // Parse item name from "[Category] Name - $price"
-    QString displayText = selectedItem->text();
-    QString itemName = displayText.split("] ")[1].split(" - ")[0];
+    QString itemName = managerModel->itemName(current.row());
 
-    // Find the item in menuItems and ask for a new price
-    for (FoodItem &item : menuItems) {
-        if (item.name == itemName) {
-            bool ok;
-            double newPrice = QInputDialog::getDouble(this, "Edit Price",
-                                                      QString("Enter new price for %1:").arg(itemName),
-                                                      item.price, 0.00, 10000.00, 2, &ok);
+    // Find the item on the menu and ask for a new price
+    FoodItem item;
+    if (!engine.findMenuItem(itemName, item)) {
+        return;
+    }
 
-            if (ok) {
-                item.price = newPrice;
-                updateManagerItemsList();
-                QMessageBox::information(this, "Success", "Price updated successfully!");
-            }
-            return;
-        }
+    bool ok;
+    double newPrice = QInputDialog::getDouble(this, "Edit Price",
+                                              QString("Enter new price for %1:").arg(itemName),
+                                              item.price, 0.00, 10000.00, 2, &ok);
+
+    if (ok) {
+        engine.setItemPrice(itemName, newPrice);
+        item.price = newPrice;
+        catalog->searchIndex().updateItem(item);
+        MenuDelta delta;
+        delta.changed.append(item);
+        catalog->menuEdited(delta);
+        toasts->info("Price updated successfully!");
     }
 }
 
 /******************************************************************
  * MainWindow::on_saveChangesButton_clicked --
  *   Slot for "Save Changes" in manager view. Writes the current
- *   menuItems vector to the menu file.
+ *   menu to the menu file.
  *
  * Parameters: none
  * Modifies:
- *   - MENU_FILE: overwritten
+ *   - menu file: overwritten
  *
  * Returns: nothing
  ******************************************************************/
 void MainWindow::on_saveChangesButton_clicked()
 {
     saveMenuItems();
-    QMessageBox::information(this, "Success", "All changes saved to file!");
+    toasts->info("All changes saved to file!");
+}
+
+// ========== BULK MANAGER OPERATIONS ==========
+
+/******************************************************************
+ * MainWindow::on_importPriceSheetButton_clicked --
+ *   Slot for "Import Price Sheet". Reads a CSV delta
+ *   (name,price[,category[,imagePath[,availability]]]), shows what
+ *   it will change and applies it as one batch.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - engine menu: prices changed, items added
+ *   - menu file: saved once
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_importPriceSheetButton_clicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Import Price Sheet", QString(),
+                                                    "CSV files (*.csv *.txt);;All files (*)");
+    if (fileName.isEmpty()) return;
+
+    QVector<FoodItem> rows;
+    if (!OrderEngine::readPriceSheet(fileName, rows)) {
+        toasts->error(QString("Import failed: could not open %1.").arg(fileName));
+        return;
+    }
+
+    MenuDelta delta = engine.priceSheetDelta(rows);
+    if (delta.isEmpty()) {
+        toasts->info("The price sheet matches the current menu.");
+        return;
+    }
+
+    QMessageBox::StandardButton reply;
+    reply = QMessageBox::question(this, "Confirm Import",
+                                  QString("Read %1 rows: %2 price/category changes and %3 new items. Apply?")
+                                      .arg(rows.size())
+                                      .arg(delta.changed.size())
+                                      .arg(delta.added.size())
+                                      + saveNotice(),
+                                  QMessageBox::Yes | QMessageBox::No);
+    if (reply == QMessageBox::Yes) {
+        applyBulkDelta(delta);
+    }
+}
+
+/******************************************************************
+ * MainWindow::on_categoryIncreaseButton_clicked --
+ *   Slot for "Category Price Change". Scales every price in one
+ *   category by a percentage, as one batch.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - engine menu: prices in the category changed
+ *   - menu file: saved once
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_categoryIncreaseButton_clicked()
+{
+    bool ok;
+    QStringList categories = engine.menuSnapshot()->categories.names();
+    QString category = QInputDialog::getItem(this, "Category Price Change", "Select category:",
+                                             categories, 0, false, &ok);
+    if (!ok || category.isEmpty()) return;
+
+    double percent = QInputDialog::getDouble(this, "Category Price Change",
+                                             QString("Percent change for %1 (e.g. 5 or -10):").arg(category),
+                                             5.0, -90.0, 500.0, 2, &ok);
+    if (!ok) return;
+
+    applyBulkDelta(engine.categoryPriceDelta(category, percent));
+}
+
+/******************************************************************
+ * MainWindow::on_exportMenuButton_clicked --
+ *   Slot for "Export Menu". Writes the whole menu as CSV in the
+ *   price sheet format, so it can be edited and imported again.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - chosen file: overwritten
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_exportMenuButton_clicked()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, "Export Menu", "menu_export.csv",
+                                                    "CSV files (*.csv);;All files (*)");
+    if (fileName.isEmpty()) return;
+
+    if (engine.saveMenuItems(fileName)) {
+        statusBar()->showMessage(QString("Menu exported to %1").arg(fileName), 5000);
+    } else {
+        toasts->error(QString("Export failed: could not write %1.").arg(fileName));
+    }
+}
+
+/******************************************************************
+ * MainWindow::on_memoryReportButton_clicked --
+ *   Slot for "Memory Report". Shows heap allocations per
+ *   instrumented operation (category switch, add to cart,
+ *   checkout, save, ...). The manager can reset the table to
+ *   measure a specific sequence of actions.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - allocation table: cleared if the manager chooses Reset
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::on_memoryReportButton_clicked()
+{
+    QMessageBox reportBox(this);
+    reportBox.setWindowTitle("Memory Report");
+    reportBox.setText(AllocTracker::report());
+    reportBox.setStyleSheet("QLabel { font-family: 'Courier New', monospace; }");
+    QPushButton *resetButton = nullptr;
+    if (AllocTracker::isEnabled()) {
+        resetButton = reportBox.addButton("Reset", QMessageBox::ResetRole);
+    }
+    reportBox.addButton(QMessageBox::Close);
+    reportBox.exec();
+
+    if (resetButton && reportBox.clickedButton() == resetButton) {
+        AllocTracker::reset();
+        statusBar()->showMessage("Allocation counters reset", 5000);
+    }
+}
+
+/******************************************************************
+ * MainWindow::saveNotice --
+ *   Bulk operations save the menu file, which also writes every
+ *   unsaved edit (made on any screen). Confirmations append this
+ *   line so the manager knows before saying yes.
+ *
+ * Returns:
+ *   the notice, or an empty string when nothing else is pending
+ ******************************************************************/
+QString MainWindow::saveNotice() const
+{
+    if (!catalog->hasUnsavedEdits()) {
+        return QString();
+    }
+    return "\n\nThe menu file will be saved, including unsaved changes made so far on any screen.";
+}
+
+/******************************************************************
+ * MainWindow::applyBulkDelta --
+ *   Finish a bulk manager operation: one menu update and one write
+ *   of the menu file, however many items the delta touches. The
+ *   lists of every screen, this one included, are patched from the
+ *   delta by onMenuChanged().
+ *
+ * Parameters:
+ *   delta - the batch to apply
+ *
+ * Modifies:
+ *   - shared menu and search index (every screen refreshes)
+ *   - menu file: overwritten
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::applyBulkDelta(const MenuDelta &delta)
+{
+    TRACE_SCOPE("applyBulkDelta");
+
+    if (delta.isEmpty()) {
+        statusBar()->showMessage("Nothing to change", 5000);
+        return;
+    }
+
+    catalog->applyMenuDelta(delta);
+    saveMenuItems();
+
+    statusBar()->showMessage(QString("Saved: %1 changed, %2 added, %3 removed")
+                                 .arg(delta.changed.size())
+                                 .arg(delta.added.size())
+                                 .arg(delta.removed.size()),
+                             5000);
 }
 
+// ========== HOT RELOAD ==========
+
+/******************************************************************
+ * MainWindow::onMenuChanged --
+ *   Slot called when the shared menu changed: the menu file was
+ *   reloaded (the catalog has applied the delta) or a manager edit
+ *   on any screen. Only the rows of the items in the delta are
+ *   touched, in one paint; the customer's selection follows its
+ *   item (cleared if the item left the list) and the scroll
+ *   position is kept.
+ *
+ * Parameters:
+ *   delta - items added, removed and changed
+ *
+ * Modifies:
+ *   - categoryComboBox, itemsListWidget, managerModel
+ *   - upsellTimer: started (names, prices or categories may differ)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MainWindow::onMenuChanged(const MenuDelta &delta)
+{
+    TRACE_SCOPE("onMenuChanged");
+
+    upsellTimer->start();
+
+    // The manager table matches its rows by item ID and keeps its own
+    // sort, filter and selection
+    updateManagerItemsList();
+
+    // Patch the customer list in one paint, keeping the customer's place
+    QListWidget *list = ui->itemsListWidget;
+    QListWidgetItem *current = list->currentItem();
+    int selectedId = current ? current->data(Qt::UserRole).toInt() : -1;
+    int scroll = list->verticalScrollBar()->value();
+
+    list->setUpdatesEnabled(false);
+    updateCategoryList();
+    if (delta.isEmpty()) {
+        updateItemsList();   // Nothing to go by
+    } else {
+        patchItemsList(delta);
+    }
+
+    QListWidgetItem *selected = nullptr;
+    for (int position = 0; selectedId >= 0 && position < list->count(); ++position) {
+        if (list->item(position)->data(Qt::UserRole).toInt() == selectedId) {
+            selected = list->item(position);
+            break;
+        }
+    }
+    if (selected && (selected->flags() & Qt::ItemIsSelectable)) {
+        list->setCurrentItem(selected);
+    } else {
+        list->clearSelection();
+        list->setCurrentItem(nullptr);   // Removed or sold out
+    }
+    list->verticalScrollBar()->setValue(scroll);
+    list->setUpdatesEnabled(true);
+
+    if (!delta.isEmpty()) {
+        statusBar()->showMessage(QString("Menu updated: %1 changed, %2 added, %3 removed")
+                                     .arg(delta.changed.size())
+                                     .arg(delta.added.size())
+                                     .arg(delta.removed.size()),
+                                 5000);
+    }
+}
 
+/******************************************************************
+ * MainWindow::onCouponsChanged --
+ *   Slot called when the coupon file changed on disk. The shared
+ *   table has already been replaced by the catalog.
+ ******************************************************************/
+void MainWindow::onCouponsChanged()
+{
+    statusBar()->showMessage("Coupons updated", 5000);
+}
@@ -2,8 +2,8 @@
  * mainwindow.h
  *
  * This header file declares the MainWindow class, which controls
- * the main GUI for the cafeteria ordering system. It also defines
- * simple data structures for menu items and order items.
+ * the main GUI for the cafeteria ordering system. The ordering
+ * logic itself lives in OrderEngine (orderengine.h).
  *
  ******************************************************************/
 
@@ -11,58 +11,35 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
-#include <QMap>
+#include <QHash>
 #include <QString>
-#include <QVector>
 #include <QKeyEvent>
+#include <QLabel>
+#include <QListWidgetItem>
+#include <QMessageBox>
+#include <QPointer>
+#include <QTimer>
+#include "orderengine.h"
+#include "sharedcatalog.h"
+#include "menutablemodel.h"
+#include "toast.h"
+#include "payment.h"
+#include "checkoutpipeline.h"
+#include "sessionjournal.h"
 
 QT_BEGIN_NAMESPACE
 // Forward declaration of the auto-generated UI class from Qt Designer
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
-/******************************************************************
- * FoodItem
- *
- * Simple struct used to store information about a single item
- * on the cafeteria menu.
- *
- * Members:
- *   name      - name of the item (e.g., "Cheese Burger")
- *   price     - price of the item in dollars
- *   category  - menu category (e.g., "Main Dishes", "Beverages")
- *   imagePath - resource path for the item's icon image
- ******************************************************************/
-struct FoodItem {
-    QString name;
-    double price;
-    QString category;
-    QString imagePath;
-};
-
-/******************************************************************
- * OrderItem
- *
- * Struct used to store items that the customer has added to
- * their cart during the ordering process.
- *
- * Members:
- *   name      - name of the item
- *   price     - price of one unit of the item
- *   quantity  - how many of this item are in the cart
- ******************************************************************/
-struct OrderItem {
-    QString name;
-    double price;
-    int quantity;
-};
-
 /******************************************************************
  * MainWindow
  *
  * The MainWindow class is the main GUI window for the program.
  * It displays the customer menu, handles the shopping cart, and
  * provides a hidden manager-only interface for editing menu data.
+ * Several windows (one per screen) may share one SharedCatalog;
+ * each has its own cart, checkout pipeline and session journal.
  ******************************************************************/
 class MainWindow : public QMainWindow
 {
@@ -72,13 +49,17 @@ public:
     /**************************************************************
      * Constructor / Destructor
      *
-     * MainWindow(QWidget *parent = 0)
-     *   - Creates and initializes the main window.
+     * MainWindow(catalog, screen, parent)
+     *   - Creates and initializes the window for one screen.
+     *   - catalog: shared menu, stock, coupons and icons (must be
+     *     loaded and outlive the window)
+     *   - screen: 0 for the first screen; later screens use their
+     *     own order log, receipt directory and session file
      *
      * ~MainWindow()
      *   - Cleans up any dynamically allocated resources.
      **************************************************************/
-    MainWindow(QWidget *parent = 0);
+    explicit MainWindow(SharedCatalog *catalog, int screen = 0, QWidget *parent = nullptr);
     ~MainWindow();
 
 protected:
@@ -89,9 +70,17 @@ protected:
      *
      * eventFilter --
      *   Global event filter used to watch for the secret key
-     *   pattern ("6677") while the customer view is active.
+     *   pattern ("6677") while the customer view is active. It
+     *   also counts the taps (clicks and key presses) spent on
+     *   each customer order and feeds PLU keypad entry.
+     *
+     * closeEvent --
+     *   Gives the cart's stock back, so a closed screen does not
+     *   keep units from the other screens. The journaled cart is
+     *   kept and comes back on the next start.
      **************************************************************/
     void keyPressEvent(QKeyEvent *event) override;
+    void closeEvent(QCloseEvent *event) override;
     bool eventFilter(QObject *obj, QEvent *event) override;
 
 private slots:
@@ -117,6 +106,19 @@ private slots:
      **********************************************************/
     void on_categoryComboBox_currentIndexChanged(int index);
 
+    /**********************************************************
+     * on_searchLineEdit_textChanged(const QString &text)
+     *
+     * Triggered when:
+     *   - The user types in the search box above the item list.
+     *
+     * Purpose:
+     *   - Calls updateItemsList() so the list shows the items
+     *     whose names best match the typed text, from every
+     *     category (typos are tolerated).
+     **********************************************************/
+    void on_searchLineEdit_textChanged(const QString &text);
+
     /**********************************************************
      * on_addToCartButton_clicked()
      *
@@ -132,6 +134,18 @@ private slots:
      **********************************************************/
     void on_addToCartButton_clicked();
 
+    /**********************************************************
+     * on_upsellListWidget_itemClicked(QListWidgetItem *item)
+     *
+     * Triggered when:
+     *   - The user taps a suggestion in the "Goes well with
+     *     your order" list under the cart.
+     *
+     * Purpose:
+     *   - Adds one of that item to the cart.
+     **********************************************************/
+    void on_upsellListWidget_itemClicked(QListWidgetItem *item);
+
     /**********************************************************
      * on_checkoutButton_clicked()
      *
@@ -139,10 +153,11 @@ private slots:
      *   - The user clicks the "Checkout" button.
      *
      * Purpose:
-     *   - Calculates subtotal, applies any valid coupon, adds tax,
-     *     and computes the final total.
-     *   - Calls showReceipt(...) to display a formatted receipt.
-     *   - Clears the cart after checkout is complete.
+     *   - Asks for a coupon and submits the cart to the
+     *     checkout pipeline (coupon check, pricing, payment,
+     *     order log, receipt spool).
+     *   - The cart is cleared at once; the receipt is shown
+     *     when the payment is approved.
      **********************************************************/
     void on_checkoutButton_clicked();
 
@@ -153,12 +168,70 @@ private slots:
      *   - The user clicks the "Clear Cart" button.
      *
      * Purpose:
-     *   - Asks the user for confirmation.
+     *   - Asks the user for confirmation (not in fast lane mode).
      *   - If confirmed, removes all items from the cart and
      *     calls updateCartDisplay() to show an empty cart.
      **********************************************************/
     void on_clearCartButton_clicked();
 
+    /**********************************************************
+     * on_fastLaneCheckBox_toggled(bool checked)
+     *
+     * Triggered when:
+     *   - The manager switches "Fast Lane" on or off.
+     *
+     * Purpose:
+     *   - In fast lane mode checkout skips the coupon prompt,
+     *     clearing the cart skips its confirmation and the
+     *     receipt is shown in the cart box (if no new order has
+     *     been started) instead of a window.
+     **********************************************************/
+    void on_fastLaneCheckBox_toggled(bool checked);
+
+    /**************************************************************
+     * CHECKOUT PIPELINE SLOTS
+     *
+     * Connected to CheckoutPipeline in the constructor. They run
+     * after on_checkoutButton_clicked() has returned, while the
+     * next customer may already be ordering.
+     **************************************************************/
+
+    /**********************************************************
+     * onCouponRejected(quint64 orderId, const QString &code)
+     *   - Warns that the coupon was not applied.
+     *
+     * onCheckoutStageChanged(quint64 orderId, Stage stage)
+     *   - Updates the "orders in progress" status indicator.
+     *
+     * onOrderCompleted(const PipelineOrder &order)
+     *   - Payment approved and receipt spooled: books the
+     *     order's taps and shows the receipt.
+     *
+     * onOrderDeclined(const PipelineOrder &order, reason)
+     *   - Shows the reason and restores the cart if possible
+     *     (or says that it could not).
+     **********************************************************/
+    void onCouponRejected(quint64 orderId, const QString &code);
+    void onCheckoutStageChanged(quint64 orderId, CheckoutPipeline::Stage stage);
+    void onOrderCompleted(const PipelineOrder &order);
+    void onOrderDeclined(const PipelineOrder &order, const QString &reason);
+
+    /**************************************************************
+     * onAvailabilityTimeout()
+     *   - Fired by availabilityTimer at a schedule switchover
+     *     (e.g. breakfast ends at 10:30). Adds and removes only
+     *     the rows whose availability changed.
+     **************************************************************/
+    void onAvailabilityTimeout();
+
+    /**************************************************************
+     * onUpsellTimeout()
+     *   - Fired by upsellTimer once the cart, menu or stock has
+     *     changed. Fills the upsell list from the catalog's
+     *     UpsellIndex.
+     **************************************************************/
+    void onUpsellTimeout();
+
     /**************************************************************
      * MANAGER VIEW SLOTS
      *
@@ -202,14 +275,15 @@ private slots:
      * on_removeItemButton_clicked()
      *
      * Triggered when:
-     *   - The manager selects an item in the manager list and
-     *     clicks the "Remove Item" button.
+     *   - The manager selects one or more items in the manager
+     *     list and clicks the "Remove Selected" button.
      *
      * Purpose:
-     *   - Finds the selected item by its name.
-     *   - Asks the manager to confirm deletion.
-     *   - If confirmed, removes that FoodItem from menuItems.
-     *   - Calls updateManagerItemsList() to refresh the list.
+     *   - Asks the manager to confirm deletion once.
+     *   - If confirmed, removes the selected items from the menu
+     *     as one batch with one refresh and one save, however
+     *     many items are selected. The confirmation says when
+     *     the save also writes other unsaved edits.
      **********************************************************/
     void on_removeItemButton_clicked();
 
@@ -242,6 +316,118 @@ private slots:
      **********************************************************/
     void on_saveChangesButton_clicked();
 
+    /**********************************************************
+     * on_importPriceSheetButton_clicked()
+     * on_categoryIncreaseButton_clicked()
+     * on_exportMenuButton_clicked()
+     *
+     * Triggered when:
+     *   - The manager clicks the matching bulk operation button.
+     *
+     * Purpose:
+     *   - Import: applies a CSV price sheet (changed prices and
+     *     new items) in one batch.
+     *   - Category price change: scales every price in one
+     *     category by a percentage in one batch.
+     *   - Export: writes the menu as a CSV price sheet.
+     *   - Batches are applied with applyBulkDelta(): one menu
+     *     update, one list refresh, one file write.
+     **********************************************************/
+    void on_importPriceSheetButton_clicked();
+    void on_categoryIncreaseButton_clicked();
+    void on_exportMenuButton_clicked();
+
+    /**********************************************************
+     * on_memoryReportButton_clicked()
+     *
+     * Triggered when:
+     *   - The manager clicks the "Memory Report" button.
+     *
+     * Purpose:
+     *   - Shows heap allocations, bytes and peak RSS per
+     *     instrumented operation (needs CAFETERIA_ALLOC_TRACK=1).
+     **********************************************************/
+    void on_memoryReportButton_clicked();
+
+    /**********************************************************
+     * on_managerFilterLineEdit_textChanged(const QString &text)
+     *
+     * Triggered when:
+     *   - The manager types in the filter box above the table.
+     *
+     * Purpose:
+     *   - Shows only items whose name or category contains the
+     *     text.
+     **********************************************************/
+    void on_managerFilterLineEdit_textChanged(const QString &text);
+
+    /**********************************************************
+     * onPriceEditRequested(const QString &name, double price)
+     *
+     * Triggered when:
+     *   - The manager edits a price directly in the table.
+     *
+     * Purpose:
+     *   - Updates the price through the engine and refreshes
+     *     the table (sort and selection are kept).
+     **********************************************************/
+    void onPriceEditRequested(const QString &name, double price);
+
+    /**********************************************************
+     * onStockEditRequested(const QString &name, int units)
+     *
+     * Triggered when:
+     *   - The manager types a stock count in the table.
+     *
+     * Purpose:
+     *   - Sets the units on hand (negative: stop tracking).
+     **********************************************************/
+    void onStockEditRequested(const QString &name, int units);
+
+    /**********************************************************
+     * onSoldOutChanged(int itemId, bool soldOut)
+     *
+     * Triggered when:
+     *   - An item sells out or comes back in stock, on this or
+     *     any other terminal sharing the inventory.
+     *
+     * Purpose:
+     *   - Updates that item's row in the customer list and
+     *     the manager table without rebuilding either.
+     **********************************************************/
+    void onSoldOutChanged(int itemId, bool soldOut);
+
+    /**************************************************************
+     * SHARED CATALOG SLOTS
+     *
+     * Connected to SharedCatalog in the constructor.
+     **************************************************************/
+
+    /**********************************************************
+     * onMenuChanged(const MenuDelta &delta)
+     *
+     * Triggered when:
+     *   - The menu file was changed by another program (e.g. a
+     *     price file pushed by head office), or
+     *   - any window's manager view changed the menu.
+     *
+     * Purpose:
+     *   - Patches the rows of the added, removed and changed
+     *     items in both lists (no restart, no full reload).
+     **********************************************************/
+    void onMenuChanged(const MenuDelta &delta);
+
+    /**********************************************************
+     * onCouponsChanged()
+     *
+     * Triggered when:
+     *   - The coupon file was changed by another program.
+     *
+     * Purpose:
+     *   - Tells the cashier; the shared table is already new.
+     **********************************************************/
+    void onCouponsChanged();
+
 private:
     // Pointer to the auto-generated UI object (from Qt Designer)
     Ui::MainWindow *ui;
@@ -249,9 +435,64 @@ private:
     /**************************************************************
      * Data structures for the application
      **************************************************************/
-    QVector<FoodItem> menuItems;   // All food items available
-    QVector<OrderItem> cart;       // Items currently in customer's cart
-    QMap<QString, double> coupons; // Coupon codes mapped to discount % (0.10 = 10%)
+    SharedCatalog *catalog;        // Menu, stock, coupons, icons (shared)
+    const int screen;              // 0 = first screen
+    OrderEngine engine;            // This screen's cart (on the shared catalog)
+    MenuTableModel *managerModel = nullptr;  // Manager item table
+    ToastNotifier *toasts = nullptr;         // Non-modal notifications
+    QPointer<QMessageBox> receiptBox;        // Last receipt window (non-modal)
+    MockPaymentService *paymentService = nullptr;   // Payment authorization
+    CheckoutPipeline *checkoutPipeline = nullptr;   // Async checkout stages
+    QLabel *checkoutStatusLabel = nullptr;          // Orders in progress
+    SessionJournal journal;                         // This screen's cart, survives crashes
+
+    /**************************************************************
+     * Cashier throughput
+     *
+     * fastLane  - skip confirmations and prompts (see
+     *             on_fastLaneCheckBox_toggled); also enabled by the
+     *             CAFETERIA_FAST_LANE environment variable.
+     * orderTaps - clicks and key presses since the last checkout
+     *             (customer view only).
+     * paymentTaps - orders waiting for payment -> their taps and
+     *             mode; booked once paid, dropped when declined.
+     **************************************************************/
+    bool fastLane = false;
+    int orderTaps = 0;
+    QHash<quint64, QPair<int, bool>> paymentTaps;
+
+    /**************************************************************
+     * PLU keypad entry
+     *
+     * pluEntry - keys typed so far, e.g. "2*10"; codes are looked
+     *            up in the catalog's PluIndex
+     **************************************************************/
+    QString pluEntry;
+
+    /**************************************************************
+     * Time-of-day availability (see availability.h)
+     *
+     * availabilityTimer - single shot, armed for the next
+     *                     switchover of the shown menu version
+     * shownVersion      - menu version the customer list shows
+     * shownSegment      - availability segment it was filtered for
+     **************************************************************/
+    static const int MAX_AVAILABILITY_WAIT_MS = 10 * 60 * 1000;   // Catches clock changes
+    QTimer *availabilityTimer = nullptr;
+    quint64 shownVersion = 0;
+    int shownSegment = -1;
+
+    /**************************************************************
+     * Upsell panel (see upsellindex.h)
+     *
+     * upsellTimer - single shot, 0 ms: suggestions are refreshed
+     *               after the slot that changed the cart has
+     *               returned, so adding to the cart never waits
+     *               for them (and several changes in one slot
+     *               cause one refresh)
+     **************************************************************/
+    static const int UPSELL_COUNT = 3;   // Suggestions shown at most
+    QTimer *upsellTimer = nullptr;
 
     /**************************************************************
      * Manager access and security settings
@@ -261,42 +502,90 @@ private:
     const QString MANAGER_PASSWORD = "admin123";  // Simple manager password
 
     /**************************************************************
-     * File paths used to store persistent data
-     **************************************************************/
-    const QString MENU_FILE   = "menu_items.txt";  // Menu items file
-    const QString COUPON_FILE = "coupons.txt";     // Coupon codes file
-
-    /**************************************************************
-     * Tax rate (5% for British Columbia food tax)
+     * File paths used to store persistent data. These are the
+     * first screen's names; see screenFile(). The menu and coupon
+     * files belong to SharedCatalog.
      **************************************************************/
-    const double TAX_RATE = 0.05;
+    const QString ORDER_LOG_FILE = "orders.csv";   // One line per paid order
+    const QString RECEIPT_SPOOL_DIR = "receipts";  // One file per receipt
+    const QString SESSION_FILE = "session_state.bin";  // Live session (see sessionjournal.h)
 
     /**************************************************************
      * Helper functions (internal use only)
      *
-     * loadMenuItems()        - reads menu data from MENU_FILE or
-     *                          creates defaults if the file is missing.
-     * loadCoupons()          - reads coupon codes and discount values.
-     * saveMenuItems()        - writes the current menu to MENU_FILE.
+     * screenFile()           - a file name for this screen
+     *                          ("orders.csv" -> "orders_2.csv").
+     * screenTitle()          - a window title with this screen's
+     *                          number (none on the first screen).
+     * ownsEvent()            - whether an event is for this window
+     *                          or one of its dialogs.
+     * saveMenuItems()        - writes the shared menu to the menu
+     *                          file.
+     * restoreSession()       - puts back the cart recorded in this
+     *                          screen's session file.
      * updateItemsList()      - refreshes the list of items shown for
-     *                          the selected category.
+     *                          the search text or selected category.
+     * patchItemsList()       - updates only the rows of a menu
+     *                          delta's items in that list.
+     * addItemToList()        - appends (or inserts) one item row in
+     *                          the customer list.
+     * listedRows()           - snapshot rows for the search text or
+     *                          category, before the availability
+     *                          filter, in list order.
+     * currentSegment()       - availability segment for the time now.
+     * scheduleAvailabilityCheck() - arms availabilityTimer.
+     * updateCategoryList()   - refills the category combo box from
+     *                          the menu's category registry.
      * updateCartDisplay()    - refreshes the shopping cart text box.
-     * updateManagerItemsList()- refreshes the list of items in the
-     *                          manager view.
+     * updateManagerItemsList()- shows the current menu in the
+     *                          manager table.
+     * selectedManagerItems() - names of the selected table rows.
      * switchToCustomerView() - shows the customer-facing interface.
      * switchToManagerView()  - shows the manager-only interface.
      * showReceipt()       - builds and displays a text receipt after
      *                          checkout.
+     * applyBulkDelta()       - applies a MenuDelta through the
+     *                          catalog, plus one save.
+     * saveNotice()           - confirmation text warning that the
+     *                          save includes unsaved edits.
+     * addFailureReason()     - why addToCart() refused an item
+     *                          that is on the menu (stock), or
+     *                          empty.
+     * countTap()             - adds one input event to orderTaps.
+     * handlePluKey()         - applies one key to pluEntry; false
+     *                          if the key is not for PLU entry.
+     * commitPluEntry()       - adds the item for pluEntry to the
+     *                          cart.
+     * updatePluEntryLabel()  - shows pluEntry and the last key time.
+     * recordCompletedOrder() - books the taps of a paid order and
+     *                          shows the taps per order.
      **************************************************************/
-    void loadMenuItems();
-    void loadCoupons();
+    QString screenFile(const QString &name) const;
+    QString screenTitle(const QString &title) const;
+    bool ownsEvent(QObject *obj) const;
     void saveMenuItems();
+    void restoreSession();
     void updateItemsList();
+    void patchItemsList(const MenuDelta &delta);
+    void addItemToList(const FoodItem &item, int position = -1);
+    QVector<int> listedRows(const MenuSnapshotPtr &menu);
+    static int currentSegment(const MenuSnapshotPtr &menu);
+    void scheduleAvailabilityCheck(const MenuSnapshotPtr &menu);
+    void updateCategoryList();
     void updateCartDisplay();
     void updateManagerItemsList();
+    QStringList selectedManagerItems() const;
     void switchToCustomerView();
     void switchToManagerView();
-    void showReceipt(double subtotal, double discount, double tax, double total, QString couponCode);
+    void showReceipt(const QString &receiptText);
+    void applyBulkDelta(const MenuDelta &delta);
+    QString saveNotice() const;
+    QString addFailureReason(const QString &itemName, int quantity) const;
+    void countTap(QObject *obj, QEvent *event);
+    bool handlePluKey(QKeyEvent *keyEvent);
+    void commitPluEntry();
+    void updatePluEntryLabel(qint64 keyNs);
+    void recordCompletedOrder(int taps, bool fastLaneOrder);
 };
 
 #endif // MAINWINDOW_H
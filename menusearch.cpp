@@ -0,0 +1,324 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * menusearch.cpp
+ *
+ * This file implements MenuSearchIndex: n-gram indexing of item
+ * names and typo-tolerant ranked search.
+ *
+ ******************************************************************/
+
+#include "menusearch.h"
+#include <QStringList>
+#include <algorithm>
+using namespace std;
+
+namespace {
+
+/******************************************************************
+ * gramKey --
+ *   Pack up to three UTF-16 code units into one hash key. Bigrams
+ *   pass a null third character.
+ ******************************************************************/
+quint64 gramKey(QChar a, QChar b, QChar c)
+{
+    return (quint64(a.unicode()) << 32) | (quint64(b.unicode()) << 16) | quint64(c.unicode());
+}
+
+/******************************************************************
+ * SearchHit
+ *
+ * Candidate document and its ranking score.
+ ******************************************************************/
+struct SearchHit {
+    int doc;
+    double score;
+};
+
+} // namespace
+
+// ========== NORMALIZATION ==========
+
+/******************************************************************
+ * MenuSearchIndex::normalize --
+ *   Normalize text for indexing and querying: lower case, anything
+ *   that is not a letter or digit becomes a space, and runs of
+ *   spaces collapse to one.
+ *
+ * Parameters:
+ *   text - item name or query
+ *
+ * Returns:
+ *   normalized text (may be empty)
+ ******************************************************************/
+QString MenuSearchIndex::normalize(const QString &text)
+{
+    QString result = text.toLower();
+    for (QChar &ch : result) {
+        if (!ch.isLetterOrNumber()) {
+            ch = QChar(' ');
+        }
+    }
+    return result.simplified();
+}
+
+/******************************************************************
+ * MenuSearchIndex::gramsFor --
+ *   Split normalized text into words and produce each word's
+ *   leading bigram plus its trigrams with a leading boundary space.
+ *   "tea" -> " t", " te", "tea".
+ *
+ * Parameters:
+ *   normalized - output of normalize()
+ *
+ * Returns:
+ *   sorted, de-duplicated gram keys
+ ******************************************************************/
+QVector<quint64> MenuSearchIndex::gramsFor(const QString &normalized)
+{
+    QVector<quint64> grams;
+    if (normalized.isEmpty()) {
+        return grams;
+    }
+
+    const QStringList words = normalized.split(' ');
+    for (const QString &word : words) {
+        if (word.isEmpty()) {
+            continue;
+        }
+        grams.append(gramKey(QChar(' '), word[0], QChar()));
+
+        QString padded = " " + word;
+        for (int i = 0; i + 2 < padded.size(); ++i) {
+            grams.append(gramKey(padded[i], padded[i + 1], padded[i + 2]));
+        }
+    }
+
+    sort(grams.begin(), grams.end());
+    grams.erase(unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+// ========== INDEX MAINTENANCE ==========
+
+/******************************************************************
+ * MenuSearchIndex::rebuild --
+ *   Throw away the index and index every given item.
+ *
+ * Parameters:
+ *   items - full menu
+ *
+ * Modifies:
+ *   - all index data
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MenuSearchIndex::rebuild(const QVector<FoodItem> &items)
+{
+    docs.clear();
+    docKeys.clear();
+    freeDocs.clear();
+    docByName.clear();
+    postings.clear();
+
+    docs.reserve(items.size());
+    docKeys.reserve(items.size());
+    docByName.reserve(items.size());
+    for (const FoodItem &item : items) {
+        addItem(item);
+    }
+}
+
+/******************************************************************
+ * MenuSearchIndex::addItem --
+ *   Index one item. If an item with the same name is already
+ *   indexed it is replaced.
+ *
+ * Parameters:
+ *   item - item to index
+ *
+ * Modifies:
+ *   - docs, docKeys, docByName, postings
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MenuSearchIndex::addItem(const FoodItem &item)
+{
+    removeItem(item.name);
+
+    int doc;
+    if (!freeDocs.isEmpty()) {
+        doc = freeDocs.takeLast();
+        docs[doc] = item;
+        docKeys[doc] = normalize(item.name);
+    } else {
+        doc = docs.size();
+        docs.append(item);
+        docKeys.append(normalize(item.name));
+    }
+    docByName.insert(item.name, doc);
+
+    const QVector<quint64> grams = gramsFor(docKeys[doc]);
+    for (quint64 gram : grams) {
+        postings[gram].append(doc);
+    }
+}
+
+/******************************************************************
+ * MenuSearchIndex::removeItem --
+ *   Drop an item from the index. Its doc id is reused later.
+ *
+ * Parameters:
+ *   name - exact item name
+ *
+ * Modifies:
+ *   - docByName, postings, freeDocs
+ *
+ * Returns:
+ *   true if the item was indexed
+ ******************************************************************/
+bool MenuSearchIndex::removeItem(const QString &name)
+{
+    auto found = docByName.find(name);
+    if (found == docByName.end()) {
+        return false;
+    }
+    int doc = found.value();
+    docByName.erase(found);
+
+    // Posting order does not matter, so swap-remove
+    const QVector<quint64> grams = gramsFor(docKeys[doc]);
+    for (quint64 gram : grams) {
+        auto posting = postings.find(gram);
+        if (posting == postings.end()) {
+            continue;
+        }
+        QVector<int> &list = posting.value();
+        int pos = list.indexOf(doc);
+        if (pos >= 0) {
+            list[pos] = list.last();
+            list.removeLast();
+        }
+        if (list.isEmpty()) {
+            postings.erase(posting);
+        }
+    }
+
+    docs[doc] = FoodItem();
+    docKeys[doc].clear();
+    freeDocs.append(doc);
+    return true;
+}
+
+/******************************************************************
+ * MenuSearchIndex::updateItem --
+ *   Refresh the stored copy of an indexed item (same name). Grams
+ *   depend only on the name, so postings are untouched.
+ *
+ * Parameters:
+ *   item - item with updated fields
+ *
+ * Modifies:
+ *   - docs: one entry replaced
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MenuSearchIndex::updateItem(const FoodItem &item)
+{
+    auto found = docByName.constFind(item.name);
+    if (found == docByName.constEnd()) {
+        addItem(item);
+        return;
+    }
+    docs[found.value()] = item;
+}
+
+// ========== SEARCH ==========
+
+/******************************************************************
+ * MenuSearchIndex::search --
+ *   Rank items against the query.
+ *
+ *   1) Count, per document, how many of the query's grams it has
+ *      (one pass over the matching posting lists).
+ *   2) Keep documents sharing at least half the query grams.
+ *   3) Score = shared fraction, plus a bonus for the name starting
+ *      with the query, a word starting with it, or containing it.
+ *   4) Return the top `limit` by score, then by shorter name.
+ *
+ * Parameters:
+ *   query - text typed by the user
+ *   limit - maximum number of results
+ *
+ * Returns:
+ *   matching items, best first
+ ******************************************************************/
+QVector<FoodItem> MenuSearchIndex::search(const QString &query, int limit) const
+{
+    QVector<FoodItem> results;
+    QString normalized = normalize(query);
+    const QVector<quint64> grams = gramsFor(normalized);
+    if (grams.isEmpty() || limit <= 0) {
+        return results;
+    }
+
+    if (hitCounts.size() < docs.size()) {
+        hitCounts.resize(docs.size());
+    }
+    touchedDocs.clear();
+
+    for (quint64 gram : grams) {
+        auto posting = postings.constFind(gram);
+        if (posting == postings.constEnd()) {
+            continue;
+        }
+        for (int doc : posting.value()) {
+            if (hitCounts[doc]++ == 0) {
+                touchedDocs.append(doc);
+            }
+        }
+    }
+
+    int gramCount = int(grams.size());
+    int minHits = qMax(1, (gramCount + 1) / 2);
+    QString wordPrefix = " " + normalized;
+
+    QVector<SearchHit> hits;
+    for (int doc : touchedDocs) {
+        int shared = hitCounts[doc];
+        hitCounts[doc] = 0;   // Reset scratch for the next search
+        if (shared < minHits) {
+            continue;
+        }
+
+        const QString &key = docKeys[doc];
+        double score = double(shared) / gramCount;
+        if (key.startsWith(normalized)) {
+            score += 1.0;
+        } else if (key.contains(wordPrefix)) {
+            score += 0.6;
+        } else if (key.contains(normalized)) {
+            score += 0.3;
+        }
+
+        SearchHit hit;
+        hit.doc = doc;
+        hit.score = score;
+        hits.append(hit);
+    }
+
+    auto better = [this](const SearchHit &a, const SearchHit &b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        return docKeys[a.doc].size() < docKeys[b.doc].size();
+    };
+    int count = qMin(limit, int(hits.size()));
+    partial_sort(hits.begin(), hits.begin() + count, hits.end(), better);
+
+    results.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        results.append(docs[hits[i].doc]);
+    }
+    return results;
+}
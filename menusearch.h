@@ -0,0 +1,80 @@
+/******************************************************************
+ * menusearch.h
+ *
+ * This header declares MenuSearchIndex, an in-memory n-gram index
+ * over menu item names used by the customer search box.
+ *
+ * Every word of a name is indexed by its leading bigram (" c") and
+ * its trigrams with a leading word boundary (" ch", "che", "hee",
+ * ...). A query is split the same way; items are ranked by how many
+ * of the query's grams they share, with bonuses for prefix and
+ * substring matches. Sharing most (not all) grams is enough to be a
+ * candidate, which makes the search tolerant of small typos
+ * ("chese cake" still finds "Cheese Cake").
+ *
+ ******************************************************************/
+
+#ifndef MENUSEARCH_H
+#define MENUSEARCH_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "menutypes.h"
+
+/******************************************************************
+ * MenuSearchIndex
+ *
+ * Keyed by item name (names are unique on the menu). Supports
+ * incremental add/remove/update so manager edits do not rebuild
+ * the whole index. Not thread-safe: used from the GUI thread.
+ ******************************************************************/
+class MenuSearchIndex
+{
+public:
+    /**************************************************************
+     * Building and incremental updates
+     *
+     * rebuild()    - replaces the index with the given items.
+     * addItem()    - indexes one new item (replaces an item with
+     *                the same name).
+     * removeItem() - drops the item with the given name.
+     * updateItem() - refreshes the stored copy of an item whose
+     *                name did not change (e.g., a price edit).
+     * size()       - number of indexed items.
+     **************************************************************/
+    void rebuild(const QVector<FoodItem> &items);
+    void addItem(const FoodItem &item);
+    bool removeItem(const QString &name);
+    void updateItem(const FoodItem &item);
+    int size() const { return docByName.size(); }
+
+    /**************************************************************
+     * search --
+     *   Best matches for the query, best first, at most `limit`.
+     *   Empty or blank queries return nothing.
+     **************************************************************/
+    QVector<FoodItem> search(const QString &query, int limit = 50) const;
+
+private:
+    QVector<FoodItem> docs;               // Indexed items by doc id
+    QVector<QString> docKeys;             // Normalized names by doc id
+    QVector<int> freeDocs;                // Doc ids of removed items
+    QHash<QString, int> docByName;        // Exact name -> doc id
+    QHash<quint64, QVector<int>> postings; // Gram -> doc ids
+
+    // Per-search scratch (sized to docs), kept to avoid reallocating
+    mutable QVector<quint16> hitCounts;
+    mutable QVector<int> touchedDocs;
+
+    /**************************************************************
+     * Helper functions (internal use only)
+     *
+     * normalize() - lower case, punctuation to spaces, single spaces.
+     * gramsFor()  - unique gram keys for a normalized string.
+     **************************************************************/
+    static QString normalize(const QString &text);
+    static QVector<quint64> gramsFor(const QString &normalized);
+};
+
+#endif // MENUSEARCH_H
@@ -0,0 +1,317 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * menustore.cpp
+ *
+ * This file implements MenuStore: copy-on-write menu snapshots
+ * published with atomic shared_ptr operations.
+ *
+ ******************************************************************/
+
+#include "menustore.h"
+#include <QHash>
+#include <QMutexLocker>
+#include <QSet>
+#include <atomic>
+
+namespace {
+
+/******************************************************************
+ * sameEntry --
+ *   Whether two versions of an item read the same in the menu file
+ *   (prices compared in cents, see diffMenu()).
+ ******************************************************************/
+bool sameEntry(const FoodItem &a, const FoodItem &b)
+{
+    return toCents(a.price) == toCents(b.price)
+           && a.category == b.category
+           && a.imagePath == b.imagePath
+           && a.availability == b.availability;
+}
+
+} // namespace
+
+/******************************************************************
+ * MenuStore::MenuStore --
+ *   Start with an empty menu at version 0.
+ ******************************************************************/
+MenuStore::MenuStore()
+{
+    current = std::make_shared<MenuSnapshot>();
+}
+
+/******************************************************************
+ * MenuStore::snapshot --
+ *   Grab the current snapshot.
+ *
+ * Parameters: none
+ *
+ * Returns:
+ *   pointer to an immutable snapshot (never null)
+ ******************************************************************/
+MenuSnapshotPtr MenuStore::snapshot() const
+{
+    return std::atomic_load_explicit(&current, std::memory_order_acquire);
+}
+
+/******************************************************************
+ * MenuStore::replace --
+ *   Publish a completely new item list.
+ *
+ * Parameters:
+ *   items - new menu contents
+ *
+ * Modifies:
+ *   - current: new version published
+ *
+ * Returns:
+ *   the published snapshot
+ ******************************************************************/
+MenuSnapshotPtr MenuStore::replace(const QVector<FoodItem> &items)
+{
+    QMutexLocker locker(&writerMutex);
+
+    CategoryRegistry categories;
+    categories.rebuild(items);
+    return publish(items, categories);
+}
+
+/******************************************************************
+ * MenuStore::update --
+ *   Read-copy-update: copy the current items and categories, edit
+ *   the copies and publish them. Readers holding the old snapshot
+ *   keep seeing it until they grab a new one.
+ *
+ * Parameters:
+ *   edit - changes the items; returns false to publish nothing
+ *
+ * Modifies:
+ *   - current: new version published if edit() returned true
+ *
+ * Returns:
+ *   the snapshot that is current after the update
+ ******************************************************************/
+MenuSnapshotPtr MenuStore::update(const MenuEdit &edit)
+{
+    QMutexLocker locker(&writerMutex);
+
+    MenuSnapshotPtr old = snapshot();
+    QVector<FoodItem> items = old->items;
+    CategoryRegistry categories = old->categories;
+    if (!edit(items, categories)) {
+        return old;
+    }
+    return publish(items, categories);
+}
+
+/******************************************************************
+ * MenuStore::applyDelta --
+ *   Apply a hot-reload delta as one read-copy-update, adjusting the
+ *   category registry item by item.
+ *
+ * Parameters:
+ *   delta - output of diffMenu()
+ *
+ * Modifies:
+ *   - current: new version published unless the delta is empty
+ *
+ * Returns:
+ *   the snapshot that is current after the update
+ ******************************************************************/
+MenuSnapshotPtr MenuStore::applyDelta(const MenuDelta &delta)
+{
+    return update([&delta](QVector<FoodItem> &items, CategoryRegistry &categories) {
+        if (delta.isEmpty()) {
+            return false;
+        }
+
+        QHash<QString, int> rowByName;
+        for (int row = 0; row < items.size(); ++row) {
+            if (!rowByName.contains(items[row].name)) {
+                rowByName.insert(items[row].name, row);
+            }
+        }
+
+        // Changes in place, so the item keeps its position in the menu
+        for (const FoodItem &item : delta.changed) {
+            auto found = rowByName.constFind(item.name);
+            if (found == rowByName.constEnd()) {
+                continue;
+            }
+            FoodItem &live = items[found.value()];
+            if (live.category == item.category) {
+                categories.changePrice(live.category, live.price, item.price);
+            } else {
+                categories.removeItem(live);
+                categories.addItem(item);
+            }
+            live.price = item.price;
+            live.category = item.category;
+            live.imagePath = item.imagePath;
+            live.availability = item.availability;
+        }
+
+        if (!delta.removed.isEmpty()) {
+            QSet<QString> removedNames;
+            for (const FoodItem &item : delta.removed) {
+                removedNames.insert(item.name);
+                rowByName.remove(item.name);
+            }
+            QVector<FoodItem> kept;
+            kept.reserve(items.size());
+            for (const FoodItem &item : items) {
+                if (removedNames.contains(item.name)) {
+                    categories.removeItem(item);
+                } else {
+                    kept.append(item);
+                }
+            }
+            items = kept;
+        }
+
+        // A second reload may carry the same addition; add it once
+        for (const FoodItem &item : delta.added) {
+            if (rowByName.contains(item.name)) {
+                continue;
+            }
+            rowByName.insert(item.name, items.size());
+            items.append(item);
+            categories.addItem(item);
+        }
+        return true;
+    });
+}
+
+/******************************************************************
+ * MenuStore::publish --
+ *   Assign missing item IDs, intern strings, build the catalog
+ *   columns and the availability index, then wrap everything in a
+ *   new snapshot and swap it in. Caller must hold writerMutex.
+ *
+ * Parameters:
+ *   items      - contents of the new snapshot
+ *   categories - category registry matching items
+ *
+ * Returns:
+ *   the published snapshot
+ ******************************************************************/
+MenuSnapshotPtr MenuStore::publish(QVector<FoodItem> items, CategoryRegistry categories)
+{
+    for (FoodItem &item : items) {
+        if (item.id <= 0) {
+            item.id = nextItemId++;
+        } else if (item.id >= nextItemId) {
+            nextItemId = item.id + 1;
+        }
+    }
+
+    std::shared_ptr<MenuSnapshot> next = std::make_shared<MenuSnapshot>();
+    next->version = snapshot()->version + 1;
+    next->columns = buildCatalogColumns(items, categoryPool, imagePool);
+    next->availability.build(items);
+    next->items = std::move(items);
+    next->categories = std::move(categories);
+
+    MenuSnapshotPtr published = next;
+    std::atomic_store_explicit(&current, published, std::memory_order_release);
+    return published;
+}
+
+// ========== DIFF ==========
+
+/******************************************************************
+ * diffMenu --
+ *   See menustore.h. Prices are compared in cents so that a value
+ *   written and read back through the text file is not reported as
+ *   a change. Duplicate names: the first occurrence wins, as in
+ *   CatalogColumns::rowOf().
+ ******************************************************************/
+MenuDelta diffMenu(const QVector<FoodItem> &live, const QVector<FoodItem> &incoming)
+{
+    MenuDelta delta;
+
+    QHash<QString, int> liveRow;
+    for (int row = 0; row < live.size(); ++row) {
+        if (!liveRow.contains(live[row].name)) {
+            liveRow.insert(live[row].name, row);
+        }
+    }
+
+    QSet<QString> seen;
+    for (const FoodItem &item : incoming) {
+        if (seen.contains(item.name)) {
+            continue;
+        }
+        seen.insert(item.name);
+
+        auto found = liveRow.constFind(item.name);
+        if (found == liveRow.constEnd()) {
+            FoodItem added = item;
+            added.id = 0;
+            delta.added.append(added);
+            continue;
+        }
+
+        const FoodItem &old = live[found.value()];
+        if (!sameEntry(old, item)) {
+            FoodItem changed = item;
+            changed.id = old.id;
+            delta.changed.append(changed);
+        }
+    }
+
+    for (auto row = liveRow.constBegin(); row != liveRow.constEnd(); ++row) {
+        if (!seen.contains(row.key())) {
+            delta.removed.append(live[row.value()]);
+        }
+    }
+    return delta;
+}
+
+/******************************************************************
+ * rebaseMenuDelta --
+ *   See menustore.h. An item is taken from the file only while the
+ *   live menu still has the previous file's version of it; anything
+ *   else is a pending manager edit and wins.
+ ******************************************************************/
+MenuDelta rebaseMenuDelta(const MenuDelta &fileDelta,
+                          const QVector<FoodItem> &previousFile,
+                          const MenuSnapshotPtr &live)
+{
+    MenuDelta delta;
+
+    for (const FoodItem &item : fileDelta.added) {
+        if (live->columns.rowOf(item.name) < 0) {
+            delta.added.append(item);   // Present: the manager added it too
+        }
+    }
+
+    for (const FoodItem &item : fileDelta.removed) {
+        int row = live->columns.rowOf(item.name);
+        if (row >= 0 && sameEntry(live->items[row], item)) {
+            delta.removed.append(live->items[row]);
+        }
+    }
+
+    if (fileDelta.changed.isEmpty()) {
+        return delta;
+    }
+    QHash<QString, int> previousRow;
+    for (int row = previousFile.size() - 1; row >= 0; --row) {
+        previousRow.insert(previousFile[row].name, row);   // First occurrence wins
+    }
+    for (const FoodItem &item : fileDelta.changed) {
+        int row = live->columns.rowOf(item.name);
+        int before = previousRow.value(item.name, -1);
+        if (row < 0 || before < 0) {
+            continue;   // Removed by the manager
+        }
+        const FoodItem &current = live->items[row];
+        if (sameEntry(current, previousFile[before]) && !sameEntry(current, item)) {
+            FoodItem changed = item;
+            changed.id = current.id;
+            delta.changed.append(changed);
+        }
+    }
+    return delta;
+}
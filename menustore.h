@@ -0,0 +1,146 @@
+/******************************************************************
+ * menustore.h
+ *
+ * This header declares MenuStore, which publishes the menu as
+ * immutable, versioned snapshots (read-copy-update style).
+ *
+ * Readers call snapshot() and keep the returned pointer for as long
+ * as they need a consistent view; it never changes under them.
+ * Writers (manager edits, file loads) copy the current items, edit
+ * the copy and publish it as a new version. Readers never wait for
+ * a writer and never see a half-finished edit.
+ *
+ ******************************************************************/
+
+#ifndef MENUSTORE_H
+#define MENUSTORE_H
+
+#include <QMutex>
+#include <QVector>
+#include <functional>
+#include <memory>
+#include "menutypes.h"
+#include "catalogstore.h"
+#include "categoryregistry.h"
+#include "availability.h"
+
+/******************************************************************
+ * MenuSnapshot
+ *
+ * One published version of the menu. Never modified after it is
+ * published.
+ *
+ * Members:
+ *   version    - increases by one with every publish
+ *   items      - all food items, in menu order; category and image
+ *                strings are interned (shared) copies
+ *   columns    - struct-of-arrays view of the hot fields, row i is
+ *                items[i]
+ *   categories - category names, item counts and price ranges
+ *   availability - which rows are on sale at each time of the week
+ ******************************************************************/
+struct MenuSnapshot {
+    quint64 version = 0;
+    QVector<FoodItem> items;
+    CatalogColumns columns;
+    CategoryRegistry categories;
+    AvailabilityIndex availability;
+};
+
+typedef std::shared_ptr<const MenuSnapshot> MenuSnapshotPtr;
+
+/******************************************************************
+ * MenuStore
+ *
+ * Holds the current MenuSnapshot. Can be shared between several
+ * OrderEngines (and threads) through a std::shared_ptr.
+ ******************************************************************/
+class MenuStore
+{
+public:
+    MenuStore();
+
+    /**************************************************************
+     * snapshot --
+     *   The current menu. Lock-free for readers apart from the
+     *   shared_ptr reference count.
+     *
+     * replace --
+     *   Publishes a whole new item list (file load, defaults). The
+     *   category registry is recounted from scratch.
+     *
+     * Every publish assigns IDs to items that have none, interns
+     * their strings and builds the snapshot's catalog columns.
+     *
+     * update --
+     *   Copies the current items and category registry, calls
+     *   edit() on the copies, and publishes them if edit() returns
+     *   true. edit() keeps the registry in step with its item
+     *   changes. Writers are serialized so concurrent edits are
+     *   not lost. Returns the snapshot that is current afterwards.
+     *
+     * applyDelta --
+     *   Applies a MenuDelta (hot reload, bulk import) as one
+     *   update: changed items keep their position, removed items
+     *   go, added items are appended once.
+     **************************************************************/
+    typedef std::function<bool(QVector<FoodItem> &, CategoryRegistry &)> MenuEdit;
+
+    MenuSnapshotPtr snapshot() const;
+    MenuSnapshotPtr replace(const QVector<FoodItem> &items);
+    MenuSnapshotPtr update(const MenuEdit &edit);
+    MenuSnapshotPtr applyDelta(const MenuDelta &delta);
+
+private:
+    MenuSnapshotPtr current;   // Accessed only through std::atomic_load/store
+    QMutex writerMutex;        // Serializes writers; readers never take it
+
+    // Writer-side state, guarded by writerMutex. The pools only grow;
+    // a few stale strings are cheaper than re-interning every edit.
+    StringPool categoryPool;   // Shared category strings
+    StringPool imagePool;      // Shared image path strings
+    int nextItemId = 1;        // Next ID for items published with id 0
+
+    MenuSnapshotPtr publish(QVector<FoodItem> items, CategoryRegistry categories);
+};
+
+/******************************************************************
+ * diffMenu --
+ *   Compare the live items (or an earlier read of the menu file)
+ *   with freshly parsed ones. Items are matched by name (the menu
+ *   file carries no IDs); matched items keep the live ID. Pure
+ *   function, safe on a worker thread as long as `live` comes from
+ *   a snapshot.
+ *
+ * Parameters:
+ *   live     - current menu items
+ *   incoming - items read from the menu file
+ *
+ * Returns:
+ *   the additions, removals and changes needed to turn live into
+ *   incoming
+ ******************************************************************/
+MenuDelta diffMenu(const QVector<FoodItem> &live, const QVector<FoodItem> &incoming);
+
+/******************************************************************
+ * rebaseMenuDelta --
+ *   Turn the difference between two versions of the menu file into
+ *   the delta to apply to the live menu, which may hold unsaved
+ *   manager edits on top of the older file. An item the manager
+ *   has edited, removed or added since keeps the manager's version;
+ *   entries the live menu already matches are dropped.
+ *
+ * Parameters:
+ *   fileDelta    - diffMenu(previousFile, newFile)
+ *   previousFile - file contents fileDelta starts from
+ *   live         - current snapshot
+ *
+ * Returns:
+ *   the part of fileDelta that applies to live (changed and
+ *   removed items carry the live IDs)
+ ******************************************************************/
+MenuDelta rebaseMenuDelta(const MenuDelta &fileDelta,
+                          const QVector<FoodItem> &previousFile,
+                          const MenuSnapshotPtr &live);
+
+#endif // MENUSTORE_H
@@ -0,0 +1,539 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * menutablemodel.cpp
+ *
+ * This file implements MenuTableModel (the manager item table) and
+ * PriceDelegate (inline price editing).
+ *
+ ******************************************************************/
+
+#include "menutablemodel.h"
+#include "tracer.h"
+#include <QDoubleSpinBox>
+#include <QHash>
+#include <QSet>
+#include <algorithm>
+#include <limits>
+
+/******************************************************************
+ * sortRows --
+ *   Stable sort of view rows with a "less than" on snapshot rows.
+ *   Stable, so equal keys stay in menu order.
+ ******************************************************************/
+template <typename Less>
+static void sortRows(QVector<int> &rows, Qt::SortOrder order, Less less)
+{
+    if (order == Qt::AscendingOrder) {
+        std::stable_sort(rows.begin(), rows.end(), less);
+    } else {
+        std::stable_sort(rows.begin(), rows.end(), [&less](int a, int b) { return less(b, a); });
+    }
+}
+
+/******************************************************************
+ * stockText --
+ *   Stock cell text: empty for untracked items, "Sold out", or the
+ *   units still for sale plus those sitting in open carts.
+ ******************************************************************/
+static QString stockText(const Inventory *inventory, int itemId)
+{
+    int available = inventory ? inventory->available(itemId) : Inventory::UNTRACKED;
+    if (available == Inventory::UNTRACKED) {
+        return QString();
+    }
+    if (available == 0) {
+        return QString("Sold out");
+    }
+    int inCarts = inventory->onHand(itemId) - available;
+    return inCarts > 0 ? QString("%1 (+%2 in carts)").arg(available).arg(inCarts) : QString::number(available);
+}
+
+/******************************************************************
+ * MenuTableModel::MenuTableModel --
+ *   Constructor. The model is empty until setSnapshot().
+ ******************************************************************/
+MenuTableModel::MenuTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+// ========== CONTENTS ==========
+
+/******************************************************************
+ * MenuTableModel::setSnapshot --
+ *   See menutablemodel.h. Three passes, each reported to the view
+ *   as it happens: remove the rows whose items are gone (bottom-up,
+ *   one call per run of rows), move the remaining rows to their new
+ *   order, then insert the rows of new items (top-down, one call
+ *   per run). The kept rows are finally repainted, since prices
+ *   and categories may have changed.
+ *
+ * Parameters:
+ *   snapshot - menu version to show
+ *
+ * Modifies:
+ *   - menu, visibleRows, persistent indexes
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MenuTableModel::setSnapshot(MenuSnapshotPtr snapshot)
+{
+    TRACE_SCOPE("MenuTableModel::setSnapshot");
+
+    QVector<int> rows = computeRows(snapshot);
+    if (!menu || !snapshot) {
+        beginResetModel();
+        menu = snapshot;
+        visibleRows = rows;
+        endResetModel();
+        return;
+    }
+
+    const QVector<qint32> &oldIds = menu->columns.itemIds;
+    const QVector<qint32> &newIds = snapshot->columns.itemIds;
+    QSet<qint32> shownIds;
+    shownIds.reserve(visibleRows.size());
+    for (int row : visibleRows) {
+        shownIds.insert(oldIds[row]);
+    }
+    QSet<qint32> wantedIds;
+    wantedIds.reserve(rows.size());
+    for (int row : rows) {
+        wantedIds.insert(newIds[row]);
+    }
+
+    // 1. Items no longer shown
+    int viewRow = visibleRows.size() - 1;
+    while (viewRow >= 0) {
+        if (wantedIds.contains(oldIds[visibleRows[viewRow]])) {
+            --viewRow;
+            continue;
+        }
+        int last = viewRow;
+        while (viewRow >= 0 && !wantedIds.contains(oldIds[visibleRows[viewRow]])) {
+            --viewRow;
+        }
+        beginRemoveRows(QModelIndex(), viewRow + 1, last);
+        visibleRows.remove(viewRow + 1, last - viewRow);
+        endRemoveRows();
+    }
+
+    // 2. The rest in their new order
+    QVector<int> keptRows;
+    keptRows.reserve(visibleRows.size());
+    for (int row : rows) {
+        if (shownIds.contains(newIds[row])) {
+            keptRows.append(row);
+        }
+    }
+    relayout(snapshot, keptRows);
+    if (!visibleRows.isEmpty()) {
+        emit dataChanged(index(0, 0), index(visibleRows.size() - 1, ColumnCount - 1));
+    }
+
+    // 3. Items not shown before
+    viewRow = 0;
+    while (viewRow < rows.size()) {
+        if (shownIds.contains(newIds[rows[viewRow]])) {
+            ++viewRow;
+            continue;
+        }
+        int first = viewRow;
+        while (viewRow < rows.size() && !shownIds.contains(newIds[rows[viewRow]])) {
+            ++viewRow;
+        }
+        beginInsertRows(QModelIndex(), first, viewRow - 1);
+        visibleRows = rows.mid(0, viewRow) + visibleRows.mid(first);
+        endInsertRows();
+    }
+}
+
+/******************************************************************
+ * MenuTableModel::setFilterText --
+ *   See menutablemodel.h. The row count changes, so the model is
+ *   reset.
+ ******************************************************************/
+void MenuTableModel::setFilterText(const QString &text)
+{
+    QString trimmed = text.trimmed();
+    if (trimmed == filterText) {
+        return;
+    }
+
+    beginResetModel();
+    filterText = trimmed;
+    visibleRows = computeRows(menu);
+    endResetModel();
+}
+
+/******************************************************************
+ * MenuTableModel::itemName --
+ *   Exact item name for a view row (empty if out of range).
+ ******************************************************************/
+QString MenuTableModel::itemName(int row) const
+{
+    if (!menu || row < 0 || row >= visibleRows.size()) {
+        return QString();
+    }
+    return menu->items[visibleRows[row]].name;
+}
+
+/******************************************************************
+ * MenuTableModel::setInventory --
+ *   Use these counters for the Stock column.
+ ******************************************************************/
+void MenuTableModel::setInventory(std::shared_ptr<const Inventory> counters)
+{
+    inventory = counters;
+    if (!visibleRows.isEmpty()) {
+        emit dataChanged(index(0, StockColumn), index(visibleRows.size() - 1, StockColumn));
+    }
+}
+
+/******************************************************************
+ * MenuTableModel::refreshStock --
+ *   Repaint one item's Stock cell. A linear scan of the item ID
+ *   column; only called when stock is edited or an item sells out.
+ *
+ * Parameters:
+ *   itemId - MenuStore item ID
+ *
+ * Modifies: nothing (emits dataChanged)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MenuTableModel::refreshStock(int itemId)
+{
+    if (!menu) {
+        return;
+    }
+    const QVector<qint32> &itemIds = menu->columns.itemIds;
+    for (int viewRow = 0; viewRow < visibleRows.size(); ++viewRow) {
+        if (itemIds[visibleRows[viewRow]] == itemId) {
+            QModelIndex cell = index(viewRow, StockColumn);
+            emit dataChanged(cell, cell);
+            return;
+        }
+    }
+}
+
+/******************************************************************
+ * MenuTableModel::computeRows --
+ *   Apply the filter and sort to a snapshot.
+ *
+ *   Filtering checks each category once (not once per item) and
+ *   then walks the category ID column. Sorting compares integer
+ *   columns (price in cents, category rank) or pre-folded names,
+ *   never QVariants, which keeps 100k-row sorts well under 100 ms.
+ *
+ * Parameters:
+ *   snapshot - menu version (may be null)
+ *
+ * Modifies:
+ *   - foldedNames: rebuilt on the first name sort of a snapshot
+ *
+ * Returns:
+ *   snapshot rows in view order
+ ******************************************************************/
+QVector<int> MenuTableModel::computeRows(const MenuSnapshotPtr &snapshot)
+{
+    QVector<int> rows;
+    if (!snapshot) {
+        return rows;
+    }
+
+    const QVector<FoodItem> &items = snapshot->items;
+    const CatalogColumns &columns = snapshot->columns;
+    rows.reserve(items.size());
+
+    if (filterText.isEmpty()) {
+        for (int row = 0; row < items.size(); ++row) {
+            rows.append(row);
+        }
+    } else {
+        QVector<bool> categoryMatches(columns.categoryNames.size());
+        for (int id = 0; id < columns.categoryNames.size(); ++id) {
+            categoryMatches[id] = columns.categoryNames[id].contains(filterText, Qt::CaseInsensitive);
+        }
+        for (int row = 0; row < items.size(); ++row) {
+            if (categoryMatches[columns.categoryIds[row]]
+                || items[row].name.contains(filterText, Qt::CaseInsensitive)) {
+                rows.append(row);
+            }
+        }
+    }
+
+    switch (sortColumn) {
+    case NameColumn: {
+        if (foldedVersion != snapshot->version || foldedNames.size() != items.size()) {
+            foldedNames.resize(items.size());
+            for (int row = 0; row < items.size(); ++row) {
+                foldedNames[row] = items[row].name.toCaseFolded();
+            }
+            foldedVersion = snapshot->version;
+        }
+        const QVector<QString> &names = foldedNames;
+        sortRows(rows, sortOrder, [&names](int a, int b) { return names[a] < names[b]; });
+        break;
+    }
+    case CategoryColumn: {
+        // Rank the few category names alphabetically, then sort ints
+        QVector<int> byName(columns.categoryNames.size());
+        for (int id = 0; id < byName.size(); ++id) {
+            byName[id] = id;
+        }
+        std::sort(byName.begin(), byName.end(), [&columns](int a, int b) {
+            return QString::compare(columns.categoryNames[a], columns.categoryNames[b], Qt::CaseInsensitive) < 0;
+        });
+        QVector<int> rank(byName.size());
+        for (int position = 0; position < byName.size(); ++position) {
+            rank[byName[position]] = position;
+        }
+        const quint16 *categoryIds = columns.categoryIds.constData();
+        sortRows(rows, sortOrder, [&rank, categoryIds](int a, int b) {
+            return rank[categoryIds[a]] < rank[categoryIds[b]];
+        });
+        break;
+    }
+    case PriceColumn: {
+        const qint32 *cents = columns.priceCents.constData();
+        sortRows(rows, sortOrder, [cents](int a, int b) { return cents[a] < cents[b]; });
+        break;
+    }
+    case HoursColumn:
+        sortRows(rows, sortOrder, [&items](int a, int b) {
+            return QString::compare(items[a].availability, items[b].availability, Qt::CaseInsensitive) < 0;
+        });
+        break;
+    case StockColumn: {
+        // Read each counter once; untracked (unlimited) sorts last
+        QVector<qint64> units(items.size(), std::numeric_limits<qint64>::max());
+        if (inventory) {
+            for (int row : rows) {
+                int available = inventory->available(columns.itemIds[row]);
+                if (available != Inventory::UNTRACKED) {
+                    units[row] = available;
+                }
+            }
+        }
+        sortRows(rows, sortOrder, [&units](int a, int b) { return units[a] < units[b]; });
+        break;
+    }
+    default:
+        break;   // Menu order
+    }
+
+    return rows;
+}
+
+/******************************************************************
+ * MenuTableModel::relayout --
+ *   Switch to new visible rows of the same items (possibly in
+ *   another snapshot, where they sit at other rows), keeping the
+ *   view's persistent indexes (selection, current cell, open
+ *   editor) attached to the same item IDs.
+ *
+ * Parameters:
+ *   snapshot - menu version the rows refer to
+ *   rows     - new view order (same items as visibleRows)
+ *
+ * Modifies:
+ *   - menu, visibleRows, persistent indexes
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MenuTableModel::relayout(MenuSnapshotPtr snapshot, const QVector<int> &rows)
+{
+    emit layoutAboutToBeChanged();
+
+    // Only the few items with persistent indexes are looked up
+    const QModelIndexList oldIndexes = persistentIndexList();
+    QVector<qint32> oldItemIds;
+    oldItemIds.reserve(oldIndexes.size());
+    QHash<qint32, int> viewRowOf;   // Item ID -> new view row
+    for (const QModelIndex &old : oldIndexes) {
+        int itemRow = visibleRows.value(old.row(), -1);
+        qint32 itemId = itemRow >= 0 ? menu->columns.itemIds[itemRow] : -1;
+        oldItemIds.append(itemId);
+        viewRowOf.insert(itemId, -1);
+    }
+
+    menu = snapshot;
+    visibleRows = rows;
+
+    if (!viewRowOf.isEmpty()) {
+        const QVector<qint32> &itemIds = menu->columns.itemIds;
+        for (int viewRow = 0; viewRow < visibleRows.size(); ++viewRow) {
+            auto wanted = viewRowOf.find(itemIds[visibleRows[viewRow]]);
+            if (wanted != viewRowOf.end()) {
+                wanted.value() = viewRow;
+            }
+        }
+    }
+
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (int i = 0; i < oldIndexes.size(); ++i) {
+        int viewRow = viewRowOf.value(oldItemIds[i], -1);
+        newIndexes.append(viewRow >= 0 ? index(viewRow, oldIndexes[i].column()) : QModelIndex());
+    }
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    emit layoutChanged();
+}
+
+// ========== QAbstractTableModel ==========
+
+int MenuTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : visibleRows.size();
+}
+
+int MenuTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(ColumnCount);
+}
+
+/******************************************************************
+ * MenuTableModel::data --
+ *   Called by the view only for rows it paints, so formatting is
+ *   lazy: 100k rows cost nothing until they scroll into view.
+ ******************************************************************/
+QVariant MenuTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!menu || !index.isValid() || index.row() >= visibleRows.size()) {
+        return QVariant();
+    }
+
+    const FoodItem &item = menu->items[visibleRows[index.row()]];
+    switch (role) {
+    case Qt::DisplayRole:
+        if (index.column() == NameColumn) return item.name;
+        if (index.column() == CategoryColumn) return item.category;
+        if (index.column() == HoursColumn) return item.availability.isEmpty() ? QString("All day") : item.availability;
+        if (index.column() == StockColumn) return stockText(inventory.get(), item.id);
+        return QString("$%1").arg(item.price, 0, 'f', 2);
+    case Qt::EditRole:
+        if (index.column() == PriceColumn) return item.price;
+        if (index.column() == StockColumn) return inventory ? inventory->onHand(item.id) : Inventory::UNTRACKED;
+        return data(index, Qt::DisplayRole);
+    case Qt::TextAlignmentRole:
+        if (index.column() == PriceColumn) return int(Qt::AlignRight | Qt::AlignVCenter);
+        return QVariant();
+    case Qt::UserRole:
+        return item.name;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant MenuTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (section) {
+    case NameColumn:     return QString("Name");
+    case CategoryColumn: return QString("Category");
+    case PriceColumn:    return QString("Price");
+    case HoursColumn:    return QString("Hours");
+    case StockColumn:    return QString("Stock");
+    default:             return QVariant();
+    }
+}
+
+Qt::ItemFlags MenuTableModel::flags(const QModelIndex &index) const
+{
+    Qt::ItemFlags result = QAbstractTableModel::flags(index);
+    if (index.isValid() && (index.column() == PriceColumn || index.column() == StockColumn)) {
+        result |= Qt::ItemIsEditable;
+    }
+    return result;
+}
+
+/******************************************************************
+ * MenuTableModel::setData --
+ *   Price and stock edits are forwarded through
+ *   priceEditRequested() / stockEditRequested(); the model changes
+ *   when the owner passes in the new snapshot (or, for stock, when
+ *   the counters change).
+ *
+ * Returns:
+ *   true if an edit was requested
+ ******************************************************************/
+bool MenuTableModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!menu || role != Qt::EditRole || index.row() >= visibleRows.size()) {
+        return false;
+    }
+    const FoodItem &item = menu->items[visibleRows[index.row()]];
+
+    if (index.column() == StockColumn) {
+        bool ok = false;
+        int units = value.toInt(&ok);
+        if (!ok) {
+            return false;
+        }
+        emit stockEditRequested(item.name, units < 0 ? Inventory::UNTRACKED : units);
+        return true;
+    }
+    if (index.column() != PriceColumn) {
+        return false;
+    }
+
+    bool ok = false;
+    double price = value.toDouble(&ok);
+    if (!ok || price < 0.0 || toCents(price) == toCents(item.price)) {
+        return false;
+    }
+
+    emit priceEditRequested(item.name, price);
+    return true;
+}
+
+/******************************************************************
+ * MenuTableModel::sort --
+ *   Called by the view when a header is clicked. Re-orders the
+ *   visible rows in place; selections follow their items.
+ ******************************************************************/
+void MenuTableModel::sort(int column, Qt::SortOrder order)
+{
+    TRACE_SCOPE("MenuTableModel::sort");
+
+    sortColumn = column;
+    sortOrder = order;
+    if (menu) {
+        relayout(menu, computeRows(menu));
+    }
+}
+
+// ========== PRICE DELEGATE ==========
+
+QWidget *PriceDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                                     const QModelIndex &index) const
+{
+    Q_UNUSED(option);
+    Q_UNUSED(index);
+
+    QDoubleSpinBox *editor = new QDoubleSpinBox(parent);
+    editor->setRange(0.00, 10000.00);   // Same limits as the Edit Price dialog
+    editor->setDecimals(2);
+    editor->setPrefix("$");
+    editor->setFrame(false);
+    return editor;
+}
+
+void PriceDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const
+{
+    QDoubleSpinBox *spinBox = static_cast<QDoubleSpinBox *>(editor);
+    spinBox->setValue(index.data(Qt::EditRole).toDouble());
+}
+
+void PriceDelegate::setModelData(QWidget *editor, QAbstractItemModel *model,
+                                 const QModelIndex &index) const
+{
+    QDoubleSpinBox *spinBox = static_cast<QDoubleSpinBox *>(editor);
+    spinBox->interpretText();
+    model->setData(index, spinBox->value(), Qt::EditRole);
+}
@@ -0,0 +1,132 @@
+/******************************************************************
+ * menutablemodel.h
+ *
+ * This header declares the model/delegate pair behind the manager
+ * item table:
+ *   - MenuTableModel exposes a menu snapshot as a sortable,
+ *     filterable table (Name, Category, Price, Hours, Stock). Rows
+ *     are rendered
+ *     lazily by the view, so only visible rows are ever formatted,
+ *     and sorting works on the snapshot's compact columns.
+ *   - PriceDelegate edits the price column inline with a spin box.
+ *
+ ******************************************************************/
+
+#ifndef MENUTABLEMODEL_H
+#define MENUTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QStyledItemDelegate>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include "menustore.h"
+#include "inventory.h"
+
+/******************************************************************
+ * MenuTableModel
+ *
+ * Read-only view of one MenuSnapshot plus a list of visible rows
+ * (filtered and sorted). Price and stock edits are not applied
+ * here; they are reported through priceEditRequested() and
+ * stockEditRequested() so the owner can go through OrderEngine and
+ * then hand back the new snapshot. Stock is read live from the
+ * Inventory when a cell is painted.
+ ******************************************************************/
+class MenuTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column { NameColumn = 0, CategoryColumn, PriceColumn, HoursColumn, StockColumn, ColumnCount };
+
+    explicit MenuTableModel(QObject *parent = nullptr);
+
+    /**************************************************************
+     * setSnapshot --
+     *   Show a new menu version. The current filter and sort are
+     *   re-applied. Rows are matched to the shown ones by item ID:
+     *   rows of items that left are removed, rows of new items are
+     *   inserted and the others are moved in place, so selections,
+     *   open editors and the scroll position stay with their items.
+     *   Only the first snapshot resets the model.
+     *
+     * setFilterText --
+     *   Show only items whose name or category contains the text
+     *   (case-insensitive). Empty shows everything.
+     *
+     * itemName --
+     *   Exact name of the item shown in a view row.
+     *
+     * setInventory --
+     *   Stock counters for the Stock column (none: column empty).
+     *
+     * refreshStock --
+     *   Repaint the Stock cell of one item after its stock changed.
+     **************************************************************/
+    void setSnapshot(MenuSnapshotPtr snapshot);
+    void setFilterText(const QString &text);
+    QString itemName(int row) const;
+    void setInventory(std::shared_ptr<const Inventory> counters);
+    void refreshStock(int itemId);
+
+    // QAbstractTableModel
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+signals:
+    /**************************************************************
+     * priceEditRequested --
+     *   The manager typed a new price in the table.
+     **************************************************************/
+    void priceEditRequested(const QString &name, double price);
+
+    /**************************************************************
+     * stockEditRequested --
+     *   The manager typed a stock count (negative: not tracked).
+     **************************************************************/
+    void stockEditRequested(const QString &name, int units);
+
+private:
+    MenuSnapshotPtr menu;
+    std::shared_ptr<const Inventory> inventory;
+    QVector<int> visibleRows;      // View row -> snapshot row
+    QString filterText;
+    int sortColumn = -1;           // -1 = menu order
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+
+    // Case-folded names for sorting, built on first name sort of a
+    // snapshot (one allocation per item, not one per comparison)
+    QVector<QString> foldedNames;
+    quint64 foldedVersion = 0;
+
+    QVector<int> computeRows(const MenuSnapshotPtr &snapshot);
+    void relayout(MenuSnapshotPtr snapshot, const QVector<int> &rows);
+};
+
+/******************************************************************
+ * PriceDelegate
+ *
+ * Inline editor for the price column: a QDoubleSpinBox limited to
+ * the same range as the "Edit Price" dialog.
+ ******************************************************************/
+class PriceDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit PriceDelegate(QObject *parent = nullptr) : QStyledItemDelegate(parent) {}
+
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                          const QModelIndex &index) const override;
+    void setEditorData(QWidget *editor, const QModelIndex &index) const override;
+    void setModelData(QWidget *editor, QAbstractItemModel *model,
+                      const QModelIndex &index) const override;
+};
+
+#endif // MENUTABLEMODEL_H
@@ -0,0 +1,106 @@
+/******************************************************************
+ * menutypes.h
+ *
+ * This header defines the simple data structures shared by the
+ * ordering logic and the GUI: menu items, order items, checkout
+ * totals and menu deltas.
+ *
+ ******************************************************************/
+
+#ifndef MENUTYPES_H
+#define MENUTYPES_H
+
+#include <QString>
+#include <QVector>
+
+/******************************************************************
+ * FoodItem
+ *
+ * Simple struct used to store information about a single item
+ * on the cafeteria menu.
+ *
+ * Members:
+ *   id        - stable item ID, assigned by MenuStore when the item
+ *               is first published (0 = not assigned yet)
+ *   name      - name of the item (e.g., "Cheese Burger")
+ *   price     - price of the item in dollars
+ *   category  - menu category (e.g., "Main Dishes", "Beverages")
+ *   imagePath - resource path for the item's icon image
+ *   availability - when the item is on sale, e.g. "breakfast" or
+ *               "Mon-Fri 11:00-19:00" (empty = always; see
+ *               availability.h)
+ ******************************************************************/
+struct FoodItem {
+    int id = 0;
+    QString name;
+    double price = 0.0;
+    QString category;
+    QString imagePath;
+    QString availability;
+};
+
+/******************************************************************
+ * OrderItem
+ *
+ * Struct used to store items that the customer has added to
+ * their cart during the ordering process.
+ *
+ * Members:
+ *   itemId     - menu item ID (the stock the line has reserved)
+ *   name       - name of the item
+ *   price      - price of one unit of the item
+ *   quantity   - how many of this item are in the cart
+ *   stockUnits - how many of them were taken from tracked stock
+ *                (units added while the item was not tracked are
+ *                not counted, see Inventory::reserve())
+ ******************************************************************/
+struct OrderItem {
+    int itemId = 0;
+    QString name;
+    double price;
+    int quantity;
+    int stockUnits = 0;
+};
+
+/******************************************************************
+ * OrderTotals
+ *
+ * Money values calculated for one checkout.
+ *
+ * Members:
+ *   subtotal   - sum of item costs before discount
+ *   discount   - discount amount in dollars
+ *   tax        - tax amount in dollars (TAX_RATE of discounted)
+ *   total      - final amount to pay
+ *   couponCode - coupon that was applied (empty if none)
+ ******************************************************************/
+struct OrderTotals {
+    double subtotal = 0.0;
+    double discount = 0.0;
+    double tax = 0.0;
+    double total = 0.0;
+    QString couponCode;
+};
+
+/******************************************************************
+ * MenuDelta
+ *
+ * Difference between two item lists (the live menu or an earlier
+ * read of the menu file, and a newly read file), used to apply a
+ * hot reload or bulk import without rebuilding everything.
+ *
+ * Members:
+ *   added   - items only in the new file
+ *   removed - live items missing from the new file
+ *   changed - new versions of items whose price, category, image
+ *             or availability changed (id is the live item's ID)
+ ******************************************************************/
+struct MenuDelta {
+    QVector<FoodItem> added;
+    QVector<FoodItem> removed;
+    QVector<FoodItem> changed;
+
+    bool isEmpty() const { return added.isEmpty() && removed.isEmpty() && changed.isEmpty(); }
+};
+
+#endif // MENUTYPES_H
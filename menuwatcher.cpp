@@ -0,0 +1,163 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * menuwatcher.cpp
+ *
+ * This file implements MenuFileWatcher: debounced hot reload of the
+ * menu and coupon files, parsed and diffed off the GUI thread.
+ *
+ ******************************************************************/
+
+#include "menuwatcher.h"
+#include "orderengine.h"
+#include "tracer.h"
+#include <QFileInfo>
+#include <QMetaObject>
+
+/******************************************************************
+ * MenuFileWatcher::MenuFileWatcher --
+ *   Start watching both files and the directory that holds them.
+ *   The directory watch catches files that are replaced by rename
+ *   (QFileSystemWatcher drops a path once its file is removed).
+ ******************************************************************/
+MenuFileWatcher::MenuFileWatcher(const QVector<FoodItem> &fileItems,
+                                 const QString &menuFile,
+                                 const QString &couponFile,
+                                 QObject *parent)
+    : QObject(parent), fileItems(fileItems), menuFile(menuFile), couponFile(couponFile)
+{
+    parser.setMaxThreadCount(1);
+
+    menuTimer.setSingleShot(true);
+    menuTimer.setInterval(SETTLE_MS);
+    couponTimer.setSingleShot(true);
+    couponTimer.setInterval(SETTLE_MS);
+    connect(&menuTimer, &QTimer::timeout, this, &MenuFileWatcher::reloadMenu);
+    connect(&couponTimer, &QTimer::timeout, this, &MenuFileWatcher::reloadCoupons);
+
+    connect(&watcher, &QFileSystemWatcher::fileChanged, this, &MenuFileWatcher::onFileChanged);
+    connect(&watcher, &QFileSystemWatcher::directoryChanged, this, &MenuFileWatcher::onFileChanged);
+
+    watch(menuFile);
+    watch(couponFile);
+    watcher.addPath(QFileInfo(menuFile).absolutePath());
+    if (QFileInfo(couponFile).absolutePath() != QFileInfo(menuFile).absolutePath()) {
+        watcher.addPath(QFileInfo(couponFile).absolutePath());
+    }
+}
+
+/******************************************************************
+ * MenuFileWatcher::~MenuFileWatcher --
+ *   Wait for a running parse so it never posts to a dead object.
+ ******************************************************************/
+MenuFileWatcher::~MenuFileWatcher()
+{
+    parser.clear();
+    parser.waitForDone();
+}
+
+/******************************************************************
+ * MenuFileWatcher::onFileChanged --
+ *   Restart the matching debounce timer. For a directory change,
+ *   only files that were (re)created since the last notification
+ *   are reloaded; other files in the directory are ignored.
+ *
+ * Parameters:
+ *   path - changed file or directory
+ *
+ * Modifies:
+ *   - watcher: files re-added if they were replaced
+ *   - menuTimer / couponTimer: restarted
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MenuFileWatcher::onFileChanged(const QString &path)
+{
+    bool menuChanged = watch(menuFile) || path == menuFile;
+    bool couponChanged = watch(couponFile) || path == couponFile;
+
+    if (menuChanged) {
+        menuTimer.start();
+    }
+    if (couponChanged) {
+        couponTimer.start();
+    }
+}
+
+/******************************************************************
+ * MenuFileWatcher::reloadMenu --
+ *   Parse the menu file and diff it against its previous contents
+ *   on the worker thread, then emit the delta on this object's
+ *   thread. Tasks run one at a time, so fileItems needs no lock.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - fileItems: the new contents (on the worker thread)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MenuFileWatcher::reloadMenu()
+{
+    QString fileName = menuFile;
+
+    parser.start([this, fileName]() {
+        TRACE_SCOPE("reloadMenuFile");
+
+        QVector<FoodItem> items;
+        if (!OrderEngine::readMenuFile(fileName, items)) {
+            return;   // Deleted: keep serving the live menu
+        }
+
+        MenuDelta delta = diffMenu(fileItems, items);
+        QVector<FoodItem> previous = fileItems;
+        fileItems = items;
+        if (delta.isEmpty()) {
+            return;
+        }
+
+        QMetaObject::invokeMethod(this, [this, delta, previous, items]() {
+            emit menuDeltaReady(delta, previous, items);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/******************************************************************
+ * MenuFileWatcher::reloadCoupons --
+ *   Parse the coupon file on the worker thread and emit the table
+ *   on this object's thread.
+ *
+ * Parameters: none
+ * Modifies: nothing directly (see couponsReloaded)
+ * Returns: nothing
+ ******************************************************************/
+void MenuFileWatcher::reloadCoupons()
+{
+    QString fileName = couponFile;
+
+    parser.start([this, fileName]() {
+        QMap<QString, double> table;
+        if (!OrderEngine::readCouponFile(fileName, table)) {
+            return;
+        }
+
+        QMetaObject::invokeMethod(this, [this, table]() {
+            emit couponsReloaded(table);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/******************************************************************
+ * MenuFileWatcher::watch --
+ *   Add a file to the watcher if it exists and is not watched yet.
+ *
+ * Returns:
+ *   true if the file was (re)added, i.e. it appeared or was
+ *   replaced since it was last watched
+ ******************************************************************/
+bool MenuFileWatcher::watch(const QString &path)
+{
+    if (QFileInfo::exists(path) && !watcher.files().contains(path)) {
+        return watcher.addPath(path);
+    }
+    return false;
+}
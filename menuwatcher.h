@@ -0,0 +1,91 @@
+/******************************************************************
+ * menuwatcher.h
+ *
+ * This header declares MenuFileWatcher, which hot-reloads the menu
+ * and coupon files while the program is running. Head office can
+ * push a new price file mid-day without restarting the kiosk.
+ *
+ * When a watched file changes, the watcher waits briefly for the
+ * writer to finish, parses the file on a worker thread, diffs it
+ * against the contents it read last time and hands only the delta
+ * to the GUI thread. The delta describes the file, not the live
+ * menu, which may also hold unsaved manager edits (see
+ * rebaseMenuDelta()).
+ *
+ ******************************************************************/
+
+#ifndef MENUWATCHER_H
+#define MENUWATCHER_H
+
+#include <QFileSystemWatcher>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include "menutypes.h"
+#include "menustore.h"
+
+/******************************************************************
+ * MenuFileWatcher
+ *
+ * Signals are emitted on the thread that owns the watcher (the GUI
+ * thread), so receivers may touch widgets directly.
+ ******************************************************************/
+class MenuFileWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**************************************************************
+     * MenuFileWatcher(fileItems, menuFile, couponFile, parent)
+     *   - fileItems: current contents of menuFile (what the next
+     *     reload is diffed against)
+     *   - menuFile / couponFile: files to watch
+     **************************************************************/
+    MenuFileWatcher(const QVector<FoodItem> &fileItems,
+                    const QString &menuFile,
+                    const QString &couponFile,
+                    QObject *parent = nullptr);
+    ~MenuFileWatcher();
+
+    /**************************************************************
+     * Debounce delay: editors and copy tools often write a file in
+     * several steps, so reloads wait this long after the last
+     * change notification.
+     **************************************************************/
+    static const int SETTLE_MS = 300;
+
+signals:
+    /**************************************************************
+     * menuDeltaReady --
+     *   The menu file differs from the contents read last time:
+     *   delta turns previousFile into newFile. Not emitted when
+     *   the file did not change.
+     *
+     * couponsReloaded --
+     *   The coupon file was re-read.
+     **************************************************************/
+    void menuDeltaReady(const MenuDelta &delta,
+                        const QVector<FoodItem> &previousFile,
+                        const QVector<FoodItem> &newFile);
+    void couponsReloaded(const QMap<QString, double> &table);
+
+private slots:
+    void onFileChanged(const QString &path);
+    void reloadMenu();
+    void reloadCoupons();
+
+private:
+    QVector<FoodItem> fileItems;   // Last contents of menuFile; only parser tasks touch it after construction
+    QString menuFile;
+    QString couponFile;
+    QFileSystemWatcher watcher;
+    QTimer menuTimer;              // Debounce for menuFile
+    QTimer couponTimer;            // Debounce for couponFile
+    QThreadPool parser;            // One worker; parses run in order
+
+    bool watch(const QString &path);
+};
+
+#endif // MENUWATCHER_H
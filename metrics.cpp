@@ -0,0 +1,428 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * metrics.cpp
+ *
+ * This file implements the metrics registry: counters, log-linear
+ * latency histograms, Prometheus text rendering and the periodic
+ * file writer.
+ *
+ ******************************************************************/
+
+#include "metrics.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QtAlgorithms>
+#include <cmath>
+
+namespace {
+QMutex registryMutex;   // Guards registration only
+}
+
+// ========== HISTOGRAM ==========
+
+/******************************************************************
+ * LatencyHistogram::bucketIndex --
+ *   Map a value to its bucket slot.
+ *
+ * Parameters:
+ *   value - duration in nanoseconds
+ *
+ * Returns:
+ *   index in [0, BUCKET_COUNT); values past the last bucket are
+ *   clamped into it
+ ******************************************************************/
+int LatencyHistogram::bucketIndex(quint64 value)
+{
+    if (value < quint64(SUB_BUCKETS)) {
+        return int(value);
+    }
+
+    int exponent = 63 - int(qCountLeadingZeroBits(value));
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+
+    // Top SUB_BUCKET_BITS + 1 bits of the value, minus the leading 1
+    int shift = exponent - SUB_BUCKET_BITS;
+    int sub = int(value >> shift) - SUB_BUCKETS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + sub;
+}
+
+/******************************************************************
+ * LatencyHistogram::bucketUpperBound --
+ *   Largest value that maps to the given bucket.
+ *
+ * Parameters:
+ *   index - bucket slot
+ *
+ * Returns:
+ *   inclusive upper bound in nanoseconds
+ ******************************************************************/
+quint64 LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < SUB_BUCKETS) {
+        return quint64(index);
+    }
+
+    int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    int sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    return (quint64(SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+/******************************************************************
+ * LatencyHistogram::record --
+ *   Add one duration to the histogram. Negative durations (clock
+ *   oddities) are recorded as zero.
+ *
+ * Parameters:
+ *   nanoseconds - measured duration
+ *
+ * Modifies:
+ *   - one bucket, total, sum
+ *
+ * Returns: nothing
+ ******************************************************************/
+void LatencyHistogram::record(qint64 nanoseconds)
+{
+    quint64 value = nanoseconds > 0 ? quint64(nanoseconds) : 0;
+    buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+/******************************************************************
+ * LatencyHistogram::valueAtPercentile --
+ *   Walk the buckets until the cumulative count reaches the
+ *   requested rank.
+ *
+ * Parameters:
+ *   p - percentile in [0, 100]
+ *
+ * Returns:
+ *   bucket upper bound in nanoseconds, or 0 if nothing recorded
+ ******************************************************************/
+qint64 LatencyHistogram::valueAtPercentile(double p) const
+{
+    quint64 recorded = count();
+    if (recorded == 0) {
+        return 0;
+    }
+
+    quint64 rank = quint64(std::ceil(p / 100.0 * recorded));
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return qint64(bucketUpperBound(i));
+        }
+    }
+    return qint64(bucketUpperBound(BUCKET_COUNT - 1));
+}
+
+/******************************************************************
+ * LatencyHistogram::countBelow --
+ *   Number of values strictly below a power-of-two bound. Bucket
+ *   edges fall on powers of two, so this is exact.
+ *
+ * Parameters:
+ *   powerOfTwo - bound in nanoseconds
+ *
+ * Returns:
+ *   cumulative count
+ ******************************************************************/
+quint64 LatencyHistogram::countBelow(quint64 powerOfTwo) const
+{
+    int end = bucketIndex(powerOfTwo);
+    quint64 seen = 0;
+    for (int i = 0; i < end; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+    }
+    return seen;
+}
+
+// ========== REGISTRY ==========
+
+/******************************************************************
+ * MetricsRegistry::instance --
+ *   The process-wide registry.
+ ******************************************************************/
+MetricsRegistry &MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+/******************************************************************
+ * MetricsRegistry::counter / histogram --
+ *   Register a new metric. Metrics live for the whole process, so
+ *   they are never deleted.
+ *
+ * Parameters:
+ *   name - Prometheus metric name (string literal)
+ *   help - one-line description (string literal)
+ *
+ * Returns:
+ *   the new metric
+ ******************************************************************/
+MetricCounter &MetricsRegistry::counter(const char *name, const char *help)
+{
+    QMutexLocker locker(&registryMutex);
+    MetricCounter *metric = new MetricCounter(name, help);
+    counters.push_back(metric);
+    return *metric;
+}
+
+LatencyHistogram &MetricsRegistry::histogram(const char *name, const char *help)
+{
+    QMutexLocker locker(&registryMutex);
+    LatencyHistogram *metric = new LatencyHistogram(name, help);
+    histograms.push_back(metric);
+    return *metric;
+}
+
+/******************************************************************
+ * MetricsRegistry::renderPrometheus --
+ *   Format every metric. Histogram "le" buckets are emitted at
+ *   powers of two from about 1 us to about 70 s.
+ *
+ * Parameters: none
+ *
+ * Returns:
+ *   Prometheus text
+ ******************************************************************/
+QString MetricsRegistry::renderPrometheus() const
+{
+    QMutexLocker locker(&registryMutex);
+    QString text;
+
+    for (const MetricCounter *metric : counters) {
+        QString name = QString::fromLatin1(metric->name);
+        text += QString("# HELP %1 %2\n").arg(name, QString::fromLatin1(metric->help));
+        text += QString("# TYPE %1 counter\n").arg(name);
+        text += QString("%1 %2\n").arg(name).arg(metric->value());
+    }
+
+    for (const LatencyHistogram *metric : histograms) {
+        QString name = QString::fromLatin1(metric->name);
+        text += QString("# HELP %1 %2\n").arg(name, QString::fromLatin1(metric->help));
+        text += QString("# TYPE %1 histogram\n").arg(name);
+        for (int exponent = 10; exponent <= 36; ++exponent) {
+            quint64 bound = quint64(1) << exponent;
+            text += QString("%1_bucket{le=\"%2\"} %3\n")
+                        .arg(name)
+                        .arg(bound / 1e9, 0, 'g', 6)
+                        .arg(metric->countBelow(bound));
+        }
+        text += QString("%1_bucket{le=\"+Inf\"} %2\n").arg(name).arg(metric->count());
+        text += QString("%1_sum %2\n").arg(name).arg(metric->sumNs() / 1e9, 0, 'g', 9);
+        text += QString("%1_count %2\n").arg(name).arg(metric->count());
+    }
+
+    return text;
+}
+
+/******************************************************************
+ * MetricsRegistry::writeToFile --
+ *   Write the Prometheus text through QSaveFile so the file is
+ *   replaced in one step.
+ *
+ * Parameters:
+ *   fileName - output path
+ *
+ * Returns:
+ *   true if the file was written
+ ******************************************************************/
+bool MetricsRegistry::writeToFile(const QString &fileName) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out << renderPrometheus();
+    out.flush();
+    return file.commit();
+}
+
+// ========== CAFETERIA METRICS ==========
+
+namespace Metrics {
+
+MetricCounter &ordersTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_orders_total", "Paid orders (declined payments are not counted).");
+    return metric;
+}
+
+MetricCounter &itemsAddedTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_items_added_total", "Item units added to carts.");
+    return metric;
+}
+
+MetricCounter &couponHitsTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_coupon_hits_total", "Checkouts with a valid coupon code.");
+    return metric;
+}
+
+MetricCounter &couponMissesTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_coupon_misses_total", "Checkouts with an unknown coupon code.");
+    return metric;
+}
+
+MetricCounter &orderArenaBytesTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_order_arena_bytes_total", "Bytes allocated from per-order arenas (released at checkout).");
+    return metric;
+}
+
+MetricCounter &orderTapsTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_order_taps_total", "Clicks and key presses spent on completed orders.");
+    return metric;
+}
+
+MetricCounter &fastLaneOrdersTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_fast_lane_orders_total", "Completed checkouts taken in fast lane mode.");
+    return metric;
+}
+
+MetricCounter &fastLaneTapsTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_fast_lane_taps_total", "Clicks and key presses spent on fast lane orders.");
+    return metric;
+}
+
+MetricCounter &paymentDeclinesTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_payment_declines_total", "Orders whose payment authorization was declined.");
+    return metric;
+}
+
+MetricCounter &missingImagesTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_missing_images_total", "Distinct menu image paths that could not be loaded.");
+    return metric;
+}
+
+MetricCounter &soldOutRejectionsTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_sold_out_rejections_total", "Add-to-cart requests refused because the item was out of stock.");
+    return metric;
+}
+
+MetricCounter &guiStallsTotal()
+{
+    static MetricCounter &metric = MetricsRegistry::instance().counter(
+        "cafeteria_gui_stalls_total", "Times the GUI thread answered the stall watchdog later than its budget.");
+    return metric;
+}
+
+LatencyHistogram &checkoutLatency()
+{
+    static LatencyHistogram &metric = MetricsRegistry::instance().histogram(
+        "cafeteria_checkout_latency_seconds", "Time to price, print and clear an order.");
+    return metric;
+}
+
+LatencyHistogram &saveDuration()
+{
+    static LatencyHistogram &metric = MetricsRegistry::instance().histogram(
+        "cafeteria_menu_save_seconds", "Time to write the menu file.");
+    return metric;
+}
+
+LatencyHistogram &menuLoadDuration()
+{
+    static LatencyHistogram &metric = MetricsRegistry::instance().histogram(
+        "cafeteria_menu_load_seconds", "Time to load or build the menu.");
+    return metric;
+}
+
+LatencyHistogram &paymentLatency()
+{
+    static LatencyHistogram &metric = MetricsRegistry::instance().histogram(
+        "cafeteria_payment_authorization_seconds", "Time from payment request to approval or decline.");
+    return metric;
+}
+
+LatencyHistogram &pluKeystrokeLatency()
+{
+    static LatencyHistogram &metric = MetricsRegistry::instance().histogram(
+        "cafeteria_plu_keystroke_seconds", "Time to handle one PLU keypad key, including adding the item.");
+    return metric;
+}
+
+LatencyHistogram &guiStallDuration()
+{
+    static LatencyHistogram &metric = MetricsRegistry::instance().histogram(
+        "cafeteria_gui_stall_seconds", "Length of each GUI thread stall seen by the watchdog.");
+    return metric;
+}
+
+LatencyHistogram &upsellQueryDuration()
+{
+    static LatencyHistogram &metric = MetricsRegistry::instance().histogram(
+        "cafeteria_upsell_query_seconds", "Time to find and show the upsell suggestions for one cart change.");
+    return metric;
+}
+
+} // namespace Metrics
+
+// ========== FILE WRITER ==========
+
+/******************************************************************
+ * MetricsFileWriter::MetricsFileWriter --
+ *   Read the environment and start the dump timer if enabled.
+ *
+ * Parameters:
+ *   parent - owning QObject
+ ******************************************************************/
+MetricsFileWriter::MetricsFileWriter(QObject *parent)
+    : QObject(parent)
+{
+    fileName = qEnvironmentVariable("CAFETERIA_METRICS_FILE");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    int seconds = qEnvironmentVariableIntValue("CAFETERIA_METRICS_INTERVAL");
+    if (seconds <= 0) {
+        seconds = 15;
+    }
+
+    connect(&timer, &QTimer::timeout, this, &MetricsFileWriter::writeNow);
+    timer.start(seconds * 1000);
+}
+
+/******************************************************************
+ * MetricsFileWriter::writeNow --
+ *   Dump the registry immediately (also called on exit).
+ ******************************************************************/
+void MetricsFileWriter::writeNow()
+{
+    if (isEnabled()) {
+        MetricsRegistry::instance().writeToFile(fileName);
+    }
+}
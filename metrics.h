@@ -0,0 +1,178 @@
+/******************************************************************
+ * metrics.h
+ *
+ * This header declares the in-process metrics registry: lock-free
+ * counters and HDR-style (log-linear bucket) latency histograms,
+ * rendered in Prometheus text format. MetricsFileWriter dumps the
+ * registry to a file periodically so a kiosk fleet can be scraped
+ * without attaching a debugger.
+ *
+ ******************************************************************/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QtGlobal>
+#include <atomic>
+#include <vector>
+
+/******************************************************************
+ * MetricCounter
+ *
+ * Monotonic counter. increment() is a single relaxed atomic add,
+ * safe from any thread.
+ ******************************************************************/
+class MetricCounter
+{
+public:
+    MetricCounter(const char *name, const char *help) : name(name), help(help) {}
+
+    void increment(quint64 amount = 1) { count.fetch_add(amount, std::memory_order_relaxed); }
+    quint64 value() const { return count.load(std::memory_order_relaxed); }
+
+    const char *const name;
+    const char *const help;
+
+private:
+    std::atomic<quint64> count{0};
+};
+
+/******************************************************************
+ * LatencyHistogram
+ *
+ * HDR-style histogram of durations in nanoseconds. Values below 16
+ * get their own bucket; above that every power of two is split into
+ * 16 linear sub-buckets, so any recorded value is within 1/16
+ * (about 6%) of its bucket bound. record() touches three relaxed
+ * atomics and never locks.
+ ******************************************************************/
+class LatencyHistogram
+{
+public:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;  // 16
+    static const int MAX_EXPONENT = 42;                   // ~73 minutes in ns
+    static const int BUCKET_COUNT = SUB_BUCKETS + (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    LatencyHistogram(const char *name, const char *help) : name(name), help(help) {}
+
+    void record(qint64 nanoseconds);
+    quint64 count() const { return total.load(std::memory_order_relaxed); }
+    quint64 sumNs() const { return sum.load(std::memory_order_relaxed); }
+
+    /**************************************************************
+     * valueAtPercentile --
+     *   Upper bound (ns) of the bucket holding percentile p, 0-100.
+     *
+     * countBelow --
+     *   Number of recorded values strictly below the given bound,
+     *   which must be a power of two (used for Prometheus "le").
+     *
+     * bucketIndex / bucketUpperBound --
+     *   Mapping between values and bucket slots.
+     **************************************************************/
+    qint64 valueAtPercentile(double p) const;
+    quint64 countBelow(quint64 powerOfTwo) const;
+    static int bucketIndex(quint64 value);
+    static quint64 bucketUpperBound(int index);
+
+    const char *const name;
+    const char *const help;
+
+private:
+    std::atomic<quint64> buckets[BUCKET_COUNT] = {};
+    std::atomic<quint64> total{0};
+    std::atomic<quint64> sum{0};
+};
+
+/******************************************************************
+ * MetricsRegistry
+ *
+ * Owns every counter and histogram. Registration takes a lock and
+ * happens once per metric (see the Metrics namespace below);
+ * updating a metric never touches the registry.
+ ******************************************************************/
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry &instance();
+
+    MetricCounter &counter(const char *name, const char *help);
+    LatencyHistogram &histogram(const char *name, const char *help);
+
+    /**************************************************************
+     * renderPrometheus --
+     *   All metrics in Prometheus text exposition format 0.0.4.
+     *   Histograms are exported in seconds.
+     *
+     * writeToFile --
+     *   Writes renderPrometheus() to a file atomically (readers
+     *   never see a half-written file). Returns true on success.
+     **************************************************************/
+    QString renderPrometheus() const;
+    bool writeToFile(const QString &fileName) const;
+
+private:
+    MetricsRegistry() = default;
+
+    std::vector<MetricCounter *> counters;
+    std::vector<LatencyHistogram *> histograms;
+};
+
+/******************************************************************
+ * Metrics
+ *
+ * The cafeteria's metrics. Each accessor registers its metric the
+ * first time it is called and returns the same object afterwards.
+ ******************************************************************/
+namespace Metrics {
+MetricCounter &ordersTotal();          // Completed checkouts
+MetricCounter &itemsAddedTotal();      // Units added to carts
+MetricCounter &couponHitsTotal();      // Valid coupon codes applied
+MetricCounter &couponMissesTotal();    // Unknown coupon codes entered
+MetricCounter &orderArenaBytesTotal(); // Bytes served by order arenas
+MetricCounter &orderTapsTotal();       // Clicks/keys spent on completed orders
+MetricCounter &fastLaneOrdersTotal();  // Completed checkouts in fast lane mode
+MetricCounter &fastLaneTapsTotal();    // orderTapsTotal share of those orders
+MetricCounter &paymentDeclinesTotal(); // Orders whose payment was declined
+MetricCounter &missingImagesTotal();   // Menu image paths that could not be loaded
+MetricCounter &soldOutRejectionsTotal(); // Add-to-cart refused for lack of stock
+MetricCounter &guiStallsTotal();       // GUI thread over the stall budget
+LatencyHistogram &checkoutLatency();   // Pricing + receipt + clear
+LatencyHistogram &saveDuration();      // Writing the menu file
+LatencyHistogram &menuLoadDuration();  // Loading/building the menu
+LatencyHistogram &paymentLatency();    // Payment authorization round trip
+LatencyHistogram &pluKeystrokeLatency(); // Handling one PLU keypad key
+LatencyHistogram &guiStallDuration();  // Length of each GUI stall
+LatencyHistogram &upsellQueryDuration(); // Suggesting upsells for one cart change
+}
+
+/******************************************************************
+ * MetricsFileWriter
+ *
+ * Writes the registry to a file every few seconds while the event
+ * loop runs. Configured from the environment:
+ *   CAFETERIA_METRICS_FILE     - output file (disabled if unset)
+ *   CAFETERIA_METRICS_INTERVAL - seconds between writes (default 15)
+ ******************************************************************/
+class MetricsFileWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsFileWriter(QObject *parent = nullptr);
+
+    bool isEnabled() const { return !fileName.isEmpty(); }
+
+public slots:
+    void writeNow();
+
+private:
+    QString fileName;
+    QTimer timer;
+};
+
+#endif // METRICS_H
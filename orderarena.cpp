@@ -0,0 +1,199 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * orderarena.cpp
+ *
+ * This file implements OrderArena (per-order monotonic memory) and
+ * ArenaText (text formatting into that memory).
+ *
+ ******************************************************************/
+
+#include "orderarena.h"
+#include <cmath>
+#include <cstring>
+
+// ========== ORDER ARENA ==========
+
+/******************************************************************
+ * OrderArena::OrderArena --
+ *   Start with the inline buffer; overflow goes to the global heap
+ *   in growing chunks until release().
+ ******************************************************************/
+OrderArena::OrderArena()
+    : pool(initial, INLINE_BYTES, std::pmr::new_delete_resource())
+{
+}
+
+/******************************************************************
+ * OrderArena::release --
+ *   Drop every allocation in one step. The inline buffer is reused
+ *   by the next order; overflow chunks go back to the heap.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - pool: rewound
+ *   - allocated: reset to 0
+ *
+ * Returns: nothing
+ ******************************************************************/
+void OrderArena::release()
+{
+    pool.release();
+    allocated = 0;
+}
+
+void *OrderArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    allocated += bytes;
+    return pool.allocate(bytes, alignment);
+}
+
+void OrderArena::do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+{
+    // Monotonic: memory comes back in release()
+    Q_UNUSED(p);
+    Q_UNUSED(bytes);
+    Q_UNUSED(alignment);
+}
+
+bool OrderArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+// ========== ARENA TEXT ==========
+
+/******************************************************************
+ * ArenaText::ArenaText --
+ *   Reserve room up front: in a monotonic arena every regrowth
+ *   leaves the old buffer behind until release().
+ *
+ * Parameters:
+ *   resource     - arena to allocate from
+ *   reserveChars - expected length of the text
+ ******************************************************************/
+ArenaText::ArenaText(std::pmr::memory_resource *resource, std::size_t reserveChars)
+    : text(resource)
+{
+    text.reserve(reserveChars);
+}
+
+ArenaText &ArenaText::operator<<(const char *ascii)
+{
+    while (*ascii) {
+        text.push_back(char16_t(static_cast<unsigned char>(*ascii++)));
+    }
+    return *this;
+}
+
+ArenaText &ArenaText::operator<<(const QString &value)
+{
+    text.append(reinterpret_cast<const char16_t *>(value.utf16()), std::size_t(value.size()));
+    return *this;
+}
+
+void ArenaText::appendField(const char *ascii, int fieldWidth)
+{
+    char16_t chars[64];
+    std::size_t length = 0;
+    while (ascii[length] && length < sizeof(chars) / sizeof(chars[0])) {
+        chars[length] = char16_t(static_cast<unsigned char>(ascii[length]));
+        ++length;
+    }
+    appendPadded(chars, length, fieldWidth);
+}
+
+void ArenaText::appendField(const QString &value, int fieldWidth)
+{
+    appendPadded(reinterpret_cast<const char16_t *>(value.utf16()), std::size_t(value.size()), fieldWidth);
+}
+
+/******************************************************************
+ * ArenaText::appendField(int) --
+ *   Decimal integer, formatted by hand into a stack buffer.
+ ******************************************************************/
+void ArenaText::appendField(int value, int fieldWidth)
+{
+    char16_t digits[16];
+    std::size_t length = 0;
+    long long magnitude = value < 0 ? -static_cast<long long>(value) : value;
+    do {
+        digits[length++] = char16_t(u'0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        digits[length++] = u'-';
+    }
+
+    char16_t chars[16];
+    for (std::size_t i = 0; i < length; ++i) {
+        chars[i] = digits[length - 1 - i];
+    }
+    appendPadded(chars, length, fieldWidth);
+}
+
+/******************************************************************
+ * ArenaText::appendField(double) --
+ *   Fixed-point number with `precision` decimals. Rounded through
+ *   an integer so the result does not depend on the C locale.
+ ******************************************************************/
+void ArenaText::appendField(double value, int fieldWidth, int precision)
+{
+    long long scale = 1;
+    for (int i = 0; i < precision; ++i) {
+        scale *= 10;
+    }
+    bool negative = value < 0.0;
+    long long scaled = std::llround(std::fabs(value) * double(scale));
+
+    char16_t digits[32];
+    std::size_t length = 0;
+    for (int i = 0; i < precision; ++i) {
+        digits[length++] = char16_t(u'0' + scaled % 10);
+        scaled /= 10;
+    }
+    if (precision > 0) {
+        digits[length++] = u'.';
+    }
+    do {
+        digits[length++] = char16_t(u'0' + scaled % 10);
+        scaled /= 10;
+    } while (scaled > 0);
+    if (negative) {
+        digits[length++] = u'-';
+    }
+
+    char16_t chars[32];
+    for (std::size_t i = 0; i < length; ++i) {
+        chars[i] = digits[length - 1 - i];
+    }
+    appendPadded(chars, length, fieldWidth);
+}
+
+/******************************************************************
+ * ArenaText::toQString --
+ *   The only heap allocation made for the finished text.
+ ******************************************************************/
+QString ArenaText::toQString() const
+{
+    return QString::fromUtf16(text.data(), int(text.size()));
+}
+
+/******************************************************************
+ * ArenaText::appendPadded --
+ *   Append characters padded with spaces to |fieldWidth|, on the
+ *   left for positive widths and on the right for negative ones.
+ ******************************************************************/
+void ArenaText::appendPadded(const char16_t *chars, std::size_t length, int fieldWidth)
+{
+    std::size_t width = std::size_t(fieldWidth < 0 ? -fieldWidth : fieldWidth);
+    std::size_t padding = width > length ? width - length : 0;
+
+    if (fieldWidth > 0) {
+        text.append(padding, u' ');
+    }
+    text.append(chars, length);
+    if (fieldWidth < 0) {
+        text.append(padding, u' ');
+    }
+}
@@ -0,0 +1,91 @@
+/******************************************************************
+ * orderarena.h
+ *
+ * This header declares the per-order memory arena:
+ *   - OrderArena is a std::pmr memory resource backed by a
+ *     monotonic buffer. Everything allocated while one order is
+ *     being built (cart lines, cart and receipt text) comes from
+ *     it, and the whole arena is released at once after checkout
+ *     instead of returning many small blocks to the global heap.
+ *   - ArenaText builds UTF-16 text in the arena and converts it to
+ *     a QString once at the end, instead of creating a temporary
+ *     QString for every QString::arg() call.
+ *
+ ******************************************************************/
+
+#ifndef ORDERARENA_H
+#define ORDERARENA_H
+
+#include <QString>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+
+/******************************************************************
+ * OrderArena
+ *
+ * Allocations never free individually; release() drops them all.
+ * The first INLINE_BYTES come from a buffer inside the object, so a
+ * typical order does not touch the global heap at all.
+ ******************************************************************/
+class OrderArena : public std::pmr::memory_resource
+{
+public:
+    static const std::size_t INLINE_BYTES = 16 * 1024;
+
+    OrderArena();
+    OrderArena(const OrderArena &) = delete;
+    OrderArena &operator=(const OrderArena &) = delete;
+
+    /**************************************************************
+     * release --
+     *   Free everything allocated since the last release. Anything
+     *   still pointing into the arena must be gone by then.
+     *
+     * bytesAllocated --
+     *   Bytes handed out since the last release.
+     **************************************************************/
+    void release();
+    std::size_t bytesAllocated() const { return allocated; }
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+private:
+    alignas(std::max_align_t) unsigned char initial[INLINE_BYTES];
+    std::pmr::monotonic_buffer_resource pool;
+    std::size_t allocated = 0;
+};
+
+/******************************************************************
+ * ArenaText
+ *
+ * Append-only text buffer in an arena. Field widths follow
+ * QString::arg(): positive = right-aligned, negative = left-aligned.
+ * Numbers are always formatted with '.' as the decimal point, like
+ * QString::arg(double, ..., 'f', ...).
+ ******************************************************************/
+class ArenaText
+{
+public:
+    ArenaText(std::pmr::memory_resource *resource, std::size_t reserveChars);
+
+    ArenaText &operator<<(const char *ascii);
+    ArenaText &operator<<(const QString &text);
+
+    void appendField(const char *ascii, int fieldWidth);
+    void appendField(const QString &text, int fieldWidth);
+    void appendField(int value, int fieldWidth);
+    void appendField(double value, int fieldWidth, int precision);
+
+    QString toQString() const;
+
+private:
+    std::pmr::u16string text;
+
+    void appendPadded(const char16_t *chars, std::size_t length, int fieldWidth);
+};
+
+#endif // ORDERARENA_H
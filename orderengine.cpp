@@ -0,0 +1,989 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * orderengine.cpp
+ *
+ * This file implements the OrderEngine class: the part of the
+ * cafeteria ordering system that does not need any widgets.
+ *   - Menu and coupon file loading/saving
+ *   - Cart handling
+ *   - Coupon, tax and total calculation
+ *   - Receipt text formatting
+ *
+ ******************************************************************/
+
+#include "orderengine.h"
+#include "defaultmenu.h"
+#include "tracer.h"
+#include "metrics.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QDateTime>
+#include <cmath>
+using namespace std;
+
+/******************************************************************
+ * round2 --
+ *   Helper function that rounds a double to 2 decimal places.
+ *
+ *   ADAPTED FROM Elliots's receipt.cpp.
+ *   Original idea: format money values cleanly on a printed receipt.
+ *   Same logic is used in our Qt-based receipt display.
+ *
+ * Parameters:
+ *   num - double value to round
+ *
+ * Returns:
+ *   double rounded to 2 decimal places
+ ******************************************************************/
+static double round2(double num)
+{
+    return round(num * 100.0) / 100.0;
+}
+
+/******************************************************************
+ * OrderEngine::OrderEngine --
+ *   Constructor.
+ *
+ * Parameters:
+ *   store     - menu store to read from (may be shared with other
+ *               engines)
+ *   inventory - stock counters (may be shared with other engines)
+ *   coupons   - coupon table (may be shared with other engines)
+ ******************************************************************/
+OrderEngine::OrderEngine(std::shared_ptr<MenuStore> store, std::shared_ptr<Inventory> inventory,
+                         std::shared_ptr<CouponTable> coupons)
+    : store(store), stock(inventory), coupons(coupons), cart(&arena)
+{
+}
+
+/******************************************************************
+ * OrderEngine::~OrderEngine --
+ *   Destructor. Releases the cart's stock like clearCart(); the
+ *   inventory may outlive this engine (other terminals share it).
+ ******************************************************************/
+OrderEngine::~OrderEngine()
+{
+    clearCart();
+}
+
+// ========== FILE HANDLING ==========
+
+/******************************************************************
+ * OrderEngine::readMenuFile --
+ *   Parse a menu file, one item per line. Touches no engine state,
+ *   so the hot-reload watcher can call it on a worker thread.
+ *
+ * Format:
+ *   name,price,category[,imagePath[,availability]]
+ *
+ * Parameters:
+ *   fileName - path of the menu file
+ *   items    - receives the parsed items (cleared first)
+ *
+ * Returns:
+ *   true  - if the file exists (even if it could not be read)
+ *   false - if the file does not exist; items is left empty
+ ******************************************************************/
+bool OrderEngine::readMenuFile(const QString &fileName, QVector<FoodItem> &items)
+{
+    items.clear();
+    QFile file(fileName);
+
+    if (!file.exists()) {
+        return false;
+    }
+
+    // If the file exists, load items line by line
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream in(&file);
+        while (!in.atEnd()) {
+            QString line = in.readLine();
+            QStringList parts = line.split(',');
+            if (parts.size() >= 3) {
+                FoodItem item;
+                item.name = parts[0];
+                item.price = parts[1].toDouble();
+                item.category = parts[2];
+                item.imagePath = (parts.size() >= 4) ? parts[3] : "";
+                item.availability = (parts.size() >= 5) ? parts[4].trimmed() : "";
+                items.append(item);
+            }
+        }
+        file.close();
+    }
+    return true;
+}
+
+/******************************************************************
+ * OrderEngine::loadMenuItems --
+ *   Load menu items from the given file (see readMenuFile).
+ *
+ * Parameters:
+ *   fileName - path of the menu file
+ *
+ * Modifies:
+ *   - store: new snapshot with the items read from the file
+ *
+ * Returns:
+ *   true  - if the file exists (even if it could not be read)
+ *   false - if the file does not exist; the menu is left empty
+ ******************************************************************/
+bool OrderEngine::loadMenuItems(const QString &fileName)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QVector<FoodItem> items;
+
+    if (!readMenuFile(fileName, items)) {
+        store->replace(items);
+        return false;
+    }
+
+    // Publish the whole file as one new menu version
+    store->replace(items);
+    Metrics::menuLoadDuration().record(timer.nsecsElapsed());
+    return true;
+}
+
+/******************************************************************
+ * OrderEngine::loadDefaultMenuItems --
+ *   Fill the menu with the built-in default items. Used when the
+ *   menu file does not exist yet.
+ *
+ *   ADAPTED FROM Sai's "Food Menu.cpp":
+ *     - Original was a console menu with these same items and prices.
+ *     - The items now live in default_menu.csv, which the build
+ *       compiles into a constexpr table (defaultmenu.h), so nothing
+ *       is parsed and no item strings are allocated here.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - store: new snapshot with the default items
+ *
+ * Returns: nothing
+ ******************************************************************/
+void OrderEngine::loadDefaultMenuItems()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    store->replace(DefaultMenu::items());
+    Metrics::menuLoadDuration().record(timer.nsecsElapsed());
+}
+
+/******************************************************************
+ * OrderEngine::saveMenuItems --
+ *   Save all current menu items to the given file, one per line.
+ *
+ * Format:
+ *   name,price,category,imagePath[,availability]
+ *   The availability field is only written for scheduled items, so
+ *   a menu without schedules keeps the original four-field format.
+ *
+ * Parameters:
+ *   fileName - path of the menu file
+ *
+ * Modifies:
+ *   - fileName: overwritten with current menu contents
+ *
+ * Returns:
+ *   true if the file was written
+ ******************************************************************/
+bool OrderEngine::saveMenuItems(const QString &fileName) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    // Write one consistent version even if the menu is edited meanwhile
+    MenuSnapshotPtr menu = store->snapshot();
+    QTextStream out(&file);
+    for (const FoodItem &item : menu->items) {
+        out << item.name << "," << item.price << "," << item.category << "," << item.imagePath;
+        if (!item.availability.isEmpty()) {
+            out << "," << item.availability;
+        }
+        out << "\n";
+    }
+    file.close();
+
+    Metrics::saveDuration().record(timer.nsecsElapsed());
+    return true;
+}
+
+/******************************************************************
+ * OrderEngine::readCouponFile --
+ *   Parse a coupon file. Touches no engine state, so it is safe on
+ *   a worker thread.
+ *
+ * Format:
+ *   CODE,discount
+ *
+ * Parameters:
+ *   fileName - path of the coupon file
+ *   table    - receives the coupon codes (cleared first)
+ *
+ * Returns:
+ *   true  - if the file exists
+ *   false - if the file does not exist; table is left empty
+ ******************************************************************/
+bool OrderEngine::readCouponFile(const QString &fileName, QMap<QString, double> &table)
+{
+    table.clear();
+    QFile file(fileName);
+
+    if (!file.exists()) {
+        return false;
+    }
+
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream in(&file);
+        while (!in.atEnd()) {
+            QString line = in.readLine();
+            QStringList parts = line.split(',');
+            if (parts.size() == 2) {
+                table[parts[0]] = parts[1].toDouble();
+            }
+        }
+        file.close();
+    }
+    return true;
+}
+
+/******************************************************************
+ * OrderEngine::loadCoupons --
+ *   Load coupon codes and discount percentages from file (see
+ *   readCouponFile).
+ *
+ * Parameters:
+ *   fileName - path of the coupon file
+ *
+ * Modifies:
+ *   - coupons: cleared and then filled with entries
+ *
+ * Returns:
+ *   true  - if the file exists
+ *   false - if the file does not exist; coupons is left empty
+ ******************************************************************/
+bool OrderEngine::loadCoupons(const QString &fileName)
+{
+    return readCouponFile(fileName, *coupons);
+}
+
+/******************************************************************
+ * OrderEngine::loadDefaultCoupons --
+ *   Fill the coupon table with the built-in coupon codes.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - coupons: cleared and then filled with the defaults
+ *
+ * Returns: nothing
+ ******************************************************************/
+void OrderEngine::loadDefaultCoupons()
+{
+    coupons->clear();
+    (*coupons)["10OFF"]   = 0.10;  // 10% off
+    (*coupons)["20OFF"]   = 0.20;  // 20% off
+    (*coupons)["SAVE15"]  = 0.15;  // 15% off
+    (*coupons)["STUDENT"] = 0.25;  // 25% off
+}
+
+/******************************************************************
+ * OrderEngine::saveCoupons --
+ *   Save the coupon table to the given file, one code per line.
+ *
+ * Parameters:
+ *   fileName - path of the coupon file
+ *
+ * Modifies:
+ *   - fileName: overwritten with the coupon table
+ *
+ * Returns:
+ *   true if the file was written
+ ******************************************************************/
+bool OrderEngine::saveCoupons(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    for (auto it = coupons->constBegin(); it != coupons->constEnd(); ++it) {
+        out << it.key() << "," << it.value() << "\n";
+    }
+    file.close();
+    return true;
+}
+
+// ========== MENU ACCESS ==========
+
+/******************************************************************
+ * OrderEngine::findMenuItem --
+ *   Look up a menu item by its name in the current snapshot
+ *   (hash lookup in the snapshot's catalog columns).
+ *
+ * Parameters:
+ *   name - exact item name
+ *   item - receives a copy of the item if found
+ *
+ * Returns:
+ *   true if the item is on the menu
+ ******************************************************************/
+bool OrderEngine::findMenuItem(const QString &name, FoodItem &item) const
+{
+    MenuSnapshotPtr menu = store->snapshot();
+    int row = menu->columns.rowOf(name);
+    if (row < 0) {
+        return false;
+    }
+    item = menu->items[row];
+    return true;
+}
+
+/******************************************************************
+ * OrderEngine::addMenuItem --
+ *   Append a new item to the menu.
+ *
+ * Parameters:
+ *   item - item to add
+ *
+ * Modifies:
+ *   - store: new snapshot with the item appended
+ *
+ * Returns: nothing
+ ******************************************************************/
+void OrderEngine::addMenuItem(const FoodItem &item)
+{
+    store->update([&item](QVector<FoodItem> &items, CategoryRegistry &categories) {
+        items.append(item);
+        categories.addItem(item);
+        return true;
+    });
+}
+
+/******************************************************************
+ * OrderEngine::removeMenuItem --
+ *   Remove the first menu item with the given name.
+ *
+ * Parameters:
+ *   name - item name
+ *
+ * Modifies:
+ *   - store: new snapshot without the item
+ *
+ * Returns:
+ *   true if an item was removed
+ ******************************************************************/
+bool OrderEngine::removeMenuItem(const QString &name)
+{
+    bool removed = false;
+    store->update([&name, &removed](QVector<FoodItem> &items, CategoryRegistry &categories) {
+        for (int i = 0; i < items.size(); ++i) {
+            if (items[i].name == name) {
+                categories.removeItem(items[i]);
+                items.removeAt(i);
+                removed = true;
+                break;
+            }
+        }
+        return removed;
+    });
+    return removed;
+}
+
+/******************************************************************
+ * OrderEngine::setItemPrice --
+ *   Change the price of the named menu item.
+ *
+ * Parameters:
+ *   name  - item name
+ *   price - new price in dollars
+ *
+ * Modifies:
+ *   - store: new snapshot with the price changed
+ *
+ * Returns:
+ *   true if the item was found
+ ******************************************************************/
+bool OrderEngine::setItemPrice(const QString &name, double price)
+{
+    bool found = false;
+    store->update([&name, price, &found](QVector<FoodItem> &items, CategoryRegistry &categories) {
+        for (FoodItem &item : items) {
+            if (item.name == name) {
+                categories.changePrice(item.category, item.price, price);
+                item.price = price;
+                found = true;
+                break;
+            }
+        }
+        return found;
+    });
+    return found;
+}
+
+/******************************************************************
+ * OrderEngine::applyMenuDelta --
+ *   Apply a hot-reload delta (see diffMenu in menustore.h).
+ *
+ * Parameters:
+ *   delta - items added, removed and changed in the menu file
+ *
+ * Modifies:
+ *   - store: one new snapshot, unless the delta is empty
+ *
+ * Returns: nothing
+ ******************************************************************/
+void OrderEngine::applyMenuDelta(const MenuDelta &delta)
+{
+    store->applyDelta(delta);
+}
+
+/******************************************************************
+ * OrderEngine::setCoupons --
+ *   Replace the coupon table (coupon file hot reload).
+ *
+ * Parameters:
+ *   table - coupon codes mapped to discount fractions
+ *
+ * Modifies:
+ *   - coupons: replaced
+ *
+ * Returns:
+ *   true if the table actually changed
+ ******************************************************************/
+bool OrderEngine::setCoupons(const QMap<QString, double> &table)
+{
+    if (table == *coupons) {
+        return false;
+    }
+    *coupons = table;
+    return true;
+}
+
+// ========== BULK MANAGER OPERATIONS ==========
+
+/******************************************************************
+ * OrderEngine::readPriceSheet --
+ *   Parse a CSV price sheet (a partial menu).
+ *
+ * Format:
+ *   name,price[,category[,imagePath[,availability]]]
+ *   Lines whose price is not a number (e.g. a header row) are
+ *   skipped. An empty category, image or availability means "keep
+ *   the current one".
+ *
+ * Parameters:
+ *   fileName - path of the CSV file
+ *   rows     - receives the parsed rows (cleared first)
+ *
+ * Returns:
+ *   true if the file could be opened
+ ******************************************************************/
+bool OrderEngine::readPriceSheet(const QString &fileName, QVector<FoodItem> &rows)
+{
+    rows.clear();
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QStringList parts = in.readLine().split(',');
+        if (parts.size() < 2) {
+            continue;
+        }
+
+        bool ok = false;
+        FoodItem row;
+        row.name = parts[0].trimmed();
+        row.price = parts[1].trimmed().toDouble(&ok);
+        if (!ok || row.name.isEmpty() || row.price < 0.0) {
+            continue;
+        }
+        row.category = (parts.size() >= 3) ? parts[2].trimmed() : "";
+        row.imagePath = (parts.size() >= 4) ? parts[3].trimmed() : "";
+        row.availability = (parts.size() >= 5) ? parts[4].trimmed() : "";
+        rows.append(row);
+    }
+    file.close();
+    return true;
+}
+
+/******************************************************************
+ * OrderEngine::priceSheetDelta --
+ *   Turn price sheet rows into a delta against the current menu.
+ *   Rows for existing items become changes (blank fields keep the
+ *   current value); rows for new items become additions if they
+ *   name a category. Items not in the sheet are left alone.
+ *
+ * Parameters:
+ *   rows - output of readPriceSheet()
+ *
+ * Returns:
+ *   the delta; apply with applyMenuDelta()
+ ******************************************************************/
+MenuDelta OrderEngine::priceSheetDelta(const QVector<FoodItem> &rows) const
+{
+    MenuSnapshotPtr menu = store->snapshot();
+
+    QVector<FoodItem> incoming = menu->items;
+    for (const FoodItem &row : rows) {
+        int liveRow = menu->columns.rowOf(row.name);
+        if (liveRow >= 0) {
+            FoodItem &item = incoming[liveRow];
+            item.price = row.price;
+            if (!row.category.isEmpty()) {
+                item.category = row.category;
+            }
+            if (!row.imagePath.isEmpty()) {
+                item.imagePath = row.imagePath;
+            }
+            if (!row.availability.isEmpty()) {
+                item.availability = row.availability;
+            }
+        } else if (!row.category.isEmpty()) {
+            incoming.append(row);
+        }
+    }
+
+    // incoming = current menu + sheet, so the diff has no removals
+    return diffMenu(menu->items, incoming);
+}
+
+/******************************************************************
+ * OrderEngine::categoryPriceDelta --
+ *   Raise (or lower) every price in a category by a percentage,
+ *   rounded to the cent.
+ *
+ * Parameters:
+ *   category - category name
+ *   percent  - e.g. 5.0 for +5%, -10.0 for -10%
+ *
+ * Returns:
+ *   the delta; apply with applyMenuDelta()
+ ******************************************************************/
+MenuDelta OrderEngine::categoryPriceDelta(const QString &category, double percent) const
+{
+    MenuSnapshotPtr menu = store->snapshot();
+    MenuDelta delta;
+
+    // Walks the compact category column, not the whole item records
+    const QVector<int> rows = menu->columns.rowsInCategory(menu->columns.categoryId(category));
+    delta.changed.reserve(rows.size());
+    for (int row : rows) {
+        FoodItem item = menu->items[row];
+        double newPrice = qMax(0.0, round2(item.price * (1.0 + percent / 100.0)));
+        if (toCents(newPrice) != toCents(item.price)) {
+            item.price = newPrice;
+            delta.changed.append(item);
+        }
+    }
+    return delta;
+}
+
+/******************************************************************
+ * OrderEngine::removalDelta --
+ *   Delta that removes the named items.
+ *
+ * Parameters:
+ *   names - item names (unknown names are ignored)
+ *
+ * Returns:
+ *   the delta; apply with applyMenuDelta()
+ ******************************************************************/
+MenuDelta OrderEngine::removalDelta(const QStringList &names) const
+{
+    MenuSnapshotPtr menu = store->snapshot();
+    MenuDelta delta;
+    for (const QString &name : names) {
+        int row = menu->columns.rowOf(name);
+        if (row >= 0) {
+            delta.removed.append(menu->items[row]);
+        }
+    }
+    return delta;
+}
+
+// ========== CART ==========
+
+/******************************************************************
+ * OrderEngine::addToCart --
+ *   Add a quantity of a menu item to the cart. If the item is
+ *   already in the cart its quantity is increased instead.
+ *
+ * Parameters:
+ *   name     - name of the menu item
+ *   quantity - how many to add (must be > 0)
+ *
+ * Modifies:
+ *   - cart: item added or quantity increased
+ *   - inventory: quantity reserved
+ *
+ * Returns:
+ *   true  - if the item was added
+ *   false - if the item is not on the menu, not enough is in stock
+ *           or quantity <= 0
+ ******************************************************************/
+bool OrderEngine::addToCart(const QString &name, int quantity)
+{
+    TRACE_SCOPE("OrderEngine::addToCart");
+
+    if (quantity <= 0) {
+        return false;
+    }
+
+    FoodItem item;
+    if (!findMenuItem(name, item)) {
+        return false;
+    }
+
+    // Taken from stock now, so two carts cannot both get the last one
+    bool tracked = false;
+    if (!stock->reserve(item.id, quantity, &tracked)) {
+        return false;
+    }
+    int stockUnits = tracked ? quantity : 0;
+
+    // Check if item already exists in cart
+    for (OrderItem &orderItem : cart) {
+        if (orderItem.name == name) {
+            orderItem.quantity += quantity;
+            orderItem.stockUnits += stockUnits;
+            Metrics::itemsAddedTotal().increment(quantity);
+            return true;
+        }
+    }
+
+    // If not in cart, add a brand new OrderItem
+    OrderItem newItem;
+    newItem.itemId = item.id;
+    newItem.name = item.name;
+    newItem.price = item.price;
+    newItem.quantity = quantity;
+    newItem.stockUnits = stockUnits;
+    cart.push_back(newItem);
+
+    Metrics::itemsAddedTotal().increment(quantity);
+    return true;
+}
+
+/******************************************************************
+ * OrderEngine::clearCart --
+ *   Remove all items from the cart, give their stock back and end
+ *   the order.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - inventory: cart quantities released
+ *   - cart: cleared
+ *   - arena: released
+ *
+ * Returns: nothing
+ ******************************************************************/
+void OrderEngine::clearCart()
+{
+    for (const OrderItem &line : cart) {
+        stock->release(line.itemId, line.stockUnits);
+    }
+    endOrder();
+}
+
+/******************************************************************
+ * OrderEngine::endOrder --
+ *   Empty the cart without touching stock: the order arena (cart
+ *   storage, cart and receipt text) is released in one step.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - cart: cleared
+ *   - arena: released
+ *
+ * Returns: nothing
+ ******************************************************************/
+void OrderEngine::endOrder()
+{
+    // The cart's storage must be gone before the arena it lives in
+    {
+        std::pmr::vector<OrderItem> finished(&arena);
+        cart.swap(finished);
+    }
+
+    Metrics::orderArenaBytesTotal().increment(arena.bytesAllocated());
+    arena.release();
+}
+
+/******************************************************************
+ * OrderEngine::cartSubtotal --
+ *   Sum of price * quantity over all cart lines.
+ *
+ * Parameters: none
+ *
+ * Returns:
+ *   subtotal in dollars (not rounded)
+ ******************************************************************/
+double OrderEngine::cartSubtotal() const
+{
+    double subtotal = 0.0;
+    for (const OrderItem &item : cart) {
+        subtotal += item.price * item.quantity;
+    }
+    return subtotal;
+}
+
+// ========== COUPONS AND CHECKOUT ==========
+
+/******************************************************************
+ * OrderEngine::normalizeCouponCode --
+ *   Coupon codes are stored in upper case; customers may type them
+ *   in any case and with surrounding spaces.
+ *
+ * Parameters:
+ *   code - code as typed
+ *
+ * Returns:
+ *   trimmed, upper-case code
+ ******************************************************************/
+QString OrderEngine::normalizeCouponCode(const QString &code)
+{
+    return code.trimmed().toUpper();
+}
+
+/******************************************************************
+ * OrderEngine::isValidCoupon --
+ *   Check whether a coupon code exists.
+ *
+ * Parameters:
+ *   code - coupon code (any case)
+ *
+ * Returns:
+ *   true if the code is in the coupon table
+ ******************************************************************/
+bool OrderEngine::isValidCoupon(const QString &code) const
+{
+    return coupons->contains(normalizeCouponCode(code));
+}
+
+/******************************************************************
+ * OrderEngine::calculateTotals --
+ *   Calculate subtotal, applies the coupon (if valid), adds tax on
+ *   the discounted amount, and computes the final total.
+ *
+ * Parameters:
+ *   couponCode - coupon to apply, or empty for none. Unknown codes
+ *                are ignored.
+ *
+ * Returns:
+ *   OrderTotals for the current cart
+ ******************************************************************/
+OrderTotals OrderEngine::calculateTotals(const QString &couponCode) const
+{
+    TRACE_SCOPE("OrderEngine::calculateTotals");
+
+    OrderTotals totals;
+    totals.subtotal = cartSubtotal();
+
+    double discountPercent = 0.0;
+    QString code = normalizeCouponCode(couponCode);
+    if (!code.isEmpty() && coupons->contains(code)) {
+        discountPercent = coupons->value(code);
+        totals.couponCode = code;
+    }
+
+    // Calculate discount and apply it
+    totals.discount = totals.subtotal * discountPercent;
+    double afterDiscount = totals.subtotal - totals.discount;
+
+    // Add tax based on discounted amount
+    totals.tax = afterDiscount * TAX_RATE;
+
+    // Final total
+    totals.total = afterDiscount + totals.tax;
+    return totals;
+}
+
+/******************************************************************
+ * OrderEngine::buildReceiptText --
+ *   Build a text receipt showing each item, the subtotal, discount,
+ *   tax, and total.
+ *
+ *   ADAPTED FROM Elliot's receipt.cpp:
+ *     - Kept the idea of listing items and showing subtotal, tax,
+ *       and total with clean 2-decimal formatting.
+ *     - REMOVED his separate 7% PST. This program only applies
+ *       a single 5% tax based on BC tax on food (TAX_RATE).
+ *     - Uses round2() for all money values (same logic as their
+ *       console version).
+ *     - Adds date and time at the bottom using QDateTime instead
+ *       of <ctime> since we are using Qt.
+ *
+ * Parameters:
+ *   totals - values returned by calculateTotals()
+ *
+ * Returns:
+ *   receipt text
+ ******************************************************************/
+QString OrderEngine::buildReceiptText(const OrderTotals &totals) const
+{
+    TRACE_SCOPE("OrderEngine::buildReceiptText");
+
+    // Round all monetary values to 2 decimal places (adapted from receipt.cpp)
+    double subtotal = round2(totals.subtotal);
+    double discount = round2(totals.discount);
+    double tax      = round2(totals.tax);
+    double total    = round2(totals.total);
+
+    // Formatted in the order arena: no temporary QString per row
+    ArenaText receipt(&arena, 512 + cart.size() * 48);
+    receipt << "========================================\n";
+    receipt << "           CAFETERIA RECEIPT\n";
+    receipt << "========================================\n\n";
+
+    // Header row similar in spirit to teammate's receipt (Item / Price)
+    receipt.appendField("Qty", -5);
+    receipt.appendField("Item", -20);
+    receipt.appendField("Price", 10);
+    receipt << "\n";
+    receipt << "----------------------------------------\n";
+
+    // List all items in the cart (one row per OrderItem)
+    for (const OrderItem &item : cart) {
+        double itemTotal = item.price * item.quantity;
+
+        // Each row: quantity, name (trimmed to 20 chars), line total
+        receipt.appendField(item.quantity, -5);
+        receipt.appendField(item.name.left(20), -20);
+        receipt.appendField(itemTotal, 10, 2);
+        receipt << "\n";
+    }
+
+    receipt << "----------------------------------------\n";
+
+    // Show subtotal
+    receipt.appendField("Subtotal:", -25);
+    receipt.appendField(subtotal, 10, 2);
+    receipt << "\n";
+
+    // Show discount if any
+    if (discount > 0.0) {
+        QString label = QString("Discount (%1):").arg(totals.couponCode);
+        receipt.appendField(label, -25);
+        receipt << "-";
+        receipt.appendField(discount, 9, 2);
+        receipt << "\n";
+    }
+
+    // NOTE: Only 5% tax is used (TAX_RATE).
+    // Teammate's receipt.cpp had both GST (5%) and PST (7%).
+    receipt.appendField("Tax (5%):", -25);
+    receipt.appendField(tax, 10, 2);
+    receipt << "\n";
+
+    receipt << "----------------------------------------\n";
+    receipt.appendField("TOTAL:", -25);
+    receipt.appendField(total, 10, 2);
+    receipt << "\n";
+    receipt << "========================================\n\n";
+
+    // Add date and time at the bottom (Qt version of ctime in receipt.cpp)
+    QDateTime now = QDateTime::currentDateTime();
+    receipt << "Date and Time: " << now.toString("yyyy-MM-dd hh:mm:ss") << "\n";
+    receipt << "========================================\n";
+
+    return receipt.toQString();
+}
+
+/******************************************************************
+ * OrderEngine::buildCartText --
+ *   Format the cart for the on-screen cart box, in the order
+ *   arena.
+ *
+ * Parameters: none
+ *
+ * Returns:
+ *   cart summary with one block per line item and the subtotal
+ ******************************************************************/
+QString OrderEngine::buildCartText() const
+{
+    TRACE_SCOPE("OrderEngine::buildCartText");
+
+    ArenaText text(&arena, 128 + cart.size() * 64);
+    text << "========== SHOPPING CART ==========\n\n";
+
+    if (cart.empty()) {
+        text << "Your cart is empty.\n";
+        return text.toQString();
+    }
+
+    // List each item with quantity, price, and line total
+    double subtotal = 0.0;
+    for (const OrderItem &item : cart) {
+        double itemTotal = item.price * item.quantity;
+        subtotal += itemTotal;
+        text.appendField(item.quantity, 0);
+        text << " x " << item.name << "\n  @ $";
+        text.appendField(item.price, 0, 2);
+        text << " each = $";
+        text.appendField(itemTotal, 0, 2);
+        text << "\n\n";
+    }
+    text << "-----------------------------------\n";
+    text << "Subtotal: $";
+    text.appendField(subtotal, 0, 2);
+    text << "\n";
+
+    return text.toQString();
+}
+
+/******************************************************************
+ * OrderEngine::checkout --
+ *   Complete an order: price the cart, build the receipt text and
+ *   clear the cart for the next customer. Unknown coupon codes are
+ *   ignored (and counted as coupon misses).
+ *
+ * Parameters:
+ *   couponCode  - coupon as entered, or empty for none
+ *   receiptText - receives the receipt for the order
+ *
+ * Modifies:
+ *   - inventory: cart quantities committed
+ *   - cart: cleared
+ *   - coupon and checkout latency metrics (cafeteria_orders_total
+ *     is counted by the caller once the order is paid)
+ *
+ * Returns:
+ *   the totals that were charged
+ ******************************************************************/
+OrderTotals OrderEngine::checkout(const QString &couponCode, QString &receiptText)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!couponCode.trimmed().isEmpty()) {
+        if (isValidCoupon(couponCode)) {
+            Metrics::couponHitsTotal().increment();
+        } else {
+            Metrics::couponMissesTotal().increment();
+        }
+    }
+
+    OrderTotals totals = calculateTotals(couponCode);
+    receiptText = buildReceiptText(totals);
+    for (const OrderItem &line : cart) {
+        stock->commit(line.itemId, line.stockUnits);
+    }
+    endOrder();
+
+    Metrics::checkoutLatency().record(timer.nsecsElapsed());
+    return totals;
+}
@@ -0,0 +1,186 @@
+/******************************************************************
+ * orderengine.h
+ *
+ * This header declares the OrderEngine class, which holds the
+ * cafeteria ordering logic (menu, coupons, cart, tax and receipt
+ * text) without depending on any widgets. The GUI (MainWindow) and
+ * the headless replay mode (OrderReplay) both use it, so the same
+ * code path is measured in load tests and used at the kiosk.
+ *
+ ******************************************************************/
+
+#ifndef ORDERENGINE_H
+#define ORDERENGINE_H
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include "menutypes.h"
+#include "menustore.h"
+#include "orderarena.h"
+#include "inventory.h"
+
+// Coupon codes mapped to discount % (0.10 = 10%)
+using CouponTable = QMap<QString, double>;
+
+/******************************************************************
+ * OrderEngine
+ *
+ * Widget-free ordering logic. Owns the current cart, reads the menu
+ * from a MenuStore and the coupons from a CouponTable, reserves
+ * stock in an Inventory, and knows how to price and print an order.
+ ******************************************************************/
+class OrderEngine
+{
+public:
+    /**************************************************************
+     * Constructor
+     *
+     * OrderEngine(store, inventory, coupons)
+     *   - Uses the given menu store, inventory and coupon table,
+     *     or private ones by default. Several engines (terminals)
+     *     in one thread may share all three.
+     *
+     * ~OrderEngine()
+     *   - Gives the stock of a cart that was never checked out
+     *     back to the (possibly shared) inventory.
+     **************************************************************/
+    explicit OrderEngine(std::shared_ptr<MenuStore> store = std::make_shared<MenuStore>(),
+                         std::shared_ptr<Inventory> inventory = std::make_shared<Inventory>(),
+                         std::shared_ptr<CouponTable> coupons = std::make_shared<CouponTable>());
+    ~OrderEngine();
+
+    /**************************************************************
+     * Tax rate (5% for British Columbia food tax)
+     **************************************************************/
+    static constexpr double TAX_RATE = 0.05;
+
+    /**************************************************************
+     * Menu and coupon data
+     *
+     * readMenuFile()         - parses a menu file without touching
+     *                          the engine (safe on worker threads).
+     * readCouponFile()       - same, for a coupon file.
+     * loadMenuItems()        - reads menu data from a file. Returns
+     *                          false if the file does not exist.
+     * loadDefaultMenuItems() - fills the menu with the compiled-in
+     *                          default items (default_menu.csv).
+     * saveMenuItems()        - writes the current menu to a file.
+     * loadCoupons()          - reads coupon codes from a file. Returns
+     *                          false if the file does not exist.
+     * loadDefaultCoupons()   - fills the built-in coupon codes.
+     * saveCoupons()          - writes the coupon table to a file.
+     * setCoupons()           - replaces the coupon table (hot
+     *                          reload). Returns false if unchanged.
+     **************************************************************/
+    static bool readMenuFile(const QString &fileName, QVector<FoodItem> &items);
+    static bool readCouponFile(const QString &fileName, QMap<QString, double> &table);
+    bool loadMenuItems(const QString &fileName);
+    void loadDefaultMenuItems();
+    bool saveMenuItems(const QString &fileName) const;
+    bool loadCoupons(const QString &fileName);
+    void loadDefaultCoupons();
+    bool saveCoupons(const QString &fileName) const;
+    bool setCoupons(const QMap<QString, double> &table);
+
+    /**************************************************************
+     * Menu access and manager edits
+     *
+     * menuSnapshot()  - the current immutable menu version. Keep
+     *                   the pointer for a consistent view.
+     * menuStore()     - the store the engine reads from.
+     * inventory()     - the stock counters the cart reserves from.
+     * findMenuItem()  - copies the named item into `item`. Returns
+     *                   false if it is not on the menu.
+     * addMenuItem()   - appends a new item to the menu.
+     * removeMenuItem()- removes the item with the given name.
+     * setItemPrice()  - changes the price of the named item.
+     * applyMenuDelta()- applies a hot-reload delta in one update.
+     *
+     * Each edit publishes a new menu snapshot.
+     **************************************************************/
+    MenuSnapshotPtr menuSnapshot() const { return store->snapshot(); }
+    std::shared_ptr<MenuStore> menuStore() const { return store; }
+    std::shared_ptr<Inventory> inventory() const { return stock; }
+    bool findMenuItem(const QString &name, FoodItem &item) const;
+    void addMenuItem(const FoodItem &item);
+    bool removeMenuItem(const QString &name);
+    bool setItemPrice(const QString &name, double price);
+    void applyMenuDelta(const MenuDelta &delta);
+
+    /**************************************************************
+     * Bulk manager operations
+     *
+     * Each returns a MenuDelta that the caller applies with
+     * applyMenuDelta(), so a bulk change is one menu update no
+     * matter how many items it touches.
+     *
+     * readPriceSheet()     - parses a CSV price sheet (name,price
+     *                        [,category[,imagePath[,availability]]]).
+     * priceSheetDelta()    - changes/additions for the sheet rows.
+     * categoryPriceDelta() - every price in a category scaled by
+     *                        a percentage.
+     * removalDelta()       - removes the named items.
+     **************************************************************/
+    static bool readPriceSheet(const QString &fileName, QVector<FoodItem> &rows);
+    MenuDelta priceSheetDelta(const QVector<FoodItem> &rows) const;
+    MenuDelta categoryPriceDelta(const QString &category, double percent) const;
+    MenuDelta removalDelta(const QStringList &names) const;
+
+    /**************************************************************
+     * Cart handling
+     *
+     * cartItems()  - items currently in the cart (stored in the
+     *                order arena).
+     * addToCart()  - reserves stock and adds quantity of the named
+     *                item, merging with an existing cart line.
+     *                Returns false if the item is not on the menu
+     *                or not enough is in stock.
+     * clearCart()  - returns the cart's stock, empties the cart and
+     *                releases the order arena.
+     * cartSubtotal()- sum of price * quantity for the cart.
+     * buildCartText()- formats the cart for the cart text box.
+     **************************************************************/
+    const std::pmr::vector<OrderItem> &cartItems() const { return cart; }
+    bool addToCart(const QString &name, int quantity);
+    void clearCart();
+    double cartSubtotal() const;
+    QString buildCartText() const;
+
+    /**************************************************************
+     * Coupons and checkout
+     *
+     * normalizeCouponCode() - coupon codes are case-insensitive.
+     * isValidCoupon()       - true if the (normalized) code exists.
+     * calculateTotals()     - prices the current cart with an
+     *                         optional coupon and TAX_RATE.
+     * buildReceiptText()    - formats the current cart and totals
+     *                         as a plain-text receipt.
+     * checkout()            - prices the cart, builds the receipt,
+     *                         commits the cart's stock, clears the
+     *                         cart (releasing the order arena) and
+     *                         updates the coupon and checkout
+     *                         latency metrics. The caller counts
+     *                         the order once it is paid.
+     **************************************************************/
+    static QString normalizeCouponCode(const QString &code);
+    bool isValidCoupon(const QString &code) const;
+    OrderTotals calculateTotals(const QString &couponCode) const;
+    QString buildReceiptText(const OrderTotals &totals) const;
+    OrderTotals checkout(const QString &couponCode, QString &receiptText);
+
+private:
+    std::shared_ptr<MenuStore> store;  // Published menu snapshots (may be shared)
+    std::shared_ptr<Inventory> stock;  // Stock counters (may be shared)
+    std::shared_ptr<CouponTable> coupons;  // Coupon codes (may be shared)
+    mutable OrderArena arena;      // Per-order memory; released by clearCart()
+    std::pmr::vector<OrderItem> cart;  // Items currently in customer's cart (in arena)
+
+    void endOrder();
+};
+
+#endif // ORDERENGINE_H
@@ -0,0 +1,369 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * orderreplay.cpp
+ *
+ * This file implements the OrderReplay class: headless replay of
+ * recorded ordering sessions for load and regression testing.
+ *   - Reads JSONL or plain-text scripts
+ *   - Replays them against OrderEngine with no widgets
+ *   - Reports throughput and p50/p99 latency per operation type
+ *
+ ******************************************************************/
+
+#include "orderreplay.h"
+#include "alloctracker.h"
+#include "metrics.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+using namespace std;
+
+/******************************************************************
+ * OrderReplay::run --
+ *   Entry point for headless mode. See orderreplay.h for options.
+ *
+ * Parameters:
+ *   arguments - command line (QCoreApplication::arguments())
+ *
+ * Modifies:
+ *   - engine, ops and all latency samples
+ *
+ * Returns:
+ *   0 on success, 1 on bad arguments or unreadable script
+ ******************************************************************/
+int OrderReplay::run(const QStringList &arguments)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Cafeteria Ordering System - headless order replay");
+    QCommandLineOption replayOption("replay", "Replay script (JSONL or plain text, '-' for stdin).", "file");
+    QCommandLineOption menuOption("menu", "Menu file.", "file", "menu_items.txt");
+    QCommandLineOption couponOption("coupons", "Coupon file.", "file", "coupons.txt");
+    QCommandLineOption repeatOption("repeat", "Replay the script this many times.", "n", "1");
+    parser.addOption(replayOption);
+    parser.addOption(menuOption);
+    parser.addOption(couponOption);
+    parser.addOption(repeatOption);
+
+    if (!parser.parse(arguments) || !parser.isSet(replayOption)) {
+        err << parser.errorText() << "\n" << parser.helpText();
+        return 1;
+    }
+
+    int repeat = parser.value(repeatOption).toInt();
+    if (repeat < 1) {
+        repeat = 1;
+    }
+
+    // Same data files as the GUI; built-in defaults if missing.
+    // Nothing is written back in headless mode.
+    if (!engine.loadMenuItems(parser.value(menuOption))) {
+        engine.loadDefaultMenuItems();
+    }
+    if (!engine.loadCoupons(parser.value(couponOption))) {
+        engine.loadDefaultCoupons();
+    }
+
+    if (!loadScript(parser.value(replayOption), err)) {
+        return 1;
+    }
+
+    // Reserve sample storage up front so the timed loop does not
+    // measure vector growth
+    addSamples.reserve(ops.size() * repeat);
+    couponSamples.reserve(ops.size() * repeat);
+    checkoutSamples.reserve(ops.size() * repeat);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < repeat; ++i) {
+        replayOnce();
+    }
+    qint64 elapsedNs = timer.nsecsElapsed();
+
+    printReport(elapsedNs, out);
+    return 0;
+}
+
+/******************************************************************
+ * OrderReplay::loadScript --
+ *   Read the whole script into ops before anything is timed.
+ *
+ * Parameters:
+ *   fileName - script path, or "-" for standard input
+ *   err      - stream for error messages
+ *
+ * Modifies:
+ *   - ops: filled with parsed operations
+ *
+ * Returns:
+ *   true if the script was read and every line parsed
+ ******************************************************************/
+bool OrderReplay::loadScript(const QString &fileName, QTextStream &err)
+{
+    QFile file;
+    bool opened;
+    if (fileName == "-") {
+        opened = file.open(stdin, QIODevice::ReadOnly | QIODevice::Text);
+    } else {
+        file.setFileName(fileName);
+        opened = file.open(QIODevice::ReadOnly | QIODevice::Text);
+    }
+
+    if (!opened) {
+        err << "Cannot open replay script: " << fileName << "\n";
+        return false;
+    }
+
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        ++lineNumber;
+
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        ReplayOp op;
+        QString error;
+        if (!parseLine(line, lineNumber, op, error)) {
+            err << fileName << ":" << lineNumber << ": " << error << "\n";
+            return false;
+        }
+        ops.append(op);
+    }
+    file.close();
+    return true;
+}
+
+/******************************************************************
+ * OrderReplay::parseLine --
+ *   Parse one script line. Lines starting with '{' are JSON, all
+ *   others are plain text ("add <qty> <item name>", "coupon <code>",
+ *   "checkout", "clear").
+ *
+ * Parameters:
+ *   line       - trimmed, non-empty script line
+ *   lineNumber - line number stored in the op
+ *   op         - receives the parsed operation
+ *   error      - receives a message if parsing fails
+ *
+ * Returns:
+ *   true if the line was parsed
+ ******************************************************************/
+bool OrderReplay::parseLine(const QString &line, int lineNumber, ReplayOp &op, QString &error) const
+{
+    QString name;
+    QString text;
+    int quantity = 1;
+
+    if (line.startsWith('{')) {
+        QJsonParseError jsonError;
+        QJsonDocument doc = QJsonDocument::fromJson(line.toUtf8(), &jsonError);
+        if (!doc.isObject()) {
+            error = "invalid JSON: " + jsonError.errorString();
+            return false;
+        }
+        QJsonObject obj = doc.object();
+        name = obj.value("op").toString().toLower();
+        text = (name == "coupon") ? obj.value("code").toString() : obj.value("item").toString();
+        quantity = obj.value("qty").toInt(1);
+    } else {
+        QStringList words = line.simplified().split(' ');
+        name = words.takeFirst().toLower();
+        if (name == "add" && !words.isEmpty()) {
+            bool ok;
+            quantity = words.first().toInt(&ok);
+            if (ok) {
+                words.removeFirst();
+            } else {
+                quantity = 1;
+            }
+        }
+        text = words.join(' ');
+    }
+
+    op.text = text;
+    op.quantity = quantity;
+    op.line = lineNumber;
+
+    if (name == "add") {
+        op.type = ReplayOp::Add;
+        if (text.isEmpty()) {
+            error = "add needs an item name";
+            return false;
+        }
+    } else if (name == "coupon") {
+        op.type = ReplayOp::Coupon;
+    } else if (name == "checkout") {
+        op.type = ReplayOp::Checkout;
+    } else if (name == "clear") {
+        op.type = ReplayOp::Clear;
+    } else {
+        error = "unknown operation '" + name + "'";
+        return false;
+    }
+    return true;
+}
+
+/******************************************************************
+ * OrderReplay::replayOnce --
+ *   Execute every parsed op once, in order, timing each one. A
+ *   coupon op applies to the next checkout only, the same as the
+ *   coupon dialog in the GUI.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - engine cart, latency samples and counters
+ *
+ * Returns: nothing
+ ******************************************************************/
+void OrderReplay::replayOnce()
+{
+    QElapsedTimer timer;
+    QString pendingCoupon;
+
+    for (const ReplayOp &op : ops) {
+        timer.start();
+        switch (op.type) {
+        case ReplayOp::Add: {
+            ALLOC_SCOPE("replay: add");
+            if (!engine.addToCart(op.text, op.quantity)) {
+                ++unknownItems;
+            }
+            addSamples.append(timer.nsecsElapsed());
+            break;
+        }
+
+        case ReplayOp::Coupon: {
+            ALLOC_SCOPE("replay: coupon");
+            // Kept even if unknown: checkout ignores it and counts
+            // the miss, the same as the GUI coupon dialog
+            pendingCoupon = op.text;
+            if (!engine.isValidCoupon(op.text)) {
+                ++invalidCoupons;
+            }
+            couponSamples.append(timer.nsecsElapsed());
+            break;
+        }
+
+        case ReplayOp::Checkout: {
+            ALLOC_SCOPE("replay: checkout");
+            if (!engine.cartItems().empty()) {
+                // Same work as the GUI checkout minus the dialog
+                QString receipt;
+                engine.checkout(pendingCoupon, receipt);
+                Metrics::ordersTotal().increment();   // No payment step: paid at once
+                ++orderCount;
+            }
+            pendingCoupon.clear();
+            checkoutSamples.append(timer.nsecsElapsed());
+            break;
+        }
+
+        case ReplayOp::Clear: {
+            ALLOC_SCOPE("replay: clear");
+            engine.clearCart();
+            clearSamples.append(timer.nsecsElapsed());
+            break;
+        }
+        }
+    }
+
+    // Do not carry a half-finished order into the next repetition
+    engine.clearCart();
+}
+
+/******************************************************************
+ * OrderReplay::percentile --
+ *   Nearest-rank percentile.
+ *
+ * Parameters:
+ *   sorted - samples sorted ascending
+ *   p      - percentile in [0, 100]
+ *
+ * Returns:
+ *   the sample at that rank, or 0 if there are no samples
+ ******************************************************************/
+qint64 OrderReplay::percentile(const QVector<qint64> &sorted, double p)
+{
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+    int count = static_cast<int>(sorted.size());
+    int rank = static_cast<int>(p / 100.0 * count + 0.5);
+    rank = qBound(1, rank, count);
+    return sorted[rank - 1];
+}
+
+/******************************************************************
+ * OrderReplay::printReport --
+ *   Print overall throughput and a latency table (microseconds)
+ *   with one row per operation type plus an "all" row, followed by
+ *   the allocation table when allocation tracking is on.
+ *
+ * Parameters:
+ *   elapsedNs - wall time of the whole replay in nanoseconds
+ *   out       - output stream
+ *
+ * Returns: nothing
+ ******************************************************************/
+void OrderReplay::printReport(qint64 elapsedNs, QTextStream &out) const
+{
+    QVector<qint64> all;
+    all << addSamples << couponSamples << checkoutSamples << clearSamples;
+
+    double seconds = elapsedNs / 1e9;
+    double opsPerSec = seconds > 0.0 ? all.size() / seconds : 0.0;
+    double ordersPerSec = seconds > 0.0 ? orderCount / seconds : 0.0;
+
+    out << QString("Replayed %1 operations (%2 orders) in %3 ms\n")
+               .arg(all.size())
+               .arg(orderCount)
+               .arg(elapsedNs / 1e6, 0, 'f', 3);
+    out << QString("Throughput: %1 ops/s, %2 orders/s\n\n")
+               .arg(opsPerSec, 0, 'f', 0)
+               .arg(ordersPerSec, 0, 'f', 0);
+
+    out << QString("%1%2%3%4%5\n")
+               .arg("op", -10)
+               .arg("count", 10)
+               .arg("p50 (us)", 12)
+               .arg("p99 (us)", 12)
+               .arg("max (us)", 12);
+
+    auto row = [&out](const QString &label, QVector<qint64> samples) {
+        sort(samples.begin(), samples.end());
+        qint64 maxNs = samples.isEmpty() ? 0 : samples.last();
+        out << QString("%1%2%3%4%5\n")
+                   .arg(label, -10)
+                   .arg(samples.size(), 10)
+                   .arg(percentile(samples, 50) / 1e3, 12, 'f', 2)
+                   .arg(percentile(samples, 99) / 1e3, 12, 'f', 2)
+                   .arg(maxNs / 1e3, 12, 'f', 2);
+    };
+    row("add", addSamples);
+    row("coupon", couponSamples);
+    row("checkout", checkoutSamples);
+    row("clear", clearSamples);
+    row("all", all);
+
+    if (unknownItems > 0 || invalidCoupons > 0) {
+        out << QString("\nUnknown items: %1, invalid coupons: %2\n")
+                   .arg(unknownItems)
+                   .arg(invalidCoupons);
+    }
+
+    // Allocation budget per operation (CAFETERIA_ALLOC_TRACK=1)
+    if (AllocTracker::isEnabled()) {
+        out << "\nHeap allocations per operation:\n" << AllocTracker::report();
+    }
+    out.flush();
+}
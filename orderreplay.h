@@ -0,0 +1,111 @@
+/******************************************************************
+ * orderreplay.h
+ *
+ * This header declares the OrderReplay class, which runs the
+ * cafeteria ordering logic headless (no widgets). It reads a script
+ * of add-to-cart, coupon and checkout operations, executes them as
+ * fast as possible against an OrderEngine, and reports throughput
+ * plus p50/p99 latency. Used to replay a recorded lunch rush
+ * against new builds before rollout.
+ *
+ ******************************************************************/
+
+#ifndef ORDERREPLAY_H
+#define ORDERREPLAY_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QTextStream>
+#include "orderengine.h"
+
+/******************************************************************
+ * ReplayOp
+ *
+ * One operation read from a replay script.
+ *
+ * Members:
+ *   type     - what to do (add to cart, coupon, checkout, clear)
+ *   text     - item name for Add, coupon code for Coupon
+ *   quantity - how many to add (Add only)
+ *   line     - line number in the script (for error messages)
+ ******************************************************************/
+struct ReplayOp {
+    enum Type { Add, Coupon, Checkout, Clear };
+
+    Type type;
+    QString text;
+    int quantity;
+    int line;
+};
+
+/******************************************************************
+ * OrderReplay
+ *
+ * Headless replay runner used by main() when "--replay" is given.
+ *
+ * Script format (one operation per line, from a file or "-" for
+ * standard input). Each line is either JSON:
+ *   {"op":"add","item":"Fries","qty":2}
+ *   {"op":"coupon","code":"10OFF"}
+ *   {"op":"checkout"}
+ *   {"op":"clear"}
+ * or plain text:
+ *   add 2 Fries
+ *   coupon 10OFF
+ *   checkout
+ *   clear
+ * Blank lines and lines starting with '#' are ignored.
+ ******************************************************************/
+class OrderReplay
+{
+public:
+    /**************************************************************
+     * run --
+     *   Parses the command line, loads the menu/coupon files, reads
+     *   the script, replays it and prints the report.
+     *
+     *   Options:
+     *     --replay <file>   script to replay ("-" for stdin)
+     *     --menu <file>     menu file (default menu_items.txt)
+     *     --coupons <file>  coupon file (default coupons.txt)
+     *     --repeat <n>      replay the whole script n times
+     *
+     *   Returns the process exit code (0 on success).
+     **************************************************************/
+    int run(const QStringList &arguments);
+
+private:
+    OrderEngine engine;       // Ordering logic under test
+    QVector<ReplayOp> ops;    // Parsed script
+
+    /**************************************************************
+     * Latency samples in nanoseconds, one per executed operation,
+     * kept per operation type so each can be reported separately.
+     **************************************************************/
+    QVector<qint64> addSamples;
+    QVector<qint64> couponSamples;
+    QVector<qint64> checkoutSamples;
+    QVector<qint64> clearSamples;
+
+    int orderCount = 0;       // Completed checkouts
+    int unknownItems = 0;     // Add operations for items not on the menu
+    int invalidCoupons = 0;   // Coupon operations with unknown codes
+
+    /**************************************************************
+     * Helper functions (internal use only)
+     *
+     * loadScript()   - reads and parses the whole script into ops.
+     * parseLine()    - parses one JSON or plain-text script line.
+     * replayOnce()   - executes every op once, recording latency.
+     * printReport()  - prints throughput and latency percentiles.
+     * percentile()   - nearest-rank percentile of sorted samples.
+     **************************************************************/
+    bool loadScript(const QString &fileName, QTextStream &err);
+    bool parseLine(const QString &line, int lineNumber, ReplayOp &op, QString &error) const;
+    void replayOnce();
+    void printReport(qint64 elapsedNs, QTextStream &out) const;
+    static qint64 percentile(const QVector<qint64> &sorted, double p);
+};
+
+#endif // ORDERREPLAY_H
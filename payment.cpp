@@ -0,0 +1,97 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * payment.cpp
+ *
+ * This file implements MockPaymentService. The delay is a single-
+ * shot timer, so waiting for "the bank" costs no thread and never
+ * blocks the event loop.
+ *
+ ******************************************************************/
+
+#include "payment.h"
+#include <QRandomGenerator>
+#include <QTimer>
+
+/******************************************************************
+ * MockPaymentService::configureFromEnvironment --
+ *   Apply CAFETERIA_PAYMENT_* settings (unset values keep their
+ *   defaults).
+ *
+ * Parameters: none
+ * Modifies:
+ *   - latencyMs, jitterMs, declineAbove
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MockPaymentService::configureFromEnvironment()
+{
+    bool ok = false;
+    int latency = qEnvironmentVariableIntValue("CAFETERIA_PAYMENT_LATENCY_MS", &ok);
+    if (!ok) {
+        latency = latencyMs;
+    }
+    int jitter = qEnvironmentVariableIntValue("CAFETERIA_PAYMENT_JITTER_MS", &ok);
+    if (!ok) {
+        jitter = jitterMs;
+    }
+    setLatency(latency, jitter);
+
+    double limit = qEnvironmentVariable("CAFETERIA_PAYMENT_DECLINE_ABOVE").toDouble(&ok);
+    if (ok) {
+        setDeclineAbove(limit);
+    }
+}
+
+/******************************************************************
+ * MockPaymentService::setLatency --
+ *   Set the simulated authorization delay. Negative values are
+ *   treated as 0.
+ ******************************************************************/
+void MockPaymentService::setLatency(int latencyMs, int jitterMs)
+{
+    this->latencyMs = qMax(0, latencyMs);
+    this->jitterMs = qMax(0, jitterMs);
+}
+
+/******************************************************************
+ * MockPaymentService::authorize --
+ *   Schedule the result. Approved payments get a random six-digit
+ *   authorization code.
+ *
+ * Parameters:
+ *   request - order number and amount
+ *
+ * Modifies: nothing (authorized() is emitted later)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void MockPaymentService::authorize(const PaymentRequest &request)
+{
+    int delay = latencyMs;
+    if (jitterMs > 0) {
+        delay += int(QRandomGenerator::global()->bounded(jitterMs + 1));
+    }
+
+    PaymentResult result;
+    result.orderId = request.orderId;
+    if (declineAbove > 0.0 && request.amount > declineAbove) {
+        result.message = QString("Amount over the $%1 limit").arg(declineAbove, 0, 'f', 2);
+    } else {
+        result.approved = true;
+        result.authCode = QString("MOCK-%1").arg(QRandomGenerator::global()->bounded(1000000), 6, 10, QChar('0'));
+    }
+
+    QTimer::singleShot(delay, this, [this, result]() {
+        emit authorized(result);
+    });
+}
+
+/******************************************************************
+ * MockPaymentService::name --
+ *   e.g. "Mock payments (800 ms)".
+ ******************************************************************/
+QString MockPaymentService::name() const
+{
+    return QString("Mock payments (%1 ms)").arg(latencyMs);
+}
@@ -0,0 +1,113 @@
+/******************************************************************
+ * payment.h
+ *
+ * This header declares the payment interface used by checkout:
+ *   - PaymentService is the pluggable authorization interface (a
+ *     card terminal driver, a payment gateway client, ...).
+ *   - MockPaymentService is a local stand-in that approves orders
+ *     after a configurable delay, for development and load tests.
+ *
+ * Authorization is asynchronous: authorize() returns at once and
+ * the service emits authorized() later on the same thread, so the
+ * GUI keeps running while the terminal or network is busy.
+ *
+ ******************************************************************/
+
+#ifndef PAYMENT_H
+#define PAYMENT_H
+
+#include <QObject>
+#include <QString>
+#include <QtGlobal>
+
+/******************************************************************
+ * PaymentRequest
+ *
+ * Members:
+ *   orderId - checkout order number (echoed in the result)
+ *   amount  - amount to charge in dollars
+ ******************************************************************/
+struct PaymentRequest {
+    quint64 orderId = 0;
+    double amount = 0.0;
+};
+
+/******************************************************************
+ * PaymentResult
+ *
+ * Members:
+ *   orderId  - order the result belongs to
+ *   approved - true if the payment went through
+ *   authCode - authorization code (approved payments)
+ *   message  - reason shown to the cashier (declined payments)
+ ******************************************************************/
+struct PaymentResult {
+    quint64 orderId = 0;
+    bool approved = false;
+    QString authCode;
+    QString message;
+};
+
+/******************************************************************
+ * PaymentService
+ *
+ * Implementations must emit authorized() exactly once per request,
+ * on the thread that owns the service, and never block in
+ * authorize(). Several requests may be outstanding at once.
+ ******************************************************************/
+class PaymentService : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PaymentService(QObject *parent = nullptr) : QObject(parent) {}
+
+    /**************************************************************
+     * authorize --
+     *   Start authorizing a payment. Returns immediately.
+     *
+     * name --
+     *   Short description for the status bar / logs.
+     **************************************************************/
+    virtual void authorize(const PaymentRequest &request) = 0;
+    virtual QString name() const = 0;
+
+signals:
+    void authorized(const PaymentResult &result);
+};
+
+/******************************************************************
+ * MockPaymentService
+ *
+ * Approves every payment after latencyMs plus a random extra delay
+ * of up to jitterMs. Payments above declineAbove dollars are
+ * declined (0 = never decline).
+ *
+ * configureFromEnvironment() reads:
+ *   CAFETERIA_PAYMENT_LATENCY_MS    (default 800)
+ *   CAFETERIA_PAYMENT_JITTER_MS     (default 0)
+ *   CAFETERIA_PAYMENT_DECLINE_ABOVE (default 0)
+ ******************************************************************/
+class MockPaymentService : public PaymentService
+{
+    Q_OBJECT
+
+public:
+    static const int DEFAULT_LATENCY_MS = 800;
+
+    explicit MockPaymentService(QObject *parent = nullptr) : PaymentService(parent) {}
+
+    void configureFromEnvironment();
+    void setLatency(int latencyMs, int jitterMs = 0);
+    void setDeclineAbove(double amount) { declineAbove = amount; }
+
+    void authorize(const PaymentRequest &request) override;
+    QString name() const override;
+
+private:
+    int latencyMs = DEFAULT_LATENCY_MS;
+    int jitterMs = 0;
+    double declineAbove = 0.0;
+};
+
+#endif // PAYMENT_H
@@ -0,0 +1,143 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * pluindex.cpp
+ *
+ * This file implements the runtime half of PluIndex: codes for
+ * items that are not on the default menu.
+ *
+ ******************************************************************/
+
+#include "pluindex.h"
+#include "tracer.h"
+#include <QVector>
+
+namespace {
+
+/******************************************************************
+ * defaultCodeOf --
+ *   Fixed code of a default item (compile-time name index), or 0.
+ ******************************************************************/
+int defaultCodeOf(const QString &name)
+{
+    int index = DefaultMenu::indexOf(name);
+    return index >= 0 ? DefaultMenu::ENTRIES[index].plu : 0;
+}
+
+/******************************************************************
+ * stableHash --
+ *   FNV-1a over the UTF-16 name. qHash() is seeded per process, so
+ *   it would give an item a different code after every restart.
+ ******************************************************************/
+quint32 stableHash(const QString &name)
+{
+    quint32 hash = 2166136261u;
+    for (QChar c : name) {
+        hash ^= c.unicode();
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+/******************************************************************
+ * PluIndex::sync --
+ *   Rebuild the code tables for a new menu version. Items that had
+ *   a runtime code in the previous version keep it (by item ID).
+ *   Other items without a default code get FIRST_RUNTIME_CODE +
+ *   hash(name) % range, probing upwards past taken codes, so an
+ *   item usually gets the same code after a restart too. Codes of
+ *   removed items are freed.
+ *
+ * Parameters:
+ *   menu - current menu snapshot
+ *
+ * Modifies:
+ *   - runtimeNames, codes, runtimeCodes, syncedVersion
+ *
+ * Returns: nothing
+ ******************************************************************/
+void PluIndex::sync(const MenuSnapshotPtr &menu)
+{
+    if (synced && menu->version == syncedVersion) {
+        return;
+    }
+    TRACE_SCOPE("PluIndex::sync");
+
+    runtimeNames.clear();
+    codes.clear();
+
+    QVector<const FoodItem *> needCodes;
+    for (const FoodItem &item : menu->items) {
+        int code = defaultCodeOf(item.name);
+        if (code != 0) {
+            codes.insert(item.name, code);
+        } else {
+            needCodes.append(&item);
+        }
+    }
+
+    // Codes handed out before stay with their items
+    QHash<int, int> kept;
+    for (const FoodItem *item : needCodes) {
+        int code = runtimeCodes.value(item->id, 0);
+        if (code != 0 && !codes.contains(item->name) && !runtimeNames.contains(code)) {
+            runtimeNames.insert(code, item->name);
+            codes.insert(item->name, code);
+            kept.insert(item->id, code);
+        }
+    }
+
+    const int range = Plu::LAST_RUNTIME_CODE - Plu::FIRST_RUNTIME_CODE + 1;
+    for (const FoodItem *item : needCodes) {
+        if (codes.contains(item->name)) {
+            continue;   // Kept above, or same name twice: the first item wins
+        }
+        int offset = int(stableHash(item->name) % quint32(range));
+        int probes = 0;
+        while (runtimeNames.contains(Plu::FIRST_RUNTIME_CODE + offset) && probes < range) {
+            offset = (offset + 1) % range;
+            ++probes;
+        }
+        if (probes == range) {
+            break;   // Every runtime code is taken
+        }
+        runtimeNames.insert(Plu::FIRST_RUNTIME_CODE + offset, item->name);
+        codes.insert(item->name, Plu::FIRST_RUNTIME_CODE + offset);
+        kept.insert(item->id, Plu::FIRST_RUNTIME_CODE + offset);
+    }
+    runtimeCodes = kept;   // Removed items give their codes back
+
+    syncedVersion = menu->version;
+    synced = true;
+}
+
+/******************************************************************
+ * PluIndex::resolve --
+ *   Default codes go through the compile-time perfect hash, others
+ *   through the runtime table.
+ *
+ * Parameters:
+ *   code - PLU code as typed
+ *
+ * Returns:
+ *   item name, or empty if no item has this code
+ ******************************************************************/
+QString PluIndex::resolve(int code) const
+{
+    int index = Plu::findDefault(code);
+    if (index >= 0) {
+        return DefaultMenu::text(DefaultMenu::ENTRIES[index].name);
+    }
+    return runtimeNames.value(code);
+}
+
+/******************************************************************
+ * PluIndex::codeFor --
+ *   Code shown next to an item (tooltips), 0 if none.
+ ******************************************************************/
+int PluIndex::codeFor(const QString &name) const
+{
+    return codes.value(name, 0);
+}
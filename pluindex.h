@@ -0,0 +1,170 @@
+/******************************************************************
+ * pluindex.h
+ *
+ * This header declares the PLU (price look-up) code index used by
+ * keypad fast entry. Cashiers type a short number instead of
+ * picking a category and a list row.
+ *
+ * Codes come from two tables:
+ *   - The default menu items have fixed codes (1xx mains, 2xx
+ *     sides, 3xx beverages, 4xx desserts) from default_menu.csv.
+ *     Their perfect hash is built by the compiler, so resolving
+ *     one of these codes is one multiply, one shift and one
+ *     compare.
+ *   - Items added by the manager get codes from 500 up, assigned
+ *     at run time from a hash of the name and kept in a QHash.
+ *     An item keeps its code, by item ID, for as long as it is on
+ *     the menu, so adding or removing other items never changes
+ *     a code the cashiers have learned.
+ *
+ ******************************************************************/
+
+#ifndef PLUINDEX_H
+#define PLUINDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QtGlobal>
+#include <array>
+#include <cstdint>
+#include "menustore.h"
+#include "defaultmenu.h"
+
+namespace Plu {
+
+constexpr int DEFAULT_COUNT = DefaultMenu::COUNT;
+constexpr int FIRST_RUNTIME_CODE = 500;   // Manager-added items
+constexpr int LAST_RUNTIME_CODE = 999;
+
+// ========== COMPILE-TIME PERFECT HASH ==========
+
+constexpr int HASH_BITS = 7;
+constexpr int HASH_SLOTS = 1 << HASH_BITS;
+static_assert(DEFAULT_COUNT < HASH_SLOTS / 2, "Too many default PLU codes for the hash table");
+
+/******************************************************************
+ * hashSlot --
+ *   Multiplicative hash of a code into [0, HASH_SLOTS).
+ ******************************************************************/
+constexpr int hashSlot(int code, std::uint32_t multiplier)
+{
+    return int((std::uint32_t(code) * multiplier) >> (32 - HASH_BITS));
+}
+
+/******************************************************************
+ * isPerfect --
+ *   True if no two default codes share a slot for this multiplier.
+ ******************************************************************/
+constexpr bool isPerfect(std::uint32_t multiplier)
+{
+    bool used[HASH_SLOTS] = {};
+    for (int i = 0; i < DEFAULT_COUNT; ++i) {
+        int slot = hashSlot(DefaultMenu::ENTRIES[i].plu, multiplier);
+        if (used[slot]) {
+            return false;
+        }
+        used[slot] = true;
+    }
+    return true;
+}
+
+/******************************************************************
+ * findMultiplier --
+ *   First odd multiplier (from the golden-ratio constant upwards)
+ *   that hashes the default codes without collisions, or 0.
+ ******************************************************************/
+constexpr std::uint32_t findMultiplier()
+{
+    for (std::uint32_t candidate = 2654435761u, tries = 0; tries < 10000; candidate += 2, ++tries) {
+        if (isPerfect(candidate)) {
+            return candidate;
+        }
+    }
+    return 0;
+}
+
+constexpr std::uint32_t MULTIPLIER = findMultiplier();
+static_assert(MULTIPLIER != 0, "No perfect hash multiplier for the default PLU codes");
+
+/******************************************************************
+ * buildSlots --
+ *   Slot -> index into DefaultMenu::ENTRIES (-1 = empty).
+ ******************************************************************/
+constexpr std::array<std::int8_t, HASH_SLOTS> buildSlots()
+{
+    std::array<std::int8_t, HASH_SLOTS> slots{};
+    for (int i = 0; i < HASH_SLOTS; ++i) {
+        slots[i] = -1;
+    }
+    for (int i = 0; i < DEFAULT_COUNT; ++i) {
+        slots[hashSlot(DefaultMenu::ENTRIES[i].plu, MULTIPLIER)] = std::int8_t(i);
+    }
+    return slots;
+}
+
+constexpr std::array<std::int8_t, HASH_SLOTS> SLOTS = buildSlots();
+
+/******************************************************************
+ * findDefault --
+ *   Index of the default item with this code in
+ *   DefaultMenu::ENTRIES, or -1.
+ ******************************************************************/
+constexpr int findDefault(int code)
+{
+    if (code <= 0 || code >= FIRST_RUNTIME_CODE) {
+        return -1;
+    }
+    int index = SLOTS[std::size_t(hashSlot(code, MULTIPLIER))];
+    return (index >= 0 && DefaultMenu::ENTRIES[index].plu == code) ? index : -1;
+}
+
+constexpr bool allCodesResolve()
+{
+    for (int i = 0; i < DEFAULT_COUNT; ++i) {
+        if (findDefault(DefaultMenu::ENTRIES[i].plu) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(allCodesResolve(), "PLU perfect hash is broken");
+
+} // namespace Plu
+
+/******************************************************************
+ * PluIndex
+ *
+ * Resolves PLU codes to item names for one menu version. sync()
+ * is cheap when the menu has not changed, so callers simply call
+ * it before every lookup.
+ ******************************************************************/
+class PluIndex
+{
+public:
+    /**************************************************************
+     * sync --
+     *   Assign runtime codes for the items of this menu version
+     *   that have no default code and no code yet (no-op for the
+     *   same version).
+     *
+     * resolve --
+     *   Item name for a code, or empty if the code is unknown.
+     *   The item may still be missing from the current menu.
+     *
+     * codeFor --
+     *   PLU code of an item, or 0 if it has none.
+     **************************************************************/
+    void sync(const MenuSnapshotPtr &menu);
+    QString resolve(int code) const;
+    int codeFor(const QString &name) const;
+
+private:
+    quint64 syncedVersion = 0;
+    bool synced = false;
+    QHash<int, QString> runtimeNames;     // Code -> manager-added item
+    QHash<QString, int> codes;            // Every item on the menu -> code
+    QHash<int, int> runtimeCodes;         // Item ID -> its runtime code
+};
+
+#endif // PLUINDEX_H
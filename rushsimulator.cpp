@@ -0,0 +1,644 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * rushsimulator.cpp
+ *
+ * This file implements the RushSimulator class: a discrete-event
+ * model of a lunch rush on top of the real ordering engine.
+ *   - Poisson arrivals per block, baskets drawn from the menu
+ *   - One line feeding N terminals, one queue feeding the cooks
+ *   - Orders per minute, queue lengths and latency percentiles
+ *
+ ******************************************************************/
+
+#include "rushsimulator.h"
+#include "metrics.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+/******************************************************************
+ * RushSimulator::run --
+ *   Entry point of the simulator. See rushsimulator.h for options.
+ *
+ * Parameters:
+ *   arguments - command line (QCoreApplication::arguments())
+ *
+ * Modifies:
+ *   - all simulation state and statistics
+ *
+ * Returns:
+ *   0 on success, 1 on bad arguments or an empty menu
+ ******************************************************************/
+int RushSimulator::run(const QStringList &arguments)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if (!parseOptions(arguments, err)) {
+        return 1;
+    }
+
+    menu = store->snapshot();
+    if (menu->items.isEmpty()) {
+        err << "The menu is empty\n";
+        return 1;
+    }
+
+    for (int i = 0; i < terminalCount; ++i) {
+        terminals.push_back(std::make_unique<OrderEngine>(store, stock, coupons));
+    }
+    atTerminal.fill(-1, terminalCount);
+    atCook.fill(-1, cookCount);
+    blockArrivals.fill(0, arrivalRates.size());
+    blockOrders.fill(0, arrivalRates.size());
+    blockMaxLine.fill(0, arrivalRates.size());
+    blockMaxKitchen.fill(0, arrivalRates.size());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    scheduleArrival(0);
+    while (!events.empty()) {
+        pop_heap(events.begin(), events.end(), greater<Event>());
+        Event event = events.back();
+        events.pop_back();
+
+        advanceTo(event.time);
+        switch (event.type) {
+        case Event::Arrival:
+            onArrival();
+            break;
+        case Event::OrderDone:
+            onOrderDone(event.station);
+            break;
+        case Event::PrepDone:
+            onPrepDone(event.station);
+            break;
+        }
+    }
+
+    printReport(timer.nsecsElapsed(), out);
+    return 0;
+}
+
+/******************************************************************
+ * RushSimulator::parseOptions --
+ *   Read the options and load the menu and coupons (built-in
+ *   defaults if the files are missing, as the kiosk does).
+ *
+ * Parameters:
+ *   arguments - command line
+ *   err       - stream for error messages
+ *
+ * Modifies:
+ *   - options, store, stock, coupons, random
+ *
+ * Returns:
+ *   true if every option was valid
+ ******************************************************************/
+bool RushSimulator::parseOptions(const QStringList &arguments, QTextStream &err)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Cafeteria Ordering System - lunch rush simulator");
+    QCommandLineOption menuOption("menu", "Menu file.", "file", "menu_items.txt");
+    QCommandLineOption couponOption("coupons", "Coupon file.", "file", "coupons.txt");
+    QCommandLineOption arrivalsOption("arrivals", "Customers per minute for each block.", "list", "1,2,3.5,3,1.5");
+    QCommandLineOption blockOption("block", "Minutes per block.", "minutes", "15");
+    QCommandLineOption startOption("start", "Start of the rush, e.g. \"Mon 11:30\".", "time", "Mon 11:30");
+    QCommandLineOption terminalOption("terminals", "Ordering terminals.", "n", "3");
+    QCommandLineOption cookOption("cooks", "Orders prepared at once.", "n", "4");
+    QCommandLineOption basketOption("basket", "Mean lines per order.", "mean", "2.2");
+    QCommandLineOption couponRateOption("coupon-rate", "Share of customers with a coupon.", "p", "0.1");
+    QCommandLineOption prepOption("prep", "Kitchen seconds per unit.", "seconds", "20");
+    QCommandLineOption balkOption("balk", "Customers leave at this line length (0 = never).", "n", "20");
+    QCommandLineOption stockOption("stock", "Stock of every item (default: not tracked).", "units");
+    QCommandLineOption seedOption("seed", "Random seed.", "n", "1");
+    parser.addOptions({ menuOption, couponOption, arrivalsOption, blockOption, startOption,
+                        terminalOption, cookOption, basketOption, couponRateOption, prepOption,
+                        balkOption, stockOption, seedOption });
+
+    if (!parser.parse(arguments)) {
+        err << parser.errorText() << "\n" << parser.helpText();
+        return false;
+    }
+
+    auto bad = [&](const QCommandLineOption &option) {
+        err << "Invalid --" << option.names().first() << ": " << parser.value(option) << "\n";
+        return false;
+    };
+
+    const QStringList rates = parser.value(arrivalsOption).split(',');
+    for (const QString &text : rates) {
+        bool ok;
+        double rate = text.trimmed().toDouble(&ok);
+        if (!ok || rate < 0) {
+            return bad(arrivalsOption);
+        }
+        arrivalRates.append(rate);
+    }
+
+    bool ok;
+    blockMinutes = parser.value(blockOption).toDouble(&ok);
+    if (!ok || blockMinutes <= 0) {
+        return bad(blockOption);
+    }
+    terminalCount = parser.value(terminalOption).toInt(&ok);
+    if (!ok || terminalCount < 1) {
+        return bad(terminalOption);
+    }
+    cookCount = parser.value(cookOption).toInt(&ok);
+    if (!ok || cookCount < 1) {
+        return bad(cookOption);
+    }
+    basketMean = parser.value(basketOption).toDouble(&ok);
+    if (!ok || basketMean < 1) {
+        return bad(basketOption);
+    }
+    couponRate = parser.value(couponRateOption).toDouble(&ok);
+    if (!ok || couponRate < 0 || couponRate > 1) {
+        return bad(couponRateOption);
+    }
+    prepSeconds = parser.value(prepOption).toDouble(&ok);
+    if (!ok || prepSeconds < 0) {
+        return bad(prepOption);
+    }
+    balkLength = parser.value(balkOption).toInt(&ok);
+    if (!ok || balkLength < 0) {
+        return bad(balkOption);
+    }
+    quint64 seed = parser.value(seedOption).toULongLong(&ok);
+    if (!ok) {
+        return bad(seedOption);
+    }
+    random.seed(seed);
+
+    // "[day] hh:mm", day names as in item schedules (Mon..Sun)
+    static const QStringList DAYS = { "mon", "tue", "wed", "thu", "fri", "sat", "sun" };
+    QRegularExpression startPattern("^(?:([A-Za-z]{3})[A-Za-z]*\\s+)?(\\d{1,2}):(\\d{2})$");
+    QRegularExpressionMatch match = startPattern.match(parser.value(startOption).trimmed());
+    int day = match.hasMatch() && !match.captured(1).isEmpty() ? DAYS.indexOf(match.captured(1).toLower()) : 0;
+    int hour = match.captured(2).toInt();
+    int minute = match.captured(3).toInt();
+    if (!match.hasMatch() || day < 0 || hour > 23 || minute > 59) {
+        return bad(startOption);
+    }
+    startMinute = day * AvailabilityIndex::MINUTES_PER_DAY + hour * 60 + minute;
+
+    // Through a cart-less engine on the shared data, like SharedCatalog
+    OrderEngine files(store, stock, coupons);
+    if (!files.loadMenuItems(parser.value(menuOption))) {
+        files.loadDefaultMenuItems();
+    }
+    if (!files.loadCoupons(parser.value(couponOption))) {
+        files.loadDefaultCoupons();
+    }
+
+    if (parser.isSet(stockOption)) {
+        int units = parser.value(stockOption).toInt(&ok);
+        if (!ok || units < 0) {
+            return bad(stockOption);
+        }
+        for (const FoodItem &item : store->snapshot()->items) {
+            stock->setStock(item.id, units);
+        }
+    }
+    return true;
+}
+
+/******************************************************************
+ * RushSimulator::schedule --
+ *   Add an event to the heap.
+ ******************************************************************/
+void RushSimulator::schedule(double time, Event::Type type, int station)
+{
+    events.push_back({ time, nextSeq++, type, station });
+    push_heap(events.begin(), events.end(), greater<Event>());
+}
+
+/******************************************************************
+ * RushSimulator::advanceTo --
+ *   Move the clock to the next event. Queue lengths and busy
+ *   stations are constant between events, so their time integrals
+ *   grow by length * elapsed time.
+ *
+ * Parameters:
+ *   time - time of the next event (>= now)
+ *
+ * Modifies:
+ *   - now, lineArea, kitchenArea, terminalBusy, cookBusy
+ *
+ * Returns: nothing
+ ******************************************************************/
+void RushSimulator::advanceTo(double time)
+{
+    double elapsed = time - now;
+    lineArea += line.size() * elapsed;
+    kitchenArea += kitchen.size() * elapsed;
+    terminalBusy += (terminalCount - atTerminal.count(-1)) * elapsed;
+    cookBusy += (cookCount - atCook.count(-1)) * elapsed;
+    now = time;
+}
+
+/******************************************************************
+ * RushSimulator::scheduleArrival --
+ *   Draw the next arrival. Gaps are exponential at the rate of the
+ *   current block; a gap that runs past the end of the block is
+ *   drawn again from the block end at the next block's rate (the
+ *   exponential distribution has no memory, so this is exact).
+ *
+ * Parameters:
+ *   from - time of the previous arrival (or 0)
+ *
+ * Modifies:
+ *   - events: one Arrival, unless the rush is over
+ *
+ * Returns: nothing
+ ******************************************************************/
+void RushSimulator::scheduleArrival(double from)
+{
+    const double blockSeconds = blockMinutes * 60;
+    double time = from;
+
+    for (;;) {
+        int block = int(time / blockSeconds);
+        if (block >= arrivalRates.size()) {
+            return;
+        }
+        double blockEnd = (block + 1) * blockSeconds;
+        double perSecond = arrivalRates[block] / 60;
+        if (perSecond > 0) {
+            double next = time + exponential_distribution<double>(perSecond)(random);
+            if (next < blockEnd) {
+                schedule(next, Event::Arrival);
+                return;
+            }
+        }
+        time = blockEnd;
+    }
+}
+
+/******************************************************************
+ * RushSimulator::onArrival --
+ *   A customer walks in, decides what to order and joins the line,
+ *   unless the line is already balkLength long.
+ *
+ * Modifies:
+ *   - customers, line, arrival statistics, events
+ *
+ * Returns: nothing
+ ******************************************************************/
+void RushSimulator::onArrival()
+{
+    SimCustomer customer;
+    customer.arrival = now;
+    drawBasket(customer);
+    if (!coupons->isEmpty() && bernoulli_distribution(couponRate)(random)) {
+        const QStringList codes = coupons->keys();
+        customer.coupon = codes[uniform_int_distribution<int>(0, int(codes.size()) - 1)(random)];
+    }
+
+    int block = blockAt(now);
+    ++blockArrivals[block];
+    customers.append(customer);
+
+    if (balkLength > 0 && int(line.size()) >= balkLength) {
+        ++balked;
+    } else {
+        line.push_back(int(customers.size()) - 1);
+        maxLine = qMax(maxLine, int(line.size()));
+        blockMaxLine[block] = qMax(blockMaxLine[block], int(line.size()));
+        startOrders();
+    }
+    scheduleArrival(now);
+}
+
+/******************************************************************
+ * RushSimulator::drawBasket --
+ *   Pick 1 + Poisson(basketMean - 1) lines from the items on sale
+ *   at the customer's arrival: a category uniformly, then an item
+ *   of it uniformly. Most lines are for one unit.
+ *
+ * Parameters:
+ *   customer - receives the basket
+ *
+ * Returns: nothing
+ ******************************************************************/
+void RushSimulator::drawBasket(SimCustomer &customer)
+{
+    int minute = (startMinute + int(now / 60)) % AvailabilityIndex::MINUTES_PER_WEEK;
+    int segment = menu->availability.segmentAt(minute);
+
+    QMap<QString, QVector<int>> onSale;   // Category -> rows
+    for (int row = 0; row < menu->items.size(); ++row) {
+        if (menu->availability.isAvailable(row, segment)) {
+            onSale[menu->items[row].category].append(row);
+        }
+    }
+    if (onSale.isEmpty()) {
+        return;
+    }
+    const QList<QVector<int>> categories = onSale.values();
+
+    static const double QUANTITY_WEIGHTS[] = { 0.85, 0.12, 0.03 };   // 1, 2 or 3 units
+    discrete_distribution<int> quantity(begin(QUANTITY_WEIGHTS), end(QUANTITY_WEIGHTS));
+    uniform_int_distribution<int> category(0, int(categories.size()) - 1);
+
+    int lines = 1;
+    if (basketMean > 1) {
+        lines += poisson_distribution<int>(basketMean - 1)(random);
+    }
+    for (int i = 0; i < lines; ++i) {
+        const QVector<int> &rows = categories[category(random)];
+        int row = rows[uniform_int_distribution<int>(0, int(rows.size()) - 1)(random)];
+        customer.basket.append(qMakePair(row, 1 + quantity(random)));
+    }
+}
+
+/******************************************************************
+ * RushSimulator::startOrders --
+ *   Send the front of the line to every free terminal.
+ ******************************************************************/
+void RushSimulator::startOrders()
+{
+    for (int terminal = 0; terminal < terminalCount && !line.empty(); ++terminal) {
+        if (atTerminal[terminal] != -1) {
+            continue;
+        }
+        int index = line.front();
+        line.pop_front();
+
+        SimCustomer &customer = customers[index];
+        customer.orderStart = now;
+        atTerminal[terminal] = index;
+        double mean = ORDER_BASE_SECONDS + ORDER_PER_LINE_SECONDS * customer.basket.size() + PAY_SECONDS;
+        schedule(now + sampleTime(mean), Event::OrderDone, terminal);
+    }
+}
+
+/******************************************************************
+ * RushSimulator::onOrderDone --
+ *   The customer at a terminal has finished: the basket goes into
+ *   the terminal's cart and is checked out, both timed on the wall
+ *   clock. Lines that are sold out are skipped; a customer with
+ *   nothing left to buy leaves without an order.
+ *
+ * Parameters:
+ *   terminal - terminal index
+ *
+ * Modifies:
+ *   - terminal engine (cart, shared stock), kitchen queue, statistics
+ *
+ * Returns: nothing
+ ******************************************************************/
+void RushSimulator::onOrderDone(int terminal)
+{
+    SimCustomer &customer = customers[atTerminal[terminal]];
+    OrderEngine &engine = *terminals[terminal];
+    QElapsedTimer timer;
+
+    for (const QPair<int, int> &entry : customer.basket) {
+        timer.start();
+        bool added = engine.addToCart(menu->items[entry.first].name, entry.second);
+        addSamples.append(timer.nsecsElapsed());
+        if (added) {
+            customer.units += entry.second;
+        } else {
+            ++soldOutLines;
+        }
+    }
+    customer.orderEnd = now;
+
+    if (engine.cartItems().empty()) {
+        ++soldOutWalkaways;
+    } else {
+        QString receipt;
+        timer.start();
+        engine.checkout(customer.coupon, receipt);
+        checkoutSamples.append(timer.nsecsElapsed());
+        Metrics::ordersTotal().increment();   // Simulated payments always succeed
+
+        int block = blockAt(now);
+        ++blockOrders[block];
+        ++ordersPerMinute[int(now / 60)];
+        kitchen.push_back(atTerminal[terminal]);
+        maxKitchen = qMax(maxKitchen, int(kitchen.size()));
+        blockMaxKitchen[block] = qMax(blockMaxKitchen[block], int(kitchen.size()));
+    }
+
+    atTerminal[terminal] = -1;
+    startPrep();
+    startOrders();
+}
+
+/******************************************************************
+ * RushSimulator::startPrep --
+ *   Give the oldest waiting order to every free cook.
+ ******************************************************************/
+void RushSimulator::startPrep()
+{
+    for (int cook = 0; cook < cookCount && !kitchen.empty(); ++cook) {
+        if (atCook[cook] != -1) {
+            continue;
+        }
+        int index = kitchen.front();
+        kitchen.pop_front();
+
+        SimCustomer &customer = customers[index];
+        customer.prepStart = now;
+        atCook[cook] = index;
+        schedule(now + sampleTime(PREP_BASE_SECONDS + prepSeconds * customer.units), Event::PrepDone, cook);
+    }
+}
+
+/******************************************************************
+ * RushSimulator::onPrepDone --
+ *   An order is ready; the cook takes the next one.
+ ******************************************************************/
+void RushSimulator::onPrepDone(int cook)
+{
+    customers[atCook[cook]].ready = now;
+    atCook[cook] = -1;
+    startPrep();
+}
+
+/******************************************************************
+ * RushSimulator::sampleTime --
+ *   mean times a log-normal factor whose own mean is 1.
+ ******************************************************************/
+double RushSimulator::sampleTime(double mean)
+{
+    lognormal_distribution<double> factor(-TIME_SPREAD * TIME_SPREAD / 2, TIME_SPREAD);
+    return mean * factor(random);
+}
+
+/******************************************************************
+ * RushSimulator::blockAt --
+ *   Block of a simulated time; orders finished after the last
+ *   block count towards the last one.
+ ******************************************************************/
+int RushSimulator::blockAt(double time) const
+{
+    return qBound(0, int(time / (blockMinutes * 60)), int(arrivalRates.size()) - 1);
+}
+
+/******************************************************************
+ * RushSimulator::clockText --
+ *   Time of day of a simulated time, "HH:MM".
+ ******************************************************************/
+QString RushSimulator::clockText(double time) const
+{
+    int minute = (startMinute + int(time / 60)) % AvailabilityIndex::MINUTES_PER_DAY;
+    return QString("%1:%2").arg(minute / 60, 2, 10, QChar('0')).arg(minute % 60, 2, 10, QChar('0'));
+}
+
+/******************************************************************
+ * RushSimulator::percentile --
+ *   Nearest-rank percentile.
+ *
+ * Parameters:
+ *   sorted - samples sorted ascending
+ *   p      - percentile in [0, 100]
+ *
+ * Returns:
+ *   the sample at that rank, or 0 if there are no samples
+ ******************************************************************/
+template <typename T>
+T RushSimulator::percentile(const QVector<T> &sorted, double p)
+{
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+    int count = static_cast<int>(sorted.size());
+    int rank = static_cast<int>(p / 100.0 * count + 0.5);
+    rank = qBound(1, rank, count);
+    return sorted[rank - 1];
+}
+
+/******************************************************************
+ * RushSimulator::printReport --
+ *   Print the outcome: customers, throughput per block, queue
+ *   lengths, utilization, simulated latencies (seconds) and the
+ *   wall-clock cost of the engine calls (microseconds).
+ *
+ * Parameters:
+ *   elapsedNs - wall time of the simulation in nanoseconds
+ *   out       - output stream
+ *
+ * Returns: nothing
+ ******************************************************************/
+void RushSimulator::printReport(qint64 elapsedNs, QTextStream &out) const
+{
+    QVector<double> lineWait, ordering, kitchenWait, prep, total;
+    int ordered = 0;
+    for (const SimCustomer &customer : customers) {
+        if (customer.orderStart >= 0) {
+            lineWait.append(customer.orderStart - customer.arrival);
+            ordering.append(customer.orderEnd - customer.orderStart);
+        }
+        if (customer.ready >= 0) {
+            ++ordered;
+            kitchenWait.append(customer.prepStart - customer.orderEnd);
+            prep.append(customer.ready - customer.prepStart);
+            total.append(customer.ready - customer.arrival);
+        }
+    }
+
+    const double rushMinutes = blockMinutes * arrivalRates.size();
+    int peakMinute = 0;
+    for (int count : ordersPerMinute) {
+        peakMinute = qMax(peakMinute, count);
+    }
+
+    out << QString("Lunch rush from %1 (%2 min), %3 terminal(s), %4 cook(s), simulated in %5 ms\n")
+               .arg(clockText(0))
+               .arg(rushMinutes)
+               .arg(terminalCount)
+               .arg(cookCount)
+               .arg(elapsedNs / 1e6, 0, 'f', 1);
+    out << QString("Customers: %1 arrived, %2 ordered, %3 left the line, %4 found nothing left on sale\n")
+               .arg(customers.size())
+               .arg(ordered)
+               .arg(balked)
+               .arg(soldOutWalkaways);
+    if (soldOutLines > 0) {
+        out << QString("Sold-out basket lines: %1\n").arg(soldOutLines);
+    }
+    out << QString("Throughput: %1 orders/min over the rush, %2 in the busiest minute; last order ready at %3\n\n")
+               .arg(ordered / rushMinutes, 0, 'f', 2)
+               .arg(peakMinute)
+               .arg(clockText(now));
+
+    out << QString("%1%2%3%4%5%6\n")
+               .arg("block", -14)
+               .arg("arrivals", 10)
+               .arg("orders", 8)
+               .arg("per min", 9)
+               .arg("max line", 10)
+               .arg("max kitchen", 13);
+    for (int block = 0; block < arrivalRates.size(); ++block) {
+        double start = block * blockMinutes * 60;
+        out << QString("%1%2%3%4%5%6\n")
+                   .arg(clockText(start) + "-" + clockText(start + blockMinutes * 60), -14)
+                   .arg(blockArrivals[block], 10)
+                   .arg(blockOrders[block], 8)
+                   .arg(blockOrders[block] / blockMinutes, 9, 'f', 2)
+                   .arg(blockMaxLine[block], 10)
+                   .arg(blockMaxKitchen[block], 13);
+    }
+
+    double span = now > 0 ? now : 1;
+    out << QString("\nLine: mean %1, max %2 customers; kitchen queue: mean %3, max %4 orders\n")
+               .arg(lineArea / span, 0, 'f', 2)
+               .arg(maxLine)
+               .arg(kitchenArea / span, 0, 'f', 2)
+               .arg(maxKitchen);
+    out << QString("Utilization: terminals %1%, cooks %2%\n\n")
+               .arg(100 * terminalBusy / (terminalCount * span), 0, 'f', 0)
+               .arg(100 * cookBusy / (cookCount * span), 0, 'f', 0);
+
+    out << QString("%1%2%3%4%5%6\n")
+               .arg("time (s)", -18)
+               .arg("count", 8)
+               .arg("p50", 9)
+               .arg("p90", 9)
+               .arg("p99", 9)
+               .arg("max", 9);
+    auto row = [&out](const QString &label, QVector<double> samples) {
+        sort(samples.begin(), samples.end());
+        out << QString("%1%2%3%4%5%6\n")
+                   .arg(label, -18)
+                   .arg(samples.size(), 8)
+                   .arg(percentile(samples, 50), 9, 'f', 1)
+                   .arg(percentile(samples, 90), 9, 'f', 1)
+                   .arg(percentile(samples, 99), 9, 'f', 1)
+                   .arg(samples.isEmpty() ? 0.0 : samples.last(), 9, 'f', 1);
+    };
+    row("line wait", lineWait);
+    row("ordering", ordering);
+    row("kitchen wait", kitchenWait);
+    row("preparation", prep);
+    row("arrival to food", total);
+
+    out << QString("\n%1%2%3%4%5\n")
+               .arg("engine (us)", -18)
+               .arg("count", 8)
+               .arg("p50", 9)
+               .arg("p99", 9)
+               .arg("max", 9);
+    auto engineRow = [&out](const QString &label, QVector<qint64> samples) {
+        sort(samples.begin(), samples.end());
+        out << QString("%1%2%3%4%5\n")
+                   .arg(label, -18)
+                   .arg(samples.size(), 8)
+                   .arg(percentile(samples, 50) / 1e3, 9, 'f', 2)
+                   .arg(percentile(samples, 99) / 1e3, 9, 'f', 2)
+                   .arg((samples.isEmpty() ? 0 : samples.last()) / 1e3, 9, 'f', 2);
+    };
+    engineRow("addToCart", addSamples);
+    engineRow("checkout", checkoutSamples);
+    out.flush();
+}
@@ -0,0 +1,229 @@
+/******************************************************************
+ * rushsimulator.h
+ *
+ * This header declares the RushSimulator class, the core of the
+ * lunch-rush simulator (Cafeteria_Sim). It is a discrete-event
+ * simulation of one service period, used offline to size terminal
+ * and kitchen staffing and to check the ordering engine under peak
+ * load:
+ *
+ *   customers --> [line] --> N terminals --> [kitchen queue] --> cooks
+ *
+ * Customers arrive as a Poisson process whose rate changes every
+ * block (e.g. every 15 minutes). Each one picks a basket from the
+ * items of the menu file that are on sale at that time (a category
+ * first, then an item of it, so drinks and sides show up as often as
+ * mains), may bring a coupon, and joins the line; a customer who
+ * finds the line too long leaves. At a terminal the basket is
+ * entered and paid through a real OrderEngine (one per terminal,
+ * sharing menu, stock and coupons as the kiosks do), and the paid
+ * order waits for a cook.
+ *
+ * Simulated time is not wall time: a rush of an hour runs in well
+ * under a second. The engine calls themselves are timed on the wall
+ * clock and reported separately.
+ *
+ ******************************************************************/
+
+#ifndef RUSHSIMULATOR_H
+#define RUSHSIMULATOR_H
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+#include "orderengine.h"
+
+/******************************************************************
+ * SimCustomer
+ *
+ * One synthetic customer and what happened to them. Times are in
+ * simulated seconds from the start of the rush (-1 = not reached).
+ *
+ * Members:
+ *   basket       - snapshot rows and quantities to order
+ *   coupon       - coupon code to enter, or empty
+ *   arrival      - joined the line
+ *   orderStart   - reached a terminal
+ *   orderEnd     - left the terminal (paid, or gave up)
+ *   prepStart    - a cook started the order
+ *   ready        - food handed out
+ *   units        - items actually ordered (after sold-out misses)
+ ******************************************************************/
+struct SimCustomer {
+    QVector<QPair<int, int>> basket;
+    QString coupon;
+    double arrival = -1;
+    double orderStart = -1;
+    double orderEnd = -1;
+    double prepStart = -1;
+    double ready = -1;
+    int units = 0;
+};
+
+/******************************************************************
+ * RushSimulator
+ *
+ * Single-threaded; all randomness comes from one seeded generator,
+ * so the same options give the same simulated results.
+ ******************************************************************/
+class RushSimulator
+{
+public:
+    /**************************************************************
+     * Service time model (simulated seconds). Each sampled time is
+     * the mean below scaled by a log-normal factor with spread
+     * TIME_SPREAD, so most customers are near the mean and a few
+     * take much longer.
+     *
+     *   at a terminal: ORDER_BASE + ORDER_PER_LINE * lines + PAY
+     *   in the kitchen: PREP_BASE + prep seconds (--prep) * units
+     **************************************************************/
+    static constexpr double ORDER_BASE_SECONDS = 12.0;
+    static constexpr double ORDER_PER_LINE_SECONDS = 5.0;
+    static constexpr double PAY_SECONDS = 10.0;
+    static constexpr double PREP_BASE_SECONDS = 40.0;
+    static constexpr double TIME_SPREAD = 0.3;
+
+    /**************************************************************
+     * run --
+     *   Parses the command line, loads the menu and coupon files,
+     *   simulates the rush and prints the report.
+     *
+     *   Options:
+     *     --menu <file>       menu file (default menu_items.txt)
+     *     --coupons <file>    coupon file (default coupons.txt)
+     *     --arrivals <list>   customers per minute for each block
+     *                         (default 1,2,3.5,3,1.5)
+     *     --block <minutes>   length of one block (default 15)
+     *     --start <day hh:mm> when the rush starts, for item
+     *                         schedules (default "Mon 11:30")
+     *     --terminals <n>     ordering terminals (default 3)
+     *     --cooks <n>         orders prepared at once (default 4)
+     *     --basket <mean>     mean lines per order (default 2.2)
+     *     --coupon-rate <p>   share of customers with a coupon
+     *                         (default 0.1)
+     *     --prep <seconds>    kitchen seconds per unit (default 20)
+     *     --balk <n>          customers leave when this many are in
+     *                         line (default 20, 0 = never)
+     *     --stock <units>     stock of every item (default: menu
+     *                         items are not stock-tracked)
+     *     --seed <n>          random seed (default 1)
+     *
+     *   Returns the process exit code (0 on success).
+     **************************************************************/
+    int run(const QStringList &arguments);
+
+private:
+    /**************************************************************
+     * Event
+     *
+     * One scheduled event. seq breaks ties so events at the same
+     * time run in the order they were scheduled.
+     **************************************************************/
+    struct Event {
+        enum Type { Arrival, OrderDone, PrepDone };
+
+        double time;
+        quint64 seq;
+        Type type;
+        int station;     // Terminal or cook index
+        bool operator>(const Event &other) const
+        {
+            return time != other.time ? time > other.time : seq > other.seq;
+        }
+    };
+
+    // Options
+    QVector<double> arrivalRates;   // Customers per minute, per block
+    double blockMinutes = 15;
+    int startMinute = 11 * 60 + 30; // Minute of the week (Monday 11:30)
+    int terminalCount = 3;
+    int cookCount = 4;
+    double basketMean = 2.2;
+    double couponRate = 0.1;
+    double prepSeconds = 20;
+    int balkLength = 20;
+
+    // Shared data and one engine per terminal
+    std::shared_ptr<MenuStore> store = std::make_shared<MenuStore>();
+    std::shared_ptr<Inventory> stock = std::make_shared<Inventory>();
+    std::shared_ptr<CouponTable> coupons = std::make_shared<CouponTable>();
+    std::vector<std::unique_ptr<OrderEngine>> terminals;
+    MenuSnapshotPtr menu;
+
+    // Simulation state
+    std::mt19937_64 random;
+    std::vector<Event> events;      // Min-heap on time
+    quint64 nextSeq = 0;
+    double now = 0;
+    QVector<SimCustomer> customers;
+    std::deque<int> line;           // Customers waiting for a terminal
+    std::deque<int> kitchen;        // Paid orders waiting for a cook
+    QVector<int> atTerminal;        // Customer per terminal, -1 = free
+    QVector<int> atCook;            // Customer per cook, -1 = free
+
+    // Statistics
+    int balked = 0;                 // Left because the line was too long
+    int soldOutWalkaways = 0;       // Nothing in their basket was left
+    int soldOutLines = 0;           // Basket lines that could not be added
+    double lineArea = 0;            // Integral of line length over time
+    double kitchenArea = 0;         // Same for the kitchen queue
+    double terminalBusy = 0;        // Terminal-seconds in use
+    double cookBusy = 0;            // Cook-seconds in use
+    int maxLine = 0;
+    int maxKitchen = 0;
+    QVector<int> blockArrivals;
+    QVector<int> blockOrders;
+    QVector<int> blockMaxLine;
+    QVector<int> blockMaxKitchen;
+    QMap<int, int> ordersPerMinute; // Simulated minute -> checkouts
+    QVector<qint64> addSamples;     // Wall-clock ns per addToCart()
+    QVector<qint64> checkoutSamples;// Wall-clock ns per checkout()
+
+    /**************************************************************
+     * Helper functions (internal use only)
+     *
+     * parseOptions()   - fills the options; false on bad values.
+     * schedule()       - adds an event.
+     * advanceTo()      - moves the clock, integrating queue lengths.
+     * scheduleArrival()- draws the next arrival after `from` (none
+     *                    once the last block has ended).
+     * onArrival()      - new customer: basket, then line or leave.
+     * drawBasket()     - basket from the items on sale at a time.
+     * startOrders()    - moves customers from the line to free
+     *                    terminals.
+     * onOrderDone()    - enters and pays the basket on the
+     *                    terminal's engine; order to the kitchen.
+     * startPrep()      - moves orders to free cooks.
+     * onPrepDone()     - food is ready.
+     * sampleTime()     - mean scaled by the log-normal factor.
+     * blockAt()        - block index of a simulated time.
+     * clockText()      - "HH:MM" of a simulated time.
+     * printReport()    - prints everything.
+     * percentile()     - nearest-rank percentile of sorted samples.
+     **************************************************************/
+    bool parseOptions(const QStringList &arguments, QTextStream &err);
+    void schedule(double time, Event::Type type, int station = -1);
+    void advanceTo(double time);
+    void scheduleArrival(double from);
+    void onArrival();
+    void drawBasket(SimCustomer &customer);
+    void startOrders();
+    void onOrderDone(int terminal);
+    void startPrep();
+    void onPrepDone(int cook);
+    double sampleTime(double mean);
+    int blockAt(double time) const;
+    QString clockText(double time) const;
+    void printReport(qint64 elapsedNs, QTextStream &out) const;
+    template <typename T>
+    static T percentile(const QVector<T> &sorted, double p);
+};
+
+#endif // RUSHSIMULATOR_H
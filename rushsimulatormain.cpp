@@ -0,0 +1,42 @@
+/******************************************************************
+ * rushsimulatormain.cpp
+ *
+ * This file contains the entry point of the lunch-rush simulator
+ * (Cafeteria_Sim), a console program that needs no display (see
+ * rushsimulator.h). For example, to compare three and four
+ * terminals on a busier rush:
+ *
+ *   Cafeteria_Sim --arrivals 2,4,6,5,2 --terminals 3
+ *   Cafeteria_Sim --arrivals 2,4,6,5,2 --terminals 4
+ *
+ ******************************************************************/
+
+#include "rushsimulator.h"
+#include "metrics.h"
+#include "tracer.h"
+#include <QCoreApplication>
+
+/******************************************************************
+ * main --
+ *   Program entry point of the simulator.
+ *
+ * Parameters:
+ *   argc - number of command-line arguments
+ *   argv - array of C-strings containing the arguments
+ *
+ * Returns:
+ *   int - exit code from RushSimulator::run()
+ ******************************************************************/
+int main(int argc, char *argv[])
+{
+    // Record trace spans if CAFETERIA_TRACE names an output file
+    Tracer::initFromEnvironment();
+
+    QCoreApplication app(argc, argv);
+    MetricsFileWriter metricsWriter;
+    RushSimulator simulator;
+    int result = simulator.run(app.arguments());
+    metricsWriter.writeNow();
+    Tracer::flush();
+    return result;
+}
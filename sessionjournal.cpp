@@ -0,0 +1,412 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * sessionjournal.cpp
+ *
+ * This file implements SessionJournal: a QFile mapping with two
+ * checksummed slots per section (see sessionjournal.h).
+ *
+ ******************************************************************/
+
+#include "sessionjournal.h"
+#include "tracer.h"
+#include <QDataStream>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(Q_OS_UNIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const quint32 FILE_MAGIC = 0x4a464143;   // "CAFJ"
+const quint32 SLOT_MAGIC = 0x544f4c53;   // "SLOT"
+const quint32 LAYOUT_VERSION = 2;        // 2: menu slots hold a delta
+const int FILE_HEADER_BYTES = 64;        // Keeps the slots cache-line aligned
+
+/******************************************************************
+ * FileHeader / SlotHeader
+ *
+ * Stored with memcpy in host byte order; the file never leaves the
+ * kiosk that wrote it.
+ ******************************************************************/
+struct FileHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 cartSlotBytes;
+    quint32 menuSlotBytes;
+};
+
+struct SlotHeader {
+    quint32 magic;
+    quint32 length;       // Payload bytes after the header
+    quint64 generation;   // Higher = newer
+    quint32 checksum;     // CRC-32 of generation, length and payload
+    quint32 reserved;
+};
+
+const int SLOT_HEADER_BYTES = int(sizeof(SlotHeader));
+
+/******************************************************************
+ * crc32 --
+ *   Standard CRC-32 (polynomial 0xEDB88320), table driven. Can be
+ *   chained: pass the previous result as `crc`.
+ ******************************************************************/
+quint32 crc32(const void *data, std::size_t size, quint32 crc = 0)
+{
+    static const std::array<quint32, 256> TABLE = [] {
+        std::array<quint32, 256> table {};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+            }
+            table[i] = value;
+        }
+        return table;
+    }();
+
+    const uchar *bytes = static_cast<const uchar *>(data);
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = TABLE[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+quint32 slotChecksum(quint64 generation, quint32 length, const uchar *payload)
+{
+    quint32 crc = crc32(&generation, sizeof(generation));
+    crc = crc32(&length, sizeof(length), crc);
+    return crc32(payload, length, crc);
+}
+
+/******************************************************************
+ * writeItems / readItems --
+ *   One list of menu items in a menu slot: a count, then the fields
+ *   the menu file holds. IDs are not stored.
+ ******************************************************************/
+void writeItems(QDataStream &out, const QVector<FoodItem> &items)
+{
+    out << quint32(items.size());
+    for (const FoodItem &item : items) {
+        out << item.name << item.price << item.category << item.imagePath << item.availability;
+    }
+}
+
+void readItems(QDataStream &in, QVector<FoodItem> &items)
+{
+    quint32 count = 0;
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        FoodItem item;
+        in >> item.name >> item.price >> item.category >> item.imagePath >> item.availability;
+        items.append(item);
+    }
+}
+
+} // namespace
+
+SessionJournal::~SessionJournal()
+{
+    if (base) {
+        file.unmap(base);
+    }
+}
+
+/******************************************************************
+ * SessionJournal::open --
+ *   Map the journal file, creating (or starting over) a file whose
+ *   header does not match this layout, and find the newest slot of
+ *   each section. The file is sparse until slots are written.
+ *
+ * Parameters:
+ *   fileName - journal file, e.g. "session_state.bin"
+ *
+ * Modifies:
+ *   - file, base, cart, menu, menuPending
+ *
+ * Returns:
+ *   true if the journal is usable
+ ******************************************************************/
+bool SessionJournal::open(const QString &fileName)
+{
+    TRACE_SCOPE("SessionJournal::open");
+
+    const qint64 size = FILE_HEADER_BYTES + 2 * qint64(CART_SLOT_BYTES) + 2 * qint64(MENU_SLOT_BYTES);
+    const FileHeader expected { FILE_MAGIC, LAYOUT_VERSION, CART_SLOT_BYTES, MENU_SLOT_BYTES };
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qWarning("Session journal %s not available: %s",
+                 qPrintable(fileName), qPrintable(file.errorString()));
+        return false;
+    }
+
+    FileHeader header {};
+    bool matches = file.size() == size
+                   && file.read(reinterpret_cast<char *>(&header), sizeof(header)) == qint64(sizeof(header))
+                   && std::memcmp(&header, &expected, sizeof(header)) == 0;
+    if (!matches) {
+        // New file or another layout: nothing in it can be trusted
+        if (!file.resize(0) || !file.resize(size) || !file.seek(0)
+            || file.write(reinterpret_cast<const char *>(&expected), sizeof(expected)) != qint64(sizeof(expected))
+            || !file.flush()) {
+            qWarning("Session journal %s could not be created: %s",
+                     qPrintable(fileName), qPrintable(file.errorString()));
+            file.close();
+            return false;
+        }
+    }
+
+    base = file.map(0, size);
+    if (!base) {
+        qWarning("Session journal %s could not be mapped: %s",
+                 qPrintable(fileName), qPrintable(file.errorString()));
+        file.close();
+        return false;
+    }
+
+    cart.offset = FILE_HEADER_BYTES;
+    cart.slotBytes = CART_SLOT_BYTES;
+    menu.offset = cart.offset + 2 * qint64(CART_SLOT_BYTES);
+    menu.slotBytes = MENU_SLOT_BYTES;
+    scan(cart);
+    scan(menu);
+    menuPending = !read(menu).isEmpty();
+
+    scratch.reserve(CART_SLOT_BYTES);   // resize(0) keeps a reserved buffer
+    return true;
+}
+
+/******************************************************************
+ * SessionJournal::recordCart --
+ *   Store the cart lines. Called after every cart change; costs one
+ *   small serialization and a memcpy into the mapping.
+ ******************************************************************/
+void SessionJournal::recordCart(const std::pmr::vector<OrderItem> &lines)
+{
+    if (!base) {
+        return;
+    }
+
+    scratch.resize(0);
+    {
+        QDataStream out(&scratch, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_0);
+        out << quint32(lines.size());
+        for (const OrderItem &line : lines) {
+            out << qint32(line.itemId) << line.name << line.price << qint32(line.quantity);
+        }
+    }
+    write(cart, scratch);
+}
+
+/******************************************************************
+ * SessionJournal::recordMenu --
+ *   Store the pending manager edits. Only the edited items are
+ *   written, so the slot size limits the edits, not the menu.
+ *
+ * Parameters:
+ *   edits     - diffMenu(menu file, live menu)
+ *   baseItems - the menu file's version of each item in
+ *               edits.changed
+ ******************************************************************/
+void SessionJournal::recordMenu(const MenuDelta &edits, const QVector<FoodItem> &baseItems)
+{
+    if (!base) {
+        return;
+    }
+    TRACE_SCOPE("SessionJournal::recordMenu");
+
+    scratch.resize(0);
+    {
+        QDataStream out(&scratch, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_0);
+        writeItems(out, edits.added);
+        writeItems(out, edits.removed);
+        writeItems(out, edits.changed);
+        writeItems(out, baseItems);
+    }
+    write(menu, scratch);
+    menuPending = true;
+}
+
+/******************************************************************
+ * SessionJournal::clearMenu --
+ *   The menu file is up to date again: an empty menu slot means
+ *   "nothing to restore".
+ ******************************************************************/
+void SessionJournal::clearMenu()
+{
+    if (!base || !menuPending) {
+        return;
+    }
+    write(menu, QByteArray());
+    menuPending = false;
+}
+
+/******************************************************************
+ * SessionJournal::readCart --
+ *   See sessionjournal.h.
+ ******************************************************************/
+bool SessionJournal::readCart(QVector<OrderItem> &lines) const
+{
+    lines.clear();
+    QByteArray payload = read(cart);
+    if (payload.isEmpty()) {
+        return false;
+    }
+
+    QDataStream in(payload);
+    in.setVersion(QDataStream::Qt_5_0);
+    quint32 count = 0;
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        OrderItem line;
+        qint32 itemId = 0;
+        qint32 quantity = 0;
+        in >> itemId >> line.name >> line.price >> quantity;
+        line.itemId = itemId;
+        line.quantity = quantity;
+        lines.append(line);
+    }
+    if (in.status() != QDataStream::Ok) {
+        lines.clear();   // Checksum was fine, so this is a format bug
+    }
+    return !lines.isEmpty();
+}
+
+/******************************************************************
+ * SessionJournal::readMenu --
+ *   See sessionjournal.h.
+ ******************************************************************/
+bool SessionJournal::readMenu(MenuDelta &edits, QVector<FoodItem> &baseItems) const
+{
+    edits = MenuDelta();
+    baseItems.clear();
+    QByteArray payload = read(menu);
+    if (payload.isEmpty()) {
+        return false;
+    }
+
+    QDataStream in(payload);
+    in.setVersion(QDataStream::Qt_5_0);
+    readItems(in, edits.added);
+    readItems(in, edits.removed);
+    readItems(in, edits.changed);
+    readItems(in, baseItems);
+    if (in.status() != QDataStream::Ok) {
+        edits = MenuDelta();
+        baseItems.clear();
+    }
+    return !edits.isEmpty();
+}
+
+/******************************************************************
+ * SessionJournal::scan --
+ *   Find the newest slot with a valid checksum.
+ *
+ * Parameters:
+ *   section - section to scan
+ *
+ * Modifies:
+ *   - section.generation, section.active
+ *
+ * Returns: nothing
+ ******************************************************************/
+void SessionJournal::scan(Section &section)
+{
+    section.generation = 0;
+    section.active = 1;   // First write goes to slot 0
+
+    for (int slot = 0; slot < 2; ++slot) {
+        const uchar *start = base + section.offset + qint64(slot) * section.slotBytes;
+        SlotHeader header;
+        std::memcpy(&header, start, sizeof(header));
+        if (header.magic != SLOT_MAGIC
+            || header.length > quint32(section.slotBytes - SLOT_HEADER_BYTES)
+            || header.checksum != slotChecksum(header.generation, header.length, start + SLOT_HEADER_BYTES)) {
+            continue;   // Never written, or torn by a crash
+        }
+        if (header.generation > section.generation) {
+            section.generation = header.generation;
+            section.active = slot;
+        }
+    }
+}
+
+/******************************************************************
+ * SessionJournal::write --
+ *   Write a payload to the inactive slot and make it the active
+ *   one. The payload is copied before the header; the signal fence
+ *   keeps the compiler from reordering the two, so a crash at any
+ *   point leaves the previous slot as the newest valid one. Then
+ *   the slot's pages are queued for write-back (msync with
+ *   MS_ASYNC, which does not wait for the disk). The kernel may
+ *   write them in any order, but a slot whose header reached the
+ *   disk before its payload fails its checksum, so power loss also
+ *   falls back to the previous slot.
+ *
+ * Parameters:
+ *   section - section to update
+ *   payload - serialized state (empty = nothing to restore); if it
+ *             does not fit the slot, nothing is written
+ *
+ * Modifies:
+ *   - the mapped file; section.generation, section.active
+ *
+ * Returns: nothing
+ ******************************************************************/
+void SessionJournal::write(Section &section, const QByteArray &payload)
+{
+    if (payload.size() > section.slotBytes - SLOT_HEADER_BYTES) {
+        qWarning("Session journal: %d bytes do not fit a %d byte slot; keeping the previous state",
+                 payload.size(), section.slotBytes);
+        return;
+    }
+
+    int slot = 1 - section.active;
+    uchar *start = base + section.offset + qint64(slot) * section.slotBytes;
+
+    SlotHeader header {};
+    header.magic = SLOT_MAGIC;
+    header.length = quint32(payload.size());
+    header.generation = section.generation + 1;
+
+    std::memcpy(start + SLOT_HEADER_BYTES, payload.constData(), payload.size());
+    header.checksum = slotChecksum(header.generation, header.length, start + SLOT_HEADER_BYTES);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    std::memcpy(start, &header, sizeof(header));
+
+#if defined(Q_OS_UNIX)
+    // msync() wants a page-aligned start
+    static const quintptr pageBytes = quintptr(sysconf(_SC_PAGESIZE));
+    quintptr first = quintptr(start) & ~(pageBytes - 1);
+    size_t length = size_t(quintptr(start) - first) + SLOT_HEADER_BYTES + size_t(payload.size());
+    if (msync(reinterpret_cast<void *>(first), length, MS_ASYNC) != 0) {
+        qWarning("Session journal: msync failed; the state survives a crash but maybe not power loss");
+    }
+#endif
+
+    section.generation = header.generation;
+    section.active = slot;
+}
+
+/******************************************************************
+ * SessionJournal::read --
+ *   Payload of the active slot, or an empty array.
+ ******************************************************************/
+QByteArray SessionJournal::read(const Section &section) const
+{
+    if (!base || section.generation == 0) {
+        return QByteArray();
+    }
+    const uchar *start = base + section.offset + qint64(section.active) * section.slotBytes;
+    SlotHeader header;
+    std::memcpy(&header, start, sizeof(header));
+    return QByteArray(reinterpret_cast<const char *>(start + SLOT_HEADER_BYTES), int(header.length));
+}
@@ -0,0 +1,136 @@
+/******************************************************************
+ * sessionjournal.h
+ *
+ * This header declares SessionJournal, which keeps the live session
+ * state (the cart and the manager's unsaved menu edits) in a small
+ * memory-mapped file, so a crash or a kiosk reboot does not make the
+ * customer start over.
+ *
+ * The menu section holds the edits as a MenuDelta against the menu
+ * file, plus the file's version of every changed item, so a restore
+ * can replay them on the file as it is then (see rebaseMenuDelta())
+ * instead of bringing back a stale copy of the whole menu.
+ *
+ * The file holds two sections, each with two slots:
+ *
+ *   [file header][cart slot A][cart slot B][menu slot A][menu slot B]
+ *
+ * An update writes the inactive slot of its section (payload, then
+ * its header with a higher generation and a CRC-32 over both) and
+ * leaves the other slot alone. A crash in the middle of an update
+ * therefore leaves one slot with a bad checksum and one complete
+ * older slot, never a half-written state. Writes go to the mapping,
+ * i.e. to the page cache, so a crashed process loses nothing. Each
+ * update then asks the kernel to write the slot back (msync with
+ * MS_ASYNC, which returns at once), so after power loss the state
+ * is the last update that reached the disk: at most the kernel's
+ * write-back delay old (seconds), and never a torn one.
+ *
+ * SharedCatalog keeps the menu section of its own file; every
+ * customer window keeps its cart in the cart section of its
+ * screen's file.
+ *
+ ******************************************************************/
+
+#ifndef SESSIONJOURNAL_H
+#define SESSIONJOURNAL_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <memory_resource>
+#include <vector>
+#include "menutypes.h"
+
+/******************************************************************
+ * SessionJournal
+ *
+ * Owned by the GUI thread. If the file cannot be created or mapped,
+ * every record call does nothing and nothing is restored.
+ ******************************************************************/
+class SessionJournal
+{
+public:
+    static const int CART_SLOT_BYTES = 16 * 1024;    // Roughly 300 cart lines
+    static const int MENU_SLOT_BYTES = 256 * 1024;   // Roughly 3000 edited items
+
+    SessionJournal() = default;
+    ~SessionJournal();
+    SessionJournal(const SessionJournal &) = delete;
+    SessionJournal &operator=(const SessionJournal &) = delete;
+
+    /**************************************************************
+     * open --
+     *   Creates or maps the journal file. A file with a different
+     *   layout (older version, other slot sizes) is started over.
+     *   Returns false if the file cannot be used.
+     *
+     * isOpen --
+     *   True while the file is mapped.
+     **************************************************************/
+    bool open(const QString &fileName);
+    bool isOpen() const { return base != nullptr; }
+
+    /**************************************************************
+     * Recording
+     *
+     * recordCart()     - the cart after a change (empty after
+     *                    checkout or clear).
+     * recordMenu()     - the edits not saved to the menu file
+     *                    yet: the delta from the file to the live
+     *                    menu and the file's version of each item
+     *                    in edits.changed.
+     * clearMenu()      - the menu was saved; nothing is pending.
+     * hasPendingMenu() - recordMenu() was called since the last
+     *                    clearMenu() (or restore found edits).
+     **************************************************************/
+    void recordCart(const std::pmr::vector<OrderItem> &lines);
+    void recordMenu(const MenuDelta &edits, const QVector<FoodItem> &baseItems);
+    void clearMenu();
+    bool hasPendingMenu() const { return menuPending; }
+
+    /**************************************************************
+     * Restoring
+     *
+     * readCart() - cart lines of the newest complete cart slot.
+     * readMenu() - the unsaved edits and their base items, as
+     *              recorded. Item IDs are reset to 0 (they belong
+     *              to the crashed process).
+     *
+     * Both return false if there is nothing to restore.
+     *
+     * A state too large for its slot is not recorded (a warning is
+     * logged) and the previous one stays restorable.
+     **************************************************************/
+    bool readCart(QVector<OrderItem> &lines) const;
+    bool readMenu(MenuDelta &edits, QVector<FoodItem> &baseItems) const;
+
+private:
+    /**************************************************************
+     * Section
+     *
+     * Two slots of the same size. generation is the newest
+     * complete slot's generation (0 = none yet); active is its
+     * index, so the next write goes to the other one.
+     **************************************************************/
+    struct Section {
+        qint64 offset = 0;
+        int slotBytes = 0;
+        quint64 generation = 0;
+        int active = 1;
+    };
+
+    QFile file;
+    uchar *base = nullptr;    // Start of the mapping
+    Section cart;
+    Section menu;
+    bool menuPending = false;
+    QByteArray scratch;       // Reused serialization buffer
+
+    void scan(Section &section);
+    void write(Section &section, const QByteArray &payload);
+    QByteArray read(const Section &section) const;
+};
+
+#endif // SESSIONJOURNAL_H
@@ -0,0 +1,279 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * sharedcatalog.cpp
+ *
+ * This file implements SharedCatalog: loading and saving the shared
+ * menu and coupons, hot reload, the unsaved-edit journal and the
+ * upsell history.
+ *
+ ******************************************************************/
+
+#include "sharedcatalog.h"
+#include <QDir>
+#include <QHash>
+#include <QFileInfo>
+#include "tracer.h"
+
+/******************************************************************
+ * SharedCatalog::SharedCatalog --
+ *   Create the empty shared data. Nothing is read until load().
+ ******************************************************************/
+SharedCatalog::SharedCatalog(QObject *parent)
+    : QObject(parent)
+    , store(std::make_shared<MenuStore>())
+    , stock(std::make_shared<Inventory>())
+    , couponTable(std::make_shared<CouponTable>())
+    , files(store, stock, couponTable)
+{
+    historyReader.setMaxThreadCount(1);
+
+    QString categories = qEnvironmentVariable("CAFETERIA_UPSELL_CATEGORIES", "Side Items,Beverages,Desserts");
+    for (const QString &category : categories.split(',')) {
+        if (!category.trimmed().isEmpty()) {
+            upsellCategoryNames << category.trimmed();
+        }
+    }
+}
+
+/******************************************************************
+ * SharedCatalog::load --
+ *   Load the menu and coupons once for every window. The menu file
+ *   is only written once the manager changes the menu; default
+ *   coupons are saved so head office has a file to edit.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - store, couponTable, search, fileItems: filled
+ *   - COUPON_FILE: created when the defaults are used
+ *   - JOURNAL_FILE: rewritten without the edits that were dropped
+ *   - watcher: created
+ *   - upsell: order log history added later (see loadUpsellHistory)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void SharedCatalog::load()
+{
+    TRACE_SCOPE("SharedCatalog::load");
+
+    if (!files.loadMenuItems(MENU_FILE)) {
+        files.loadDefaultMenuItems();
+    }
+    if (!files.loadCoupons(COUPON_FILE)) {
+        files.loadDefaultCoupons();
+        files.saveCoupons(COUPON_FILE);
+    }
+
+    // Hot reloads and the journal are diffed against the file, not
+    // the live menu
+    fileItems = store->snapshot()->items;
+
+    // Unsaved edits of a crashed session are replayed on the file as
+    // it is now. The file wins for items changed in it since.
+    journal.open(JOURNAL_FILE);
+    MenuDelta edits;
+    QVector<FoodItem> baseItems;
+    if (journal.readMenu(edits, baseItems)) {
+        MenuDelta replay = rebaseMenuDelta(edits, baseItems, store->snapshot());
+        int dropped = edits.added.size() + edits.removed.size() + edits.changed.size()
+                      - replay.added.size() - replay.removed.size() - replay.changed.size();
+        if (dropped > 0) {
+            qWarning("Session journal: %d unsaved menu edits not replayed; "
+                     "the menu file has changed those items since", dropped);
+        }
+        restored = !replay.isEmpty();
+        if (restored) {
+            files.applyMenuDelta(replay);
+            journalEdits();
+        } else {
+            journal.clearMenu();
+        }
+    }
+
+    search.rebuild(store->snapshot()->items);
+
+    watcher = new MenuFileWatcher(fileItems, MENU_FILE, COUPON_FILE, this);
+    connect(watcher, &MenuFileWatcher::menuDeltaReady, this, &SharedCatalog::onMenuDeltaReady);
+    connect(watcher, &MenuFileWatcher::couponsReloaded, this, &SharedCatalog::onCouponsReloaded);
+
+    loadUpsellHistory();
+}
+
+/******************************************************************
+ * SharedCatalog::loadUpsellHistory --
+ *   Count the orders of every screen's order log on the worker
+ *   thread, so a long history never delays start-up. Orders that
+ *   complete meanwhile go into upsell directly; the history is
+ *   merged into it when it arrives. Each log's size is taken here,
+ *   before any window exists, and the worker reads only up to it,
+ *   so those orders (appended to the same logs) are not counted
+ *   twice.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - upsell: history merged in (on this thread, later)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void SharedCatalog::loadUpsellHistory()
+{
+    const QFileInfoList logs = QDir::current().entryInfoList(ORDER_LOG_FILES, QDir::Files, QDir::Name);
+    if (logs.isEmpty()) {
+        return;
+    }
+    QVector<QPair<QString, qint64>> sizes;   // Log -> bytes to read
+    for (const QFileInfo &log : logs) {
+        sizes.append(qMakePair(log.filePath(), log.size()));
+    }
+
+    historyReader.start([this, sizes]() {
+        TRACE_SCOPE("readUpsellHistory");
+
+        auto history = std::make_shared<UpsellIndex>();
+        for (const QPair<QString, qint64> &log : sizes) {
+            history->readOrderLog(log.first, log.second);
+        }
+
+        QMetaObject::invokeMethod(this, [this, history]() {
+            upsell.merge(*history);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/******************************************************************
+ * SharedCatalog::journalEdits --
+ *   Record how the live menu differs from MENU_FILE, with the
+ *   file's version of each changed item (what a restore checks the
+ *   file against). Nothing is pending if they no longer differ.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - JOURNAL_FILE: menu slot rewritten
+ *
+ * Returns: nothing
+ ******************************************************************/
+void SharedCatalog::journalEdits()
+{
+    TRACE_SCOPE("SharedCatalog::journalEdits");
+
+    MenuDelta edits = diffMenu(fileItems, store->snapshot()->items);
+    if (edits.isEmpty()) {
+        journal.clearMenu();
+        return;
+    }
+
+    QHash<QString, int> fileRow;
+    for (int row = fileItems.size() - 1; row >= 0; --row) {
+        fileRow.insert(fileItems[row].name, row);   // First occurrence wins
+    }
+    QVector<FoodItem> baseItems;
+    baseItems.reserve(edits.changed.size());
+    for (const FoodItem &item : edits.changed) {
+        baseItems.append(fileItems[fileRow.value(item.name)]);
+    }
+    journal.recordMenu(edits, baseItems);
+}
+
+/******************************************************************
+ * SharedCatalog::menuEdited --
+ *   Journal the pending edits and tell every window.
+ *
+ * Parameters:
+ *   delta - what the edit added, removed or changed
+ *
+ * Modifies:
+ *   - JOURNAL_FILE: menu slot rewritten
+ *
+ * Returns: nothing
+ ******************************************************************/
+void SharedCatalog::menuEdited(const MenuDelta &delta)
+{
+    journalEdits();
+    emit menuChanged(delta);
+}
+
+/******************************************************************
+ * SharedCatalog::applyMenuDelta --
+ *   Apply a delta as one menu update and keep the search index in
+ *   step (removed, then changed, then added items).
+ *
+ * Parameters:
+ *   delta - items to remove, change and add
+ *
+ * Modifies:
+ *   - store, search
+ *
+ * Returns: nothing
+ ******************************************************************/
+void SharedCatalog::applyMenuDelta(const MenuDelta &delta)
+{
+    TRACE_SCOPE("SharedCatalog::applyMenuDelta");
+
+    files.applyMenuDelta(delta);
+    for (const FoodItem &item : delta.removed) {
+        search.removeItem(item.name);
+    }
+    for (const FoodItem &item : delta.changed) {
+        search.updateItem(item);
+    }
+    for (const FoodItem &item : delta.added) {
+        search.addItem(item);
+    }
+    emit menuChanged(delta);
+}
+
+/******************************************************************
+ * SharedCatalog::saveMenu --
+ *   Write the shared menu to MENU_FILE. Once saved, nothing is
+ *   pending in the journal.
+ *
+ * Returns:
+ *   true if the file was written
+ ******************************************************************/
+bool SharedCatalog::saveMenu()
+{
+    TRACE_SCOPE("SharedCatalog::saveMenu");
+
+    if (!files.saveMenuItems(MENU_FILE)) {
+        return false;
+    }
+    fileItems = store->snapshot()->items;
+    journal.clearMenu();
+    return true;
+}
+
+/******************************************************************
+ * SharedCatalog::onMenuDeltaReady --
+ *   MENU_FILE changed on disk. Only the file's changes to items
+ *   without unsaved edits are applied; the unsaved edits now sit
+ *   on top of the new file contents, so they are journaled again.
+ *
+ * Parameters:
+ *   delta        - what changed in the file
+ *   previousFile - file contents before the change
+ *   newFile      - file contents now
+ ******************************************************************/
+void SharedCatalog::onMenuDeltaReady(const MenuDelta &delta,
+                                     const QVector<FoodItem> &previousFile,
+                                     const QVector<FoodItem> &newFile)
+{
+    fileItems = newFile;
+    MenuDelta live = rebaseMenuDelta(delta, previousFile, store->snapshot());
+    if (!live.isEmpty()) {
+        applyMenuDelta(live);   // Empty e.g. for our own save coming back
+    }
+    if (journal.hasPendingMenu()) {
+        journalEdits();
+    }
+}
+
+/******************************************************************
+ * SharedCatalog::onCouponsReloaded --
+ *   COUPON_FILE changed on disk.
+ ******************************************************************/
+void SharedCatalog::onCouponsReloaded(const QMap<QString, double> &table)
+{
+    if (files.setCoupons(table)) {
+        emit couponsChanged();
+    }
+}
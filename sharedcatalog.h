@@ -0,0 +1,156 @@
+/******************************************************************
+ * sharedcatalog.h
+ *
+ * This header declares SharedCatalog, everything the customer
+ * windows of one process share: the menu store, the stock counters,
+ * the coupon table, the decoded icons, the search and PLU indexes,
+ * the hot reload watcher, the journal of unsaved menu edits and the
+ * "frequently bought together" counts behind the upsell panel.
+ *
+ * A kiosk tower runs one window per screen (CAFETERIA_SCREENS, see
+ * main.cpp). Each window only adds its own cart, checkout pipeline
+ * and widgets, so another screen costs a cart, not another copy of
+ * the catalog and its pictures.
+ *
+ ******************************************************************/
+
+#ifndef SHAREDCATALOG_H
+#define SHAREDCATALOG_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <memory>
+#include "orderengine.h"
+#include "menusearch.h"
+#include "menuwatcher.h"
+#include "pluindex.h"
+#include "assetregistry.h"
+#include "sessionjournal.h"
+#include "upsellindex.h"
+
+/******************************************************************
+ * SharedCatalog
+ *
+ * Lives on the GUI thread, like the windows that use it. Windows
+ * edit the menu through their own OrderEngine (it writes to the
+ * shared store) and then call menuEdited(), applyMenuDelta() or
+ * saveMenu() so every window hears about the change.
+ ******************************************************************/
+class SharedCatalog : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SharedCatalog(QObject *parent = nullptr);
+
+    /**************************************************************
+     * load --
+     *   Reads MENU_FILE and COUPON_FILE (or the defaults), replays
+     *   unsaved menu edits of a crashed session on the file (edits
+     *   to items the file has changed since are dropped), builds the
+     *   search index and starts watching the files. Call once,
+     *   before the first window is created. The upsell counts of
+     *   earlier sessions are read from the order logs in the
+     *   background and added when ready.
+     *
+     * menuRestored --
+     *   True if load() replayed unsaved menu edits.
+     *
+     * hasUnsavedEdits --
+     *   True if any window edited the menu since the last save.
+     **************************************************************/
+    void load();
+    bool menuRestored() const { return restored; }
+    bool hasUnsavedEdits() const { return journal.hasPendingMenu(); }
+
+    /**************************************************************
+     * Shared data
+     *
+     * menuStore() / inventory() / coupons() - what each window's
+     *                  OrderEngine is built on.
+     * assets()       - item icons, decoded once per process.
+     * searchIndex()  - n-gram index over item names.
+     * pluIndex()     - PLU code lookups.
+     * upsellIndex()  - items bought together; every window adds its
+     *                  completed orders.
+     * upsellCategories() - categories the upsell panel may offer
+     *                  (CAFETERIA_UPSELL_CATEGORIES, comma-separated;
+     *                  default sides, drinks and desserts).
+     **************************************************************/
+    std::shared_ptr<MenuStore> menuStore() const { return store; }
+    std::shared_ptr<Inventory> inventory() const { return stock; }
+    std::shared_ptr<CouponTable> coupons() const { return couponTable; }
+    AssetRegistry &assets() { return assetRegistry; }
+    MenuSearchIndex &searchIndex() { return search; }
+    PluIndex &pluIndex() { return plu; }
+    UpsellIndex &upsellIndex() { return upsell; }
+    const QStringList &upsellCategories() const { return upsellCategoryNames; }
+
+    /**************************************************************
+     * Menu changes
+     *
+     * menuEdited()     - a window made an edit that is not saved
+     *                    yet (search index already updated), as
+     *                    described by the delta: journals it and
+     *                    emits menuChanged().
+     * applyMenuDelta() - applies a delta to the menu and the
+     *                    search index and emits menuChanged().
+     * saveMenu()       - writes MENU_FILE; pending edits are
+     *                    cleared from the journal on success.
+     **************************************************************/
+    void menuEdited(const MenuDelta &delta);
+    void applyMenuDelta(const MenuDelta &delta);
+    bool saveMenu();
+
+signals:
+    /**************************************************************
+     * menuChanged --
+     *   The shared menu was changed by a window or by a hot
+     *   reload. delta names the items added, removed and changed,
+     *   so windows patch only those rows (added items may carry
+     *   ID 0; look them up by name in the current snapshot).
+     *
+     * couponsChanged --
+     *   The coupon file was reloaded with different codes.
+     **************************************************************/
+    void menuChanged(const MenuDelta &delta);
+    void couponsChanged();
+
+private slots:
+    void onMenuDeltaReady(const MenuDelta &delta,
+                          const QVector<FoodItem> &previousFile,
+                          const QVector<FoodItem> &newFile);
+    void onCouponsReloaded(const QMap<QString, double> &table);
+
+private:
+    void loadUpsellHistory();
+    void journalEdits();
+
+    std::shared_ptr<MenuStore> store;
+    std::shared_ptr<Inventory> stock;
+    std::shared_ptr<CouponTable> couponTable;
+    OrderEngine files;             // No cart: loads, saves and edits the shared data
+    AssetRegistry assetRegistry;
+    MenuSearchIndex search;
+    PluIndex plu;
+    MenuFileWatcher *watcher = nullptr;
+    SessionJournal journal;        // Menu section only; carts are per window
+    QVector<FoodItem> fileItems;   // MENU_FILE as last read or written; edits are journaled against it
+    bool restored = false;
+    UpsellIndex upsell;
+    QStringList upsellCategoryNames;
+
+    /**************************************************************
+     * Files shared by every window
+     **************************************************************/
+    const QString MENU_FILE   = "menu_items.txt";    // Menu items file
+    const QString COUPON_FILE = "coupons.txt";       // Coupon codes file
+    const QString JOURNAL_FILE = "session_menu.bin"; // Unsaved menu edits
+    const QStringList ORDER_LOG_FILES = { "orders.csv", "orders_*.csv" };  // Every screen's order log
+
+    QThreadPool historyReader;     // Reads the order logs once; declared last
+};
+
+#endif // SHAREDCATALOG_H
@@ -0,0 +1,227 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * stallwatchdog.cpp
+ *
+ * This file implements StallWatchdog: the ping loop on the monitor
+ * thread, scope sampling and the rotating stall log.
+ *
+ ******************************************************************/
+
+#include "stallwatchdog.h"
+#include "metrics.h"
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QTextStream>
+#include <QVector>
+#include <algorithm>
+
+/******************************************************************
+ * StallWatchdog::StallWatchdog --
+ *   Read the configuration. Nothing runs until start().
+ *
+ * Parameters:
+ *   parent - owning object (usually nullptr; create on the GUI
+ *            thread)
+ ******************************************************************/
+StallWatchdog::StallWatchdog(QObject *parent)
+    : QObject(parent)
+{
+    bool ok = false;
+    int budget = qEnvironmentVariableIntValue("CAFETERIA_STALL_BUDGET_MS", &ok);
+    if (ok) {
+        budgetMs = qMax(0, budget);
+    }
+    QString file = qEnvironmentVariable("CAFETERIA_STALL_LOG");
+    if (!file.isEmpty()) {
+        logFile = file;
+    }
+}
+
+/******************************************************************
+ * StallWatchdog::start --
+ *   Unless disabled or already running, publish the GUI thread's
+ *   scope stack and start the monitor thread.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - guiScopes, clock; the monitor thread starts
+ *
+ * Returns: nothing
+ ******************************************************************/
+void StallWatchdog::start()
+{
+    if (!isEnabled() || guiScopes) {
+        return;
+    }
+
+    guiScopes = Tracer::publishScopes();
+    clock.start();
+    monitor.setMaxThreadCount(1);
+    monitor.start([this]() { run(); });
+}
+
+/******************************************************************
+ * StallWatchdog::~StallWatchdog --
+ *   Stop the monitor and wait for it. A ping still queued for the
+ *   GUI thread is dropped with this object.
+ ******************************************************************/
+StallWatchdog::~StallWatchdog()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    monitor.waitForDone();
+}
+
+/******************************************************************
+ * StallWatchdog::run --
+ *   Monitor loop. Each round posts one ping and polls for its
+ *   answer every budget / 4; once the answer is overdue, every poll
+ *   also takes a scope sample. A late answer is recorded as a stall.
+ *   An answer IN_PROGRESS_BUDGETS budgets late is recorded as an
+ *   ongoing stall first, in case it never comes.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - answered, answeredNs (through the GUI thread)
+ *   - stall log, stall metrics
+ *
+ * Returns: nothing (when stopping)
+ ******************************************************************/
+void StallWatchdog::run()
+{
+    const int intervalMs = qMax(1, budgetMs / 2);
+    const int pollMs = qMax(1, budgetMs / 4);
+    const qint64 budgetNs = qint64(budgetMs) * 1000000;
+    const qint64 inProgressNs = budgetNs * IN_PROGRESS_BUDGETS;
+
+    for (quint64 ping = 1;; ++ping) {
+        qint64 sentNs = clock.nsecsElapsed();
+        qint64 sentMs = QDateTime::currentMSecsSinceEpoch();
+        QMetaObject::invokeMethod(this, [this, ping]() {
+            answeredNs.store(clock.nsecsElapsed(), std::memory_order_relaxed);
+            answered.store(ping, std::memory_order_release);
+        }, Qt::QueuedConnection);
+
+        QMap<QString, int> samples;   // Scope stack -> times seen
+        bool inProgressLogged = false;
+        while (answered.load(std::memory_order_acquire) < ping) {
+            if (!sleepFor(pollMs)) {
+                return;
+            }
+            qint64 lateNs = clock.nsecsElapsed() - sentNs;
+            if (lateNs > budgetNs) {
+                QString where = guiScopes->sample();
+                ++samples[where.isEmpty() ? QString("(no traced scope)") : where];
+            }
+            if (lateNs > inProgressNs && !inProgressLogged) {
+                record(sentMs, lateNs, samples, false);
+                inProgressLogged = true;
+            }
+        }
+
+        qint64 durationNs = answeredNs.load(std::memory_order_relaxed) - sentNs;
+        if (durationNs > budgetNs) {
+            record(sentMs, durationNs, samples, true);
+        }
+        if (!sleepFor(intervalMs)) {
+            return;
+        }
+    }
+}
+
+/******************************************************************
+ * StallWatchdog::sleepFor --
+ *   Sleep on the monitor thread, waking early when stopping.
+ *
+ * Returns:
+ *   false if the watchdog is stopping
+ ******************************************************************/
+bool StallWatchdog::sleepFor(int ms)
+{
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    return !wake.wait_for(lock, std::chrono::milliseconds(ms), [this]() { return stopping; });
+}
+
+/******************************************************************
+ * StallWatchdog::record --
+ *   Append one stall to the log, most frequent scope first. A
+ *   finished stall is also counted in the metrics; an ongoing one
+ *   is followed by its finished entry (same start time) if the GUI
+ *   thread ever answers. Runs on the monitor thread, so the GUI
+ *   thread never waits for the log.
+ *
+ * Parameters:
+ *   startMs    - wall-clock time the ping was sent
+ *   durationNs - time until the GUI thread answered, or so far
+ *   samples    - scope stacks seen during the stall (so far)
+ *   finished   - false while the GUI thread has not answered yet
+ *
+ * Modifies:
+ *   - logFile (rotated when full)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void StallWatchdog::record(qint64 startMs, qint64 durationNs, const QMap<QString, int> &samples, bool finished)
+{
+    if (finished) {
+        Metrics::guiStallsTotal().increment();
+        Metrics::guiStallDuration().record(durationNs);
+    }
+
+    QVector<QPair<int, QString>> ranked;
+    int total = 0;
+    for (auto it = samples.constBegin(); it != samples.constEnd(); ++it) {
+        ranked.append(qMakePair(it.value(), it.key()));
+        total += it.value();
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const QPair<int, QString> &a, const QPair<int, QString> &b) {
+        return a.first > b.first;
+    });
+
+    QString when = QDateTime::fromMSecsSinceEpoch(startMs).toString(Qt::ISODateWithMs);
+    qint64 durationMs = durationNs / 1000000;
+    qWarning("GUI thread %s %lld ms at %s", finished ? "stalled for" : "still stalled after",
+             static_cast<long long>(durationMs),
+             ranked.isEmpty() ? "(not sampled)" : qPrintable(ranked.first().second));
+
+    rotate();
+    QFile file(logFile);
+    if (!file.open(QIODevice::Append | QIODevice::Text)) {
+        return;
+    }
+    QTextStream out(&file);
+    if (finished) {
+        out << when << " stall " << durationMs << " ms (budget " << budgetMs << " ms)\n";
+    } else {
+        out << when << " stall in progress, " << durationMs << " ms so far (budget " << budgetMs << " ms)\n";
+    }
+    if (ranked.isEmpty()) {
+        out << "  at (not sampled)\n";   // Ended before the first late poll
+    }
+    for (const QPair<int, QString> &entry : ranked) {
+        out << "  at " << entry.second << "  (" << entry.first << " of " << total << " samples)\n";
+    }
+}
+
+/******************************************************************
+ * StallWatchdog::rotate --
+ *   Keep the log small: above MAX_LOG_BYTES, stalls.log becomes
+ *   stalls.log.1, .1 becomes .2 and the oldest is dropped.
+ ******************************************************************/
+void StallWatchdog::rotate()
+{
+    if (QFileInfo(logFile).size() < MAX_LOG_BYTES) {
+        return;
+    }
+    QFile::remove(QString("%1.%2").arg(logFile).arg(KEPT_LOGS));
+    for (int i = KEPT_LOGS - 1; i >= 1; --i) {
+        QFile::rename(QString("%1.%2").arg(logFile).arg(i), QString("%1.%2").arg(logFile).arg(i + 1));
+    }
+    QFile::rename(logFile, logFile + ".1");
+}
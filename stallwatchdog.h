@@ -0,0 +1,95 @@
+/******************************************************************
+ * stallwatchdog.h
+ *
+ * This header declares StallWatchdog, which finds GUI-thread stalls
+ * ("the kiosk froze") in the field.
+ *
+ * A monitor thread pings the GUI event loop with a queued call and
+ * waits for the answer. While the answer is late by more than the
+ * budget, the monitor samples the GUI thread's open TRACE_SCOPE()
+ * names (see ScopeStack in tracer.h). Once the loop answers, the
+ * stall is written to a small rotating log: when it happened, how
+ * long it lasted and where the GUI thread was, e.g.
+ *
+ *   2026-10-18T12:03:07.412 stall 412 ms (budget 100 ms)
+ *     at onMenuChanged > updateItemsList  (4 of 4 samples)
+ *
+ * A stall still going after IN_PROGRESS_BUDGETS budgets is also
+ * written right away ("stall in progress, 1000 ms so far"), so a
+ * kiosk that never recovers and gets killed still leaves an entry.
+ *
+ * Configured from the environment:
+ *   CAFETERIA_STALL_BUDGET_MS - stall threshold in ms (default 100,
+ *                               0 turns the watchdog off)
+ *   CAFETERIA_STALL_LOG       - log file (default "stalls.log");
+ *                               rotated to .1 and .2 at 256 KB
+ *
+ ******************************************************************/
+
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "tracer.h"
+
+/******************************************************************
+ * StallWatchdog
+ *
+ * Create it on the GUI thread, after QApplication, and call start()
+ * from the running event loop: start-up (loading the catalog,
+ * building the windows) happens before the loop runs and is not a
+ * stall. The ping answer is one queued call per ping interval (half
+ * the budget), so an idle kiosk wakes up a few times per second at
+ * most.
+ ******************************************************************/
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const qint64 MAX_LOG_BYTES = 256 * 1024;   // Rotate above this
+    static const int KEPT_LOGS = 2;                    // stalls.log.1, .2
+    static const int IN_PROGRESS_BUDGETS = 10;         // Log an ongoing stall after this
+
+    explicit StallWatchdog(QObject *parent = nullptr);
+    ~StallWatchdog() override;
+
+    /**************************************************************
+     * start --
+     *   Publishes the GUI thread's scope stack and starts pinging.
+     *   Call on the GUI thread once the event loop runs, e.g.
+     *   QTimer::singleShot(0, &watchdog, &StallWatchdog::start).
+     *   Does nothing if disabled or already started.
+     **************************************************************/
+    void start();
+
+    bool isEnabled() const { return budgetMs > 0; }
+
+private:
+    int budgetMs = 100;
+    QString logFile = "stalls.log";
+
+    ScopeStack *guiScopes = nullptr;   // Published by the GUI thread
+    QElapsedTimer clock;               // Shared time base (ns)
+    std::atomic<quint64> answered { 0 };     // Last ping the GUI answered
+    std::atomic<qint64> answeredNs { 0 };    // When it did
+
+    QThreadPool monitor;               // One long-running task
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping = false;             // Guarded by sleepMutex
+
+    void run();
+    bool sleepFor(int ms);
+    void record(qint64 startMs, qint64 durationNs, const QMap<QString, int> &samples, bool finished);
+    void rotate();
+};
+
+#endif // STALLWATCHDOG_H
@@ -0,0 +1,149 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * toast.cpp
+ *
+ * This file implements ToastNotifier. Each toast is a QLabel child
+ * of the host window with its own single-shot timer, so showing a
+ * toast costs one widget and never enters a nested event loop.
+ *
+ ******************************************************************/
+
+#include "toast.h"
+#include <QEvent>
+#include <QPointer>
+#include <QTimer>
+#include <QWidget>
+
+namespace {
+
+const int BOTTOM_MARGIN = 48;   // Keeps toasts clear of the status bar
+const int SPACING = 8;
+const int MAX_WIDTH = 480;
+
+/******************************************************************
+ * styleFor --
+ *   Style sheet for one toast level (matches the café theme).
+ ******************************************************************/
+QString styleFor(ToastNotifier::Level level)
+{
+    QString colors;
+    switch (level) {
+    case ToastNotifier::Warning:
+        colors = "background-color: #5a4a2e; border: 2px solid #a08040; color: #f4e4b4;";
+        break;
+    case ToastNotifier::Error:
+        colors = "background-color: #5a2e2e; border: 2px solid #a05050; color: #f4d4d4;";
+        break;
+    default:
+        colors = "background-color: #3d5a2e; border: 2px solid #6fa050; color: #f4f4d4;";
+        break;
+    }
+    return "QLabel { " + colors + " border-radius: 8px; padding: 10px 16px; font-weight: bold; }";
+}
+
+} // namespace
+
+/******************************************************************
+ * ToastNotifier::ToastNotifier --
+ *   Watch the host for resizes so toasts stay centred.
+ *
+ * Parameters:
+ *   host - window the toasts are drawn over (also the QObject parent)
+ ******************************************************************/
+ToastNotifier::ToastNotifier(QWidget *host)
+    : QObject(host)
+    , host(host)
+{
+    host->installEventFilter(this);
+}
+
+/******************************************************************
+ * ToastNotifier::show --
+ *   Create a toast and schedule its removal.
+ *
+ * Parameters:
+ *   text       - message
+ *   level      - Info, Warning or Error (colour and default time)
+ *   durationMs - time on screen, 0 for the level's default
+ *
+ * Modifies:
+ *   - toasts: new toast appended, oldest dropped past MAX_VISIBLE
+ *
+ * Returns: nothing
+ ******************************************************************/
+void ToastNotifier::show(const QString &text, Level level, int durationMs)
+{
+    if (durationMs <= 0) {
+        durationMs = (level == Info) ? DEFAULT_MS : WARNING_MS;
+    }
+
+    QLabel *toast = new QLabel(text, host);
+    toast->setObjectName("toast");
+    toast->setStyleSheet(styleFor(level));
+    toast->setWordWrap(true);
+    toast->setAlignment(Qt::AlignCenter);
+    toast->setAttribute(Qt::WA_TransparentForMouseEvents);  // Taps reach the widgets below
+    toast->setFocusPolicy(Qt::NoFocus);
+
+    toasts.append(toast);
+    while (toasts.size() > MAX_VISIBLE) {
+        dismiss(toasts.first());
+    }
+
+    QPointer<QLabel> guard(toast);
+    QTimer::singleShot(durationMs, this, [this, guard]() {
+        if (guard) {
+            dismiss(guard);
+        }
+    });
+
+    toast->show();
+    toast->raise();
+    layoutToasts();
+}
+
+/******************************************************************
+ * ToastNotifier::eventFilter --
+ *   Re-stack the toasts when the host changes size.
+ ******************************************************************/
+bool ToastNotifier::eventFilter(QObject *obj, QEvent *event)
+{
+    if (obj == host && event->type() == QEvent::Resize && !toasts.isEmpty()) {
+        layoutToasts();
+    }
+    return QObject::eventFilter(obj, event);
+}
+
+/******************************************************************
+ * ToastNotifier::dismiss --
+ *   Remove one toast (early or when its timer fires).
+ ******************************************************************/
+void ToastNotifier::dismiss(QLabel *toast)
+{
+    if (toasts.removeOne(toast)) {
+        toast->hide();
+        toast->deleteLater();
+        layoutToasts();
+    }
+}
+
+/******************************************************************
+ * ToastNotifier::layoutToasts --
+ *   Stack the visible toasts upwards from the bottom centre of the
+ *   host, newest lowest.
+ ******************************************************************/
+void ToastNotifier::layoutToasts()
+{
+    int width = qMin(MAX_WIDTH, host->width() - 2 * SPACING);
+    int bottom = host->height() - BOTTOM_MARGIN;
+
+    for (int i = int(toasts.size()) - 1; i >= 0; --i) {
+        QLabel *toast = toasts[i];
+        toast->setFixedWidth(width);
+        toast->adjustSize();
+        int top = bottom - toast->height();
+        toast->move((host->width() - width) / 2, top);
+        bottom = top - SPACING;
+    }
+}
@@ -0,0 +1,66 @@
+/******************************************************************
+ * toast.h
+ *
+ * This header declares ToastNotifier, a non-modal replacement for
+ * informational message boxes. A toast is a short message drawn
+ * over the bottom of a window that disappears on its own; it does
+ * not take focus, does not block the event loop and lets clicks
+ * pass through to the widgets underneath, so the cashier never
+ * has to dismiss it.
+ *
+ ******************************************************************/
+
+#ifndef TOAST_H
+#define TOAST_H
+
+#include <QLabel>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+/******************************************************************
+ * ToastNotifier
+ *
+ * Shows toasts stacked above the bottom edge of the host widget,
+ * newest at the bottom. At most MAX_VISIBLE are shown; a new toast
+ * pushes out the oldest one. Toasts follow the host when it is
+ * resized.
+ ******************************************************************/
+class ToastNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Level { Info, Warning, Error };
+
+    static const int MAX_VISIBLE = 3;
+    static const int DEFAULT_MS = 2500;   // Info
+    static const int WARNING_MS = 4000;   // Warning and Error
+
+    explicit ToastNotifier(QWidget *host);
+
+    /**************************************************************
+     * show --
+     *   Display a message for durationMs milliseconds (0 = the
+     *   default for the level). Returns immediately.
+     *
+     * info / warning / error --
+     *   show() with the matching level and default duration.
+     **************************************************************/
+    void show(const QString &text, Level level = Info, int durationMs = 0);
+    void info(const QString &text) { show(text, Info); }
+    void warning(const QString &text) { show(text, Warning); }
+    void error(const QString &text) { show(text, Error); }
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event) override;
+
+private:
+    QWidget *host;
+    QList<QLabel *> toasts;   // Oldest first
+
+    void dismiss(QLabel *toast);
+    void layoutToasts();
+};
+
+#endif // TOAST_H
@@ -0,0 +1,206 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * tracer.cpp
+ *
+ * This file implements the Tracer class: span collection and
+ * Chrome trace-event JSON output.
+ *
+ ******************************************************************/
+
+#include "tracer.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+
+std::atomic<bool> Tracer::enabled(false);
+thread_local ScopeStack *Tracer::scopes = nullptr;
+
+namespace {
+
+/******************************************************************
+ * SpanRecord
+ *
+ * One recorded span, kept in memory until flush().
+ ******************************************************************/
+struct SpanRecord {
+    const char *name;
+    qint64 startNs;
+    qint64 durationNs;
+    quint64 threadId;
+};
+
+// Upper bound on stored spans so a long session cannot grow without
+// limit (about 32 MB); later spans are dropped and counted
+const int MAX_SPANS = 1000000;
+
+QElapsedTimer traceClock;          // Started by initFromEnvironment()
+QString traceFile;                 // Output path from CAFETERIA_TRACE
+QMutex spanMutex;                  // Guards spans and droppedSpans
+QVector<SpanRecord> spans;
+int droppedSpans = 0;
+
+} // namespace
+
+/******************************************************************
+ * Tracer::initFromEnvironment --
+ *   Enable tracing when CAFETERIA_TRACE is set to a file name.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - enabled, traceFile, traceClock
+ *
+ * Returns: nothing
+ ******************************************************************/
+void Tracer::initFromEnvironment()
+{
+    traceFile = qEnvironmentVariable("CAFETERIA_TRACE");
+    if (traceFile.isEmpty()) {
+        return;
+    }
+
+    traceClock.start();
+    spans.reserve(4096);
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+/******************************************************************
+ * Tracer::nowNs --
+ *   Monotonic time since initFromEnvironment().
+ *
+ * Parameters: none
+ *
+ * Returns:
+ *   nanoseconds
+ ******************************************************************/
+qint64 Tracer::nowNs()
+{
+    return traceClock.nsecsElapsed();
+}
+
+/******************************************************************
+ * Tracer::addSpan --
+ *   Store one completed span. Called from ~TraceSpan().
+ *
+ * Parameters:
+ *   name       - span name (string literal)
+ *   startNs    - start time from nowNs()
+ *   durationNs - duration in nanoseconds
+ *
+ * Modifies:
+ *   - spans (or droppedSpans when full)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void Tracer::addSpan(const char *name, qint64 startNs, qint64 durationNs)
+{
+    SpanRecord record;
+    record.name = name;
+    record.startNs = startNs;
+    record.durationNs = durationNs;
+    record.threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+    QMutexLocker locker(&spanMutex);
+    if (spans.size() < MAX_SPANS) {
+        spans.append(record);
+    } else {
+        ++droppedSpans;
+    }
+}
+
+/******************************************************************
+ * Tracer::flush --
+ *   Write all spans to the trace file in Chrome trace-event format:
+ *     {"traceEvents":[{"name":..,"ph":"X","ts":..,"dur":..,
+ *                      "pid":..,"tid":..}, ...]}
+ *   Times are in microseconds as the format requires.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - trace file: overwritten
+ *   - spans: cleared after writing
+ *
+ * Returns: nothing
+ ******************************************************************/
+void Tracer::flush()
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    QMutexLocker locker(&spanMutex);
+
+    QFile file(traceFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return;
+    }
+
+    qint64 pid = QCoreApplication::applicationPid();
+    QTextStream out(&file);
+    out << "{\"traceEvents\":[\n";
+    for (int i = 0; i < spans.size(); ++i) {
+        const SpanRecord &span = spans[i];
+        out << QString("{\"name\":\"%1\",\"cat\":\"cafeteria\",\"ph\":\"X\",\"ts\":%2,\"dur\":%3,\"pid\":%4,\"tid\":%5}")
+                   .arg(QString::fromLatin1(span.name))
+                   .arg(span.startNs / 1000.0, 0, 'f', 3)
+                   .arg(span.durationNs / 1000.0, 0, 'f', 3)
+                   .arg(pid)
+                   .arg(span.threadId);
+        out << (i + 1 < spans.size() ? ",\n" : "\n");
+    }
+    out << "],\n";
+    out << QString("\"otherData\":{\"droppedSpans\":%1}}\n").arg(droppedSpans);
+    file.close();
+
+    spans.clear();
+    droppedSpans = 0;
+}
+
+/******************************************************************
+ * Tracer::publishScopes --
+ *   Give the calling thread a ScopeStack. It is never freed: a
+ *   watchdog may still read it while the thread shuts down.
+ *
+ * Parameters: none
+ * Modifies:
+ *   - scopes (this thread only)
+ *
+ * Returns:
+ *   the thread's stack
+ ******************************************************************/
+ScopeStack *Tracer::publishScopes()
+{
+    if (!scopes) {
+        scopes = new ScopeStack;
+    }
+    return scopes;
+}
+
+/******************************************************************
+ * ScopeStack::sample --
+ *   Read the open scope names, outermost first.
+ *
+ * Parameters: none
+ *
+ * Returns:
+ *   e.g. "onMenuChanged > updateItemsList", or empty
+ ******************************************************************/
+QString ScopeStack::sample() const
+{
+    int open = depth.load(std::memory_order_acquire);
+    QStringList parts;
+    for (int i = 0; i < qMin(open, MAX_DEPTH); ++i) {
+        const char *name = names[i].load(std::memory_order_relaxed);
+        parts.append(name ? QString::fromLatin1(name) : QString("?"));
+    }
+    if (open > MAX_DEPTH) {
+        parts.append(QString("(+%1)").arg(open - MAX_DEPTH));
+    }
+    return parts.join(" > ");
+}
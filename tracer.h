@@ -0,0 +1,169 @@
+/******************************************************************
+ * tracer.h
+ *
+ * This header declares a small scoped-span tracing facility. When
+ * the CAFETERIA_TRACE environment variable names an output file,
+ * every TRACE_SCOPE() records a span and the spans are written on
+ * exit as Chrome trace-event JSON (open it in chrome://tracing or
+ * ui.perfetto.dev).
+ *
+ * A thread can also publish the names of its open spans as a
+ * ScopeStack, so the stall watchdog (stallwatchdog.h) can tell which
+ * handler the GUI thread is stuck in. This works whether or not
+ * tracing is enabled.
+ *
+ * Cost of a TRACE_SCOPE() with tracing off: a relaxed atomic load
+ * and a thread_local read, plus, on a thread that publishes its
+ * scopes, a push and a pop on its ScopeStack (a few relaxed atomic
+ * stores and one release store). The GUI thread publishes whenever
+ * the watchdog runs, which is the default (100 ms threshold), so
+ * that is the usual cost there; other threads pay only the load
+ * and the read.
+ *
+ ******************************************************************/
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+/******************************************************************
+ * ScopeStack
+ *
+ * Names of the open TRACE_SCOPE()s of one thread, outermost first.
+ * Only that thread pushes and pops; any thread may read a sample.
+ * Names are string literals, so a sample never dangles, but it may
+ * be one push or pop out of date. Deeper scopes than MAX_DEPTH are
+ * counted but not named.
+ ******************************************************************/
+struct ScopeStack {
+    static const int MAX_DEPTH = 32;
+
+    std::atomic<int> depth { 0 };
+    std::atomic<const char *> names[MAX_DEPTH] {};
+
+    void push(const char *name)
+    {
+        int current = depth.load(std::memory_order_relaxed);
+        if (current < MAX_DEPTH) {
+            names[current].store(name, std::memory_order_relaxed);
+        }
+        depth.store(current + 1, std::memory_order_release);
+    }
+
+    void pop()
+    {
+        depth.store(depth.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+    }
+
+    /**************************************************************
+     * sample --
+     *   "outer > inner" for the scopes open right now, or an empty
+     *   string if none is open.
+     **************************************************************/
+    QString sample() const;
+};
+
+/******************************************************************
+ * Tracer
+ *
+ * Process-wide collector for trace spans. All functions are static;
+ * there is only one trace per run.
+ ******************************************************************/
+class Tracer
+{
+public:
+    /**************************************************************
+     * initFromEnvironment --
+     *   Enables tracing if CAFETERIA_TRACE is set. Call once from
+     *   main() before any spans are recorded.
+     *
+     * isEnabled --
+     *   True if spans are being recorded.
+     *
+     * nowNs --
+     *   Nanoseconds since tracing was initialized.
+     *
+     * addSpan --
+     *   Records one completed span ("ph":"X" event).
+     *
+     * flush --
+     *   Writes all recorded spans to the output file. Safe to call
+     *   when tracing is disabled (does nothing).
+     *
+     * publishScopes --
+     *   From now on the calling thread keeps a ScopeStack of its
+     *   open spans. Returns it; it lives until the program exits.
+     *
+     * threadScopes --
+     *   The calling thread's ScopeStack, or nullptr if it never
+     *   called publishScopes().
+     **************************************************************/
+    static void initFromEnvironment();
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static qint64 nowNs();
+    static void addSpan(const char *name, qint64 startNs, qint64 durationNs);
+    static void flush();
+    static ScopeStack *publishScopes();
+    static ScopeStack *threadScopes() { return scopes; }
+
+private:
+    static std::atomic<bool> enabled;   // Set once by initFromEnvironment()
+    static thread_local ScopeStack *scopes;   // Set by publishScopes()
+};
+
+/******************************************************************
+ * TraceSpan
+ *
+ * RAII helper: records the time between construction and
+ * destruction as one span, and keeps the thread's ScopeStack (if
+ * any) current. Use through TRACE_SCOPE().
+ *
+ * The name must be a string literal (it is stored as a pointer).
+ ******************************************************************/
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *spanName)
+        : name(Tracer::isEnabled() ? spanName : nullptr)
+        , startNs(name ? Tracer::nowNs() : 0)
+        , stack(Tracer::threadScopes())
+    {
+        if (stack) {
+            stack->push(spanName);
+        }
+    }
+
+    ~TraceSpan()
+    {
+        if (stack) {
+            stack->pop();
+        }
+        if (name) {
+            Tracer::addSpan(name, startNs, Tracer::nowNs() - startNs);
+        }
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *name;   // nullptr when tracing is disabled
+    qint64 startNs;
+    ScopeStack *stack;  // nullptr unless the thread publishes its scopes
+};
+
+// Two-step concatenation so __LINE__ is expanded before pasting
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/******************************************************************
+ * TRACE_SCOPE(name) --
+ *   Records a span named `name` covering the rest of the enclosing
+ *   block.
+ ******************************************************************/
+#define TRACE_SCOPE(name) TraceSpan TRACE_CONCAT(traceSpan_, __LINE__)(name)
+
+#endif // TRACER_H
@@ -0,0 +1,312 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * uirecorder.cpp
+ *
+ * This file implements UiRecorder: hooking the widgets of the
+ * customer windows and writing their interactions as JSONL.
+ *
+ ******************************************************************/
+
+#include "uirecorder.h"
+#include <QAbstractButton>
+#include <QAbstractItemDelegate>
+#include <QAbstractItemView>
+#include <QAbstractSpinBox>
+#include <QApplication>
+#include <QComboBox>
+#include <QFileDialog>
+#include <QInputDialog>
+#include <QItemSelectionModel>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QKeyEvent>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QMetaProperty>
+#include <QSet>
+#include <QSpinBox>
+#include <QWidget>
+#include <QWindow>
+#include <algorithm>
+
+namespace {
+
+/******************************************************************
+ * selectedNames --
+ *   The whole selection of a view by row text, in row order, so a
+ *   ctrl-click replays to the same rows even if the order changed.
+ ******************************************************************/
+QJsonArray selectedNames(QAbstractItemView *view)
+{
+    QModelIndexList rows = view->selectionModel()->selectedRows();
+    std::sort(rows.begin(), rows.end());
+    QJsonArray names;
+    for (const QModelIndex &row : rows) {
+        names.append(row.data().toString());
+    }
+    return names;
+}
+
+} // namespace
+
+/******************************************************************
+ * UiRecorder::UiRecorder --
+ *   Open CAFETERIA_UI_RECORD, if set. A file that cannot be opened
+ *   is reported once and recording stays off.
+ *
+ * Parameters:
+ *   parent - owning object (usually nullptr)
+ ******************************************************************/
+UiRecorder::UiRecorder(QObject *parent)
+    : QObject(parent)
+{
+    QString fileName = qEnvironmentVariable("CAFETERIA_UI_RECORD");
+    if (fileName.isEmpty()) {
+        return;
+    }
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning("Cannot record UI interactions to %s", qPrintable(fileName));
+    }
+}
+
+/******************************************************************
+ * UiRecorder::attach --
+ *   Connect to every recorded widget of window. Signals that only
+ *   fire for user input are used where Qt has them (activated,
+ *   clicked, textEdited, a delegate's commitData); spin boxes only
+ *   count while focused, so the quantity reset after "Add to Cart"
+ *   is not recorded. The same goes for selection changes without a
+ *   mouse button down (keyboard selection): a list refilled by the
+ *   program does not have the focus.
+ *
+ * Parameters:
+ *   window - customer window (already set up)
+ *   screen - its screen index
+ *
+ * Modifies:
+ *   - screens; qApp's event filters (keys and dialogs)
+ *
+ * Returns: nothing
+ ******************************************************************/
+void UiRecorder::attach(QWidget *window, int screen)
+{
+    if (!isEnabled()) {
+        return;
+    }
+    screens.insert(window, screen);
+    connect(window, &QObject::destroyed, this, [this, window]() { screens.remove(window); });
+    qApp->installEventFilter(this);
+
+    const QList<QAbstractButton *> buttons = window->findChildren<QAbstractButton *>();
+    for (QAbstractButton *button : buttons) {
+        if (isRecorded(button, window)) {
+            connect(button, &QAbstractButton::clicked, this, [this, button, screen]() {
+                write(screen, "click", { { "widget", button->objectName() } });
+            });
+        }
+    }
+
+    const QList<QComboBox *> combos = window->findChildren<QComboBox *>();
+    for (QComboBox *combo : combos) {
+        if (isRecorded(combo, window)) {
+            connect(combo, QOverload<int>::of(&QComboBox::activated), this, [this, combo, screen](int index) {
+                write(screen, "combo", { { "widget", combo->objectName() },
+                                         { "value", combo->itemText(index) } });
+            });
+        }
+    }
+
+    const QList<QAbstractItemView *> views = window->findChildren<QAbstractItemView *>();
+    for (QAbstractItemView *view : views) {
+        if (!isRecorded(view, window)) {
+            continue;
+        }
+        connect(view, &QAbstractItemView::clicked, this, [this, view, screen]() {
+            write(screen, "select", { { "widget", view->objectName() }, { "value", selectedNames(view) } });
+        });
+        connect(view->selectionModel(), &QItemSelectionModel::selectionChanged, this, [this, view, screen]() {
+            // Mouse selections are written by clicked() above
+            if (view->hasFocus() && QApplication::mouseButtons() == Qt::NoButton) {
+                write(screen, "select", { { "widget", view->objectName() },
+                                          { "value", selectedNames(view) },
+                                          { "keys", true } });
+            }
+        });
+
+        // Inline editors are created per edit and have no name, so
+        // the edit is taken from the delegate when it commits
+        QSet<QAbstractItemDelegate *> delegates { view->itemDelegate() };
+        for (int column = 0; view->model() && column < view->model()->columnCount(); ++column) {
+            if (QAbstractItemDelegate *delegate = view->itemDelegateForColumn(column)) {
+                delegates.insert(delegate);
+            }
+        }
+        for (QAbstractItemDelegate *delegate : delegates) {
+            connect(delegate, &QAbstractItemDelegate::commitData, this, [this, view, screen](QWidget *editor) {
+                QModelIndex index = view->currentIndex();
+                if (!index.isValid() || editor->parentWidget() != view->viewport()) {
+                    return;   // A delegate shared with another view
+                }
+                QVariant value = editor->metaObject()->userProperty().read(editor);
+                write(screen, "edit", { { "widget", view->objectName() },
+                                        { "row", index.sibling(index.row(), 0).data().toString() },
+                                        { "column", index.column() },
+                                        { "value", QJsonValue::fromVariant(value) } });
+            });
+        }
+    }
+
+    const QList<QSpinBox *> spins = window->findChildren<QSpinBox *>();
+    for (QSpinBox *spin : spins) {
+        if (isRecorded(spin, window)) {
+            connect(spin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this, spin, screen](int value) {
+                if (spin->hasFocus()) {
+                    write(screen, "spin", { { "widget", spin->objectName() }, { "value", value } });
+                }
+            });
+        }
+    }
+
+    const QList<QLineEdit *> edits = window->findChildren<QLineEdit *>();
+    for (QLineEdit *edit : edits) {
+        if (isRecorded(edit, window) && edit->echoMode() == QLineEdit::Normal) {
+            connect(edit, &QLineEdit::textEdited, this, [this, edit, screen](const QString &text) {
+                write(screen, "text", { { "widget", edit->objectName() }, { "value", text } });
+            });
+        }
+    }
+}
+
+/******************************************************************
+ * UiRecorder::isRecorded --
+ *   Widgets are found again by object name during replay, so only
+ *   named widgets of the window itself are recorded (not Qt's
+ *   internal ones such as "qt_spinbox_lineedit", nor toasts).
+ ******************************************************************/
+bool UiRecorder::isRecorded(QWidget *widget, QWidget *window) const
+{
+    const QString name = widget->objectName();
+    return !name.isEmpty() && !name.startsWith("qt_") && widget->window() == window;
+}
+
+/******************************************************************
+ * UiRecorder::eventFilter --
+ *   Record keys at window level, where the PLU keypad and the
+ *   manager code see them, and hook modal dialogs of attached
+ *   windows as they are shown.
+ *
+ * Parameters:
+ *   obj   - receiver
+ *   event - event about to be delivered
+ *
+ * Returns:
+ *   false (events are only observed)
+ ******************************************************************/
+bool UiRecorder::eventFilter(QObject *obj, QEvent *event)
+{
+    if (event->type() == QEvent::KeyPress && obj->isWindowType()) {
+        QKeyEvent *keyEvent = static_cast<QKeyEvent *>(event);
+        switch (keyEvent->key()) {
+        case Qt::Key_Shift:
+        case Qt::Key_Control:
+        case Qt::Key_Alt:
+        case Qt::Key_Meta:
+            return false;
+        default:
+            break;
+        }
+        for (auto it = screens.constBegin(); it != screens.constEnd(); ++it) {
+            if (it.key()->windowHandle() != obj) {
+                continue;
+            }
+            // Typing into a text or spin box is recorded as its value
+            QWidget *focus = it.key()->focusWidget();
+            if (qobject_cast<QLineEdit *>(focus) || qobject_cast<QAbstractSpinBox *>(focus)) {
+                return false;
+            }
+            write(it.value(), "key", { { "key", keyEvent->key() },
+                                       { "text", keyEvent->text() },
+                                       { "modifiers", int(keyEvent->modifiers()) } });
+            return false;
+        }
+        return false;
+    }
+
+    if (event->type() == QEvent::Show) {
+        QDialog *dialog = qobject_cast<QDialog *>(obj);
+        if (dialog && dialog->isModal() && dialog->parentWidget()
+            && screens.contains(dialog->parentWidget()->window())) {
+            connect(dialog, &QDialog::finished, this, &UiRecorder::onDialogFinished, Qt::UniqueConnection);
+        }
+    }
+    return false;
+}
+
+/******************************************************************
+ * UiRecorder::onDialogFinished --
+ *   Record how a modal dialog was answered: the value of an input
+ *   dialog, the button of a message box, the file of a file dialog.
+ *
+ * Parameters:
+ *   result - QDialog::Accepted or Rejected (message boxes report
+ *            the button instead)
+ ******************************************************************/
+void UiRecorder::onDialogFinished(int result)
+{
+    QDialog *dialog = qobject_cast<QDialog *>(sender());
+    if (!dialog || !dialog->parentWidget()) {
+        return;
+    }
+    int screen = screens.value(dialog->parentWidget()->window());
+    QJsonObject record;
+
+    if (QMessageBox *box = qobject_cast<QMessageBox *>(dialog)) {
+        record["dialog"] = "message";
+        record["button"] = box->clickedButton() ? box->clickedButton()->text() : QString();
+    } else if (QInputDialog *input = qobject_cast<QInputDialog *>(dialog)) {
+        record["dialog"] = "input";
+        record["accepted"] = (result == QDialog::Accepted);
+        if (input->inputMode() == QInputDialog::IntInput) {
+            record["value"] = input->intValue();
+        } else if (input->inputMode() == QInputDialog::DoubleInput) {
+            record["value"] = input->doubleValue();
+        } else if (input->textEchoMode() != QLineEdit::Normal) {
+            record["masked"] = true;
+        } else {
+            record["value"] = input->textValue();
+        }
+    } else if (QFileDialog *files = qobject_cast<QFileDialog *>(dialog)) {
+        record["dialog"] = "file";
+        record["accepted"] = (result == QDialog::Accepted);
+        record["value"] = files->selectedFiles().value(0);
+    } else {
+        record["dialog"] = "other";
+        record["accepted"] = (result == QDialog::Accepted);
+    }
+    write(screen, "dialog", record);
+}
+
+/******************************************************************
+ * UiRecorder::write --
+ *   Append one interaction line.
+ *
+ * Parameters:
+ *   screen - screen of the window
+ *   op     - interaction type
+ *   record - the other fields
+ *
+ * Modifies:
+ *   - file
+ *
+ * Returns: nothing
+ ******************************************************************/
+void UiRecorder::write(int screen, const QString &op, QJsonObject record)
+{
+    record["screen"] = screen;
+    record["op"] = op;
+    file.write(QJsonDocument(record).toJson(QJsonDocument::Compact));
+    file.write("\n");
+    file.flush();
+}
@@ -0,0 +1,94 @@
+/******************************************************************
+ * uirecorder.h
+ *
+ * This header declares UiRecorder, which writes what customers and
+ * managers do in the customer windows to a JSONL file, one
+ * interaction per line. The file is the script for the UI replay
+ * tool (Cafeteria_UiReplay, see uireplay.h), which plays it back
+ * headless and reports latency per interaction.
+ *
+ * Recorded interactions (widgets by object name):
+ *   {"screen":0,"op":"combo","widget":"categoryComboBox","value":"Drinks"}
+ *   {"screen":0,"op":"select","widget":"itemsListWidget","value":["Fries"]}
+ *   {"screen":0,"op":"select","widget":"itemsListWidget","value":["Fries"],"keys":true}
+ *   {"screen":0,"op":"edit","widget":"managerItemsTableView","row":"Fries","column":2,"value":3.5}
+ *   {"screen":0,"op":"spin","widget":"quantitySpinBox","value":2}
+ *   {"screen":0,"op":"text","widget":"searchLineEdit","value":"fri"}
+ *   {"screen":0,"op":"click","widget":"checkoutButton"}
+ *   {"screen":0,"op":"key","key":54,"text":"6","modifiers":0}
+ *   {"screen":0,"op":"dialog","accepted":true,"value":"10OFF"}
+ *
+ * "key" lines are keys the window gets while no text box or spin
+ * box has focus (PLU keypad, the manager code); typing into those
+ * is recorded as their "text" or "spin" value. A selection changed
+ * with the keyboard (arrow keys, type-ahead) gets a "select" line
+ * with "keys":true after its "key" lines. An "edit" line is an
+ * inline table edit, by the row's first-column text and the column
+ * index, with the value the editor committed. A "dialog" line is
+ * written when a modal dialog closes, which is before the line of
+ * the click that opened it; the replay hands dialog answers out in
+ * the order they were recorded. Password fields are never written
+ * ("masked":true instead of a value).
+ *
+ * Enabled by CAFETERIA_UI_RECORD=<file> (the file is replaced).
+ *
+ ******************************************************************/
+
+#ifndef UIRECORDER_H
+#define UIRECORDER_H
+
+#include <QFile>
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+
+class QWidget;
+
+/******************************************************************
+ * UiRecorder
+ *
+ * Create it on the GUI thread and attach() every customer window.
+ * When CAFETERIA_UI_RECORD is unset, attach() does nothing.
+ ******************************************************************/
+class UiRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UiRecorder(QObject *parent = nullptr);
+
+    bool isEnabled() const { return file.isOpen(); }
+
+    /**************************************************************
+     * attach --
+     *   Starts recording the named buttons, combo boxes, item
+     *   views (selections and inline edits), spin boxes and line
+     *   edits of window, plus its keys and modal dialogs. screen is
+     *   written with every line.
+     **************************************************************/
+    void attach(QWidget *window, int screen);
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event) override;
+
+private slots:
+    void onDialogFinished(int result);
+
+private:
+    QFile file;                       // CAFETERIA_UI_RECORD
+    QHash<QWidget *, int> screens;    // Attached window -> screen
+
+    /**************************************************************
+     * Helper functions (internal use only)
+     *
+     * isRecorded() - true for widgets with a name of their own in
+     *                an attached window (not Qt's internal parts).
+     * write()      - appends one line and flushes it, so a crash
+     *                keeps everything up to the crash.
+     **************************************************************/
+    bool isRecorded(QWidget *widget, QWidget *window) const;
+    void write(int screen, const QString &op, QJsonObject record);
+};
+
+#endif // UIRECORDER_H
@@ -0,0 +1,617 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * uireplay.cpp
+ *
+ * This file implements the UiReplay class: headless replay of
+ * recorded UI sessions for latency regression checks.
+ *   - Reads scripts written by UiRecorder
+ *   - Drives real customer windows with Qt Test input events
+ *   - Answers modal dialogs from the script
+ *   - Reports p50/p90/p99 latency per interaction
+ *
+ ******************************************************************/
+
+#include "uireplay.h"
+#include "mainwindow.h"
+#include "sharedcatalog.h"
+#include <QAbstractButton>
+#include <QAbstractItemView>
+#include <QApplication>
+#include <QComboBox>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QInputDialog>
+#include <QItemSelectionModel>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPointer>
+#include <QSpinBox>
+#include <QTest>
+#include <QTimer>
+#include <QWindow>
+#include <algorithm>
+using namespace std;
+
+/******************************************************************
+ * UiReplay::UiReplay / ~UiReplay --
+ *   Defined here, where MainWindow and SharedCatalog are complete.
+ *   The windows are closed before the catalog they share.
+ ******************************************************************/
+UiReplay::UiReplay() = default;
+
+UiReplay::~UiReplay()
+{
+    windows.clear();
+}
+
+/******************************************************************
+ * UiReplay::run --
+ *   Entry point of the replay tool. See uireplay.h for options.
+ *
+ * Parameters:
+ *   arguments - command line (QCoreApplication::arguments())
+ *
+ * Modifies:
+ *   - current directory: workDir while the windows are open
+ *   - windows, samples and counters
+ *
+ * Returns:
+ *   0 on success, 1 on bad arguments, 2 if the replay diverged
+ ******************************************************************/
+int UiReplay::run(const QStringList &arguments)
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Cafeteria Ordering System - UI interaction replay");
+    parser.addPositionalArgument("script", "Script recorded with CAFETERIA_UI_RECORD.");
+    QCommandLineOption dataOption("data", "Directory with menu_items.txt and coupons.txt.", "dir", ".");
+    QCommandLineOption repeatOption("repeat", "Replay the script this many times.", "n", "1");
+    QCommandLineOption passwordOption("password", "Answer for password dialogs.", "text");
+    parser.addOption(dataOption);
+    parser.addOption(repeatOption);
+    parser.addOption(passwordOption);
+
+    if (!parser.parse(arguments) || parser.positionalArguments().size() != 1) {
+        err << parser.errorText() << "\n" << parser.helpText();
+        return 1;
+    }
+
+    int repeat = parser.value(repeatOption).toInt();
+    if (repeat < 1) {
+        repeat = 1;
+    }
+    password = parser.value(passwordOption);
+
+    if (!loadScript(parser.positionalArguments().first(), err)) {
+        return 1;
+    }
+    if (!copyData(parser.value(dataOption), err)) {
+        return 1;
+    }
+    const QString startDir = QDir::currentPath();
+    QDir::setCurrent(workDir.path());
+
+    catalog = std::make_unique<SharedCatalog>();
+    catalog->load();
+
+    int screenCount = 1;
+    for (const UiAction &action : actions) {
+        screenCount = qMax(screenCount, action.record.value("screen").toInt() + 1);
+    }
+    for (int i = 0; i < screenCount; ++i) {
+        windows.push_back(std::make_unique<MainWindow>(catalog.get(), i));
+        windows.back()->show();
+        if (!QTest::qWaitForWindowExposed(windows.back().get())) {
+            err << "Window " << i << " was not shown (is a display or QT_QPA_PLATFORM=offscreen available?)\n";
+            windows.clear();
+            QDir::setCurrent(startDir);
+            return 1;
+        }
+    }
+    windows.front()->activateWindow();
+
+    // Installed after the windows' own filters, so it runs first
+    qApp->installEventFilter(this);
+    settle();
+
+    QElapsedTimer total;
+    total.start();
+    QElapsedTimer timer;
+    for (int i = 0; i < repeat; ++i) {
+        nextDialog = 0;
+        for (const UiAction &action : actions) {
+            QString label;
+            timer.start();
+            if (!perform(action, label, err)) {
+                ++diverged;
+                continue;
+            }
+            settle();
+            samples[label].append(timer.nsecsElapsed());
+        }
+        if (nextDialog < dialogs.size()) {
+            err << scriptName << ": " << dialogs.size() - nextDialog << " dialog answer(s) left over\n";
+            dialogMisses += int(dialogs.size()) - nextDialog;
+        }
+    }
+    qint64 elapsedNs = total.nsecsElapsed();
+    qApp->removeEventFilter(this);
+
+    // Windows write their files relative to workDir until closed
+    windows.clear();
+    catalog.reset();
+    QDir::setCurrent(startDir);
+
+    printReport(elapsedNs, out);
+    return (diverged > 0 || dialogMisses > 0) ? 2 : 0;
+}
+
+/******************************************************************
+ * UiReplay::loadScript --
+ *   Read the whole script before anything is timed. Dialog answers
+ *   go to their own queue; everything else is an interaction.
+ *
+ * Parameters:
+ *   fileName - script path
+ *   err      - stream for error messages
+ *
+ * Modifies:
+ *   - actions, dialogs, scriptName
+ *
+ * Returns:
+ *   true if every line was a known interaction
+ ******************************************************************/
+bool UiReplay::loadScript(const QString &fileName, QTextStream &err)
+{
+    static const QStringList OPS = { "click", "combo", "select", "edit", "spin", "text", "key" };
+
+    scriptName = fileName;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        err << "Cannot open UI script: " << fileName << "\n";
+        return false;
+    }
+
+    int lineNumber = 0;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        QJsonParseError jsonError;
+        QJsonDocument doc = QJsonDocument::fromJson(line, &jsonError);
+        if (!doc.isObject()) {
+            err << fileName << ":" << lineNumber << ": invalid JSON: " << jsonError.errorString() << "\n";
+            return false;
+        }
+
+        UiAction action { doc.object(), lineNumber };
+        QString op = action.record.value("op").toString();
+        if (op == "dialog") {
+            dialogs.append(action);
+        } else if (OPS.contains(op)) {
+            actions.append(action);
+        } else {
+            err << fileName << ":" << lineNumber << ": unknown operation '" << op << "'\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/******************************************************************
+ * UiReplay::copyData --
+ *   Copy the menu and coupon files into workDir. A missing file is
+ *   fine: the catalog falls back to the built-in defaults, as the
+ *   kiosk would.
+ *
+ * Parameters:
+ *   dataDir - directory to copy from
+ *   err     - stream for error messages
+ *
+ * Returns:
+ *   false if workDir could not be created
+ ******************************************************************/
+bool UiReplay::copyData(const QString &dataDir, QTextStream &err)
+{
+    if (!workDir.isValid()) {
+        err << "Cannot create a scratch directory: " << workDir.errorString() << "\n";
+        return false;
+    }
+    for (const QString &name : { QString("menu_items.txt"), QString("coupons.txt") }) {
+        QString source = QDir(dataDir).filePath(name);
+        if (QFile::exists(source)) {
+            QFile::copy(source, workDir.filePath(name));
+        }
+    }
+    return true;
+}
+
+/******************************************************************
+ * UiReplay::perform --
+ *   Send one interaction to its window. Clicks, list selections and
+ *   keys go through Qt Test as input events; combo boxes and spin
+ *   boxes are set directly (Qt Test cannot drive their popups
+ *   portably), which fires the same slots. Keyboard selections are
+ *   set on the selection model (their keys were already sent) and
+ *   inline table edits go to the model's setData(), as the
+ *   delegate does when its editor commits.
+ *
+ * Parameters:
+ *   action - interaction to send
+ *   label  - receives "op widget", the row it is reported under
+ *   err    - stream for divergence messages
+ *
+ * Returns:
+ *   false if the window is not in the recorded state (widget
+ *   missing, hidden or disabled, item or entry not found)
+ ******************************************************************/
+bool UiReplay::perform(const UiAction &action, QString &label, QTextStream &err)
+{
+    const QJsonObject &record = action.record;
+    const QString op = record.value("op").toString();
+    const QString name = record.value("widget").toString();
+    int screen = qBound(0, record.value("screen").toInt(), int(windows.size()) - 1);
+    MainWindow *window = windows[screen].get();
+
+    auto fail = [&](const QString &why) {
+        err << scriptName << ":" << action.line << ": " << why << "\n";
+        return false;
+    };
+
+    if (op == "key") {
+        label = "key";
+        QTest::sendKeyEvent(QTest::Click, window->windowHandle(),
+                            Qt::Key(record.value("key").toInt()),
+                            record.value("text").toString(),
+                            Qt::KeyboardModifiers(record.value("modifiers").toInt()));
+        return true;
+    }
+
+    label = op + " " + name;
+    QWidget *widget = window->findChild<QWidget *>(name);
+    if (!widget) {
+        return fail("no widget '" + name + "'");
+    }
+    if (!widget->isVisible() || !widget->isEnabled()) {
+        return fail("'" + name + "' is hidden or disabled");
+    }
+
+    if (op == "click") {
+        QAbstractButton *button = qobject_cast<QAbstractButton *>(widget);
+        if (!button) {
+            return fail("'" + name + "' is not a button");
+        }
+        QTest::mouseClick(button, Qt::LeftButton);
+    } else if (op == "combo") {
+        QComboBox *combo = qobject_cast<QComboBox *>(widget);
+        int index = combo ? combo->findText(record.value("value").toString()) : -1;
+        if (index < 0) {
+            return fail("'" + name + "' has no entry '" + record.value("value").toString() + "'");
+        }
+        combo->setCurrentIndex(index);
+    } else if (op == "select" && record.value("keys").toBool()) {
+        QAbstractItemView *view = qobject_cast<QAbstractItemView *>(widget);
+        if (!view) {
+            return fail("'" + name + "' is not an item view");
+        }
+        const QJsonArray names = record.value("value").toArray();
+        QAbstractItemModel *model = view->model();
+        QItemSelection selection;
+        QModelIndex current;
+        for (const QJsonValue &row : names) {
+            QModelIndexList hits = model->match(model->index(0, 0), Qt::DisplayRole, row.toString(),
+                                                1, Qt::MatchExactly);
+            if (hits.isEmpty()) {
+                return fail("'" + name + "' has no row '" + row.toString() + "'");
+            }
+            selection.select(hits.first(), hits.first());
+            current = hits.first();
+        }
+        view->setFocus();
+        if (current.isValid()) {
+            view->selectionModel()->setCurrentIndex(current, QItemSelectionModel::NoUpdate);
+        }
+        view->selectionModel()->select(selection, QItemSelectionModel::ClearAndSelect
+                                                      | QItemSelectionModel::Rows);
+    } else if (op == "select") {
+        QAbstractItemView *view = qobject_cast<QAbstractItemView *>(widget);
+        if (!view) {
+            return fail("'" + name + "' is not an item view");
+        }
+        const QJsonArray names = record.value("value").toArray();
+        if (names.isEmpty()) {
+            view->clearSelection();
+        }
+        // First row as a plain click, the others as ctrl-clicks
+        for (int i = 0; i < names.size(); ++i) {
+            QAbstractItemModel *model = view->model();
+            QModelIndexList hits = model->match(model->index(0, 0), Qt::DisplayRole, names[i].toString(),
+                                                1, Qt::MatchExactly);
+            if (hits.isEmpty()) {
+                return fail("'" + name + "' has no row '" + names[i].toString() + "'");
+            }
+            view->scrollTo(hits.first());
+            QTest::mouseClick(view->viewport(), Qt::LeftButton,
+                              i == 0 ? Qt::NoModifier : Qt::ControlModifier,
+                              view->visualRect(hits.first()).center());
+        }
+    } else if (op == "edit") {
+        QAbstractItemView *view = qobject_cast<QAbstractItemView *>(widget);
+        if (!view) {
+            return fail("'" + name + "' is not an item view");
+        }
+        const QString row = record.value("row").toString();
+        QAbstractItemModel *model = view->model();
+        QModelIndexList hits = model->match(model->index(0, 0), Qt::DisplayRole, row, 1, Qt::MatchExactly);
+        if (hits.isEmpty()) {
+            return fail("'" + name + "' has no row '" + row + "'");
+        }
+        QModelIndex cell = hits.first().sibling(hits.first().row(), record.value("column").toInt());
+        if (!(model->flags(cell) & Qt::ItemIsEditable)) {
+            return fail("'" + name + "' cannot edit '" + row + "' column " + QString::number(cell.column()));
+        }
+        view->setCurrentIndex(cell);
+        model->setData(cell, record.value("value").toVariant(), Qt::EditRole);
+    } else if (op == "spin") {
+        QSpinBox *spin = qobject_cast<QSpinBox *>(widget);
+        if (!spin) {
+            return fail("'" + name + "' is not a spin box");
+        }
+        spin->setFocus();
+        spin->setValue(record.value("value").toInt());
+    } else if (op == "text") {
+        QLineEdit *edit = qobject_cast<QLineEdit *>(widget);
+        if (!edit) {
+            return fail("'" + name + "' is not a line edit");
+        }
+        typeText(window, edit, record.value("value").toString());
+    }
+    return true;
+}
+
+/******************************************************************
+ * UiReplay::typeText --
+ *   Focus a line edit and type into it, through the window like a
+ *   real keyboard, until it shows text: backspace over what differs,
+ *   then type the rest. One recorded "text" line is one keystroke,
+ *   so this is usually a single key.
+ *
+ * Parameters:
+ *   window - window of the line edit
+ *   edit   - line edit to type into
+ *   text   - text it should show afterwards
+ *
+ * Returns: nothing
+ ******************************************************************/
+void UiReplay::typeText(MainWindow *window, QLineEdit *edit, const QString &text)
+{
+    edit->setFocus();
+    edit->end(false);
+
+    const QString current = edit->text();
+    int common = 0;
+    while (common < current.size() && common < text.size() && current[common] == text[common]) {
+        ++common;
+    }
+    for (int i = int(current.size()); i > common; --i) {
+        QTest::sendKeyEvent(QTest::Click, window->windowHandle(), Qt::Key_Backspace, QString(), Qt::NoModifier);
+    }
+    for (int i = common; i < text.size(); ++i) {
+        QChar ch = text[i];
+        Qt::Key key = ch.unicode() < 128 ? Qt::Key(ch.toUpper().unicode()) : Qt::Key_unknown;
+        QTest::sendKeyEvent(QTest::Click, window->windowHandle(), key, QString(ch), Qt::NoModifier);
+    }
+}
+
+/******************************************************************
+ * UiReplay::settle --
+ *   Wait until everything the interaction posted (repaints, queued
+ *   signals) has been handled: a queued call posted now runs after
+ *   all of it.
+ ******************************************************************/
+void UiReplay::settle()
+{
+    bool drained = false;
+    QMetaObject::invokeMethod(this, [&drained]() { drained = true; }, Qt::QueuedConnection);
+    QTest::qWaitFor([&drained]() { return drained; }, SETTLE_TIMEOUT_MS);
+}
+
+/******************************************************************
+ * UiReplay::eventFilter --
+ *   Answer modal dialogs as soon as their own event loop runs. The
+ *   non-modal receipt box is left alone, as customers do.
+ *
+ * Returns:
+ *   false (events are only observed)
+ ******************************************************************/
+bool UiReplay::eventFilter(QObject *obj, QEvent *event)
+{
+    if (event->type() == QEvent::Show) {
+        QDialog *dialog = qobject_cast<QDialog *>(obj);
+        if (dialog && dialog->isModal()) {
+            QPointer<QDialog> guard(dialog);
+            QTimer::singleShot(0, dialog, [this, guard]() {
+                if (guard) {
+                    answer(guard);
+                }
+            });
+        }
+    }
+    return false;
+}
+
+/******************************************************************
+ * UiReplay::answer --
+ *   Answer a modal dialog with the next recorded answer. A dialog
+ *   with no answer left, or of another kind than recorded, is
+ *   cancelled and counted, so the replay never hangs in it.
+ *
+ * Parameters:
+ *   dialog - dialog in its exec() loop
+ *
+ * Modifies:
+ *   - nextDialog, dialogMisses
+ *
+ * Returns: nothing
+ ******************************************************************/
+void UiReplay::answer(QDialog *dialog)
+{
+    auto miss = [&](const QString &why) {
+        qWarning("%s: %s (\"%s\"), cancelled", qPrintable(scriptName), qPrintable(why),
+                 qPrintable(dialog->windowTitle()));
+        ++dialogMisses;
+        dialog->reject();
+    };
+
+    if (nextDialog >= dialogs.size()) {
+        miss("unexpected dialog");
+        return;
+    }
+    const QJsonObject record = dialogs[nextDialog++].record;
+    const QString kind = record.value("dialog").toString();
+    const bool accepted = record.value("accepted").toBool();
+
+    if (QMessageBox *box = qobject_cast<QMessageBox *>(dialog)) {
+        if (kind != "message") {
+            miss("message box instead of " + kind + " dialog");
+            return;
+        }
+        const QString text = record.value("button").toString();
+        const QList<QAbstractButton *> buttons = box->buttons();
+        for (QAbstractButton *button : buttons) {
+            if (button->text() == text) {
+                button->click();
+                return;
+            }
+        }
+        miss("no button '" + text + "'");
+    } else if (QInputDialog *input = qobject_cast<QInputDialog *>(dialog)) {
+        if (kind != "input") {
+            miss("input dialog instead of " + kind + " dialog");
+            return;
+        }
+        if (!accepted) {
+            input->reject();
+            return;
+        }
+        if (record.value("masked").toBool()) {
+            if (password.isEmpty()) {
+                miss("password dialog without --password");
+                return;
+            }
+            input->setTextValue(password);
+        } else if (input->inputMode() == QInputDialog::IntInput) {
+            input->setIntValue(record.value("value").toInt());
+        } else if (input->inputMode() == QInputDialog::DoubleInput) {
+            input->setDoubleValue(record.value("value").toDouble());
+        } else {
+            input->setTextValue(record.value("value").toString());
+        }
+        input->accept();
+    } else if (QFileDialog *files = qobject_cast<QFileDialog *>(dialog)) {
+        if (kind != "file") {
+            miss("file dialog instead of " + kind + " dialog");
+            return;
+        }
+        if (!accepted) {
+            files->reject();
+            return;
+        }
+        // Same file name, but in the scratch directory
+        files->selectFile(workDir.filePath(QFileInfo(record.value("value").toString()).fileName()));
+        files->accept();
+    } else if (accepted) {
+        dialog->accept();
+    } else {
+        dialog->reject();
+    }
+}
+
+/******************************************************************
+ * UiReplay::percentile --
+ *   Nearest-rank percentile.
+ *
+ * Parameters:
+ *   sorted - samples sorted ascending
+ *   p      - percentile in [0, 100]
+ *
+ * Returns:
+ *   the sample at that rank, or 0 if there are no samples
+ ******************************************************************/
+qint64 UiReplay::percentile(const QVector<qint64> &sorted, double p)
+{
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+    int count = static_cast<int>(sorted.size());
+    int rank = static_cast<int>(p / 100.0 * count + 0.5);
+    rank = qBound(1, rank, count);
+    return sorted[rank - 1];
+}
+
+/******************************************************************
+ * UiReplay::printReport --
+ *   Print a latency table (milliseconds) with one row per
+ *   interaction ("op widget") plus an "all" row, then anything
+ *   that did not replay as recorded.
+ *
+ * Parameters:
+ *   elapsedNs - wall time of the whole replay in nanoseconds
+ *   out       - output stream
+ *
+ * Returns: nothing
+ ******************************************************************/
+void UiReplay::printReport(qint64 elapsedNs, QTextStream &out) const
+{
+    QVector<qint64> all;
+    for (const QVector<qint64> &rowSamples : samples) {
+        all << rowSamples;
+    }
+
+    out << QString("Replayed %1 interactions in %2 ms\n\n")
+               .arg(all.size())
+               .arg(elapsedNs / 1e6, 0, 'f', 1);
+
+    out << QString("%1%2%3%4%5%6\n")
+               .arg("interaction", -34)
+               .arg("count", 8)
+               .arg("p50 (ms)", 11)
+               .arg("p90 (ms)", 11)
+               .arg("p99 (ms)", 11)
+               .arg("max (ms)", 11);
+
+    auto row = [&out](const QString &label, QVector<qint64> rowSamples) {
+        sort(rowSamples.begin(), rowSamples.end());
+        qint64 maxNs = rowSamples.isEmpty() ? 0 : rowSamples.last();
+        out << QString("%1%2%3%4%5%6\n")
+                   .arg(label, -34)
+                   .arg(rowSamples.size(), 8)
+                   .arg(percentile(rowSamples, 50) / 1e6, 11, 'f', 2)
+                   .arg(percentile(rowSamples, 90) / 1e6, 11, 'f', 2)
+                   .arg(percentile(rowSamples, 99) / 1e6, 11, 'f', 2)
+                   .arg(maxNs / 1e6, 11, 'f', 2);
+    };
+    for (auto it = samples.constBegin(); it != samples.constEnd(); ++it) {
+        row(it.key(), it.value());
+    }
+    row("all", all);
+
+    if (diverged > 0 || dialogMisses > 0) {
+        out << QString("\nNot replayed as recorded: %1 interaction(s), %2 dialog(s)\n")
+                   .arg(diverged)
+                   .arg(dialogMisses);
+    }
+    out.flush();
+}
@@ -0,0 +1,133 @@
+/******************************************************************
+ * uireplay.h
+ *
+ * This header declares the UiReplay class, the core of the UI
+ * replay tool (Cafeteria_UiReplay). It plays a script recorded by
+ * UiRecorder (see uirecorder.h) back against real customer windows,
+ * using Qt Test to send the clicks and keys, and reports latency
+ * percentiles per interaction. Without a display it runs on the
+ * "offscreen" platform, so CI machines can compare the end-to-end
+ * UI responsiveness of two builds on the same recorded lunch rush.
+ *
+ * The latency of one interaction is the time from sending its
+ * input until the window's event queue has drained, including any
+ * repaint and any modal dialog it opened (answered at once from the
+ * script). An order's payment and logging finish asynchronously;
+ * the window's handling of that is part of whichever interaction
+ * is being replayed when it arrives.
+ *
+ ******************************************************************/
+
+#ifndef UIREPLAY_H
+#define UIREPLAY_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+class MainWindow;
+class SharedCatalog;
+class QDialog;
+class QLineEdit;
+
+/******************************************************************
+ * UiAction
+ *
+ * One line of a recorded script.
+ *
+ * Members:
+ *   record - the JSON object as recorded
+ *   line   - line number in the script (for messages)
+ ******************************************************************/
+struct UiAction {
+    QJsonObject record;
+    int line;
+};
+
+/******************************************************************
+ * UiReplay
+ *
+ * Replays in a scratch directory holding copies of the menu and
+ * coupon files, so the order log, receipts, journals and any menu
+ * the script saves never touch the real ones. Windows are created
+ * for every screen the script uses.
+ ******************************************************************/
+class UiReplay : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int SETTLE_TIMEOUT_MS = 5000;   // Longest wait for one interaction
+
+    UiReplay();
+    ~UiReplay() override;
+
+    /**************************************************************
+     * run --
+     *   Parses the command line, sets up the windows, replays the
+     *   script and prints the report.
+     *
+     *   Arguments and options:
+     *     <script>           recorded JSONL script
+     *     --data <dir>       where menu_items.txt and coupons.txt
+     *                        are copied from (default ".")
+     *     --repeat <n>       replay the whole script n times
+     *     --password <text>  answer for password dialogs (they are
+     *                        recorded without their text)
+     *
+     *   Returns the process exit code: 0 on success, 1 on bad
+     *   arguments or an unreadable script, 2 if the replay went
+     *   differently from the recording (missing widget or item,
+     *   unexpected dialog), which makes its timings incomparable.
+     **************************************************************/
+    int run(const QStringList &arguments);
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event) override;
+
+private:
+    QTemporaryDir workDir;                        // Scratch working directory
+    std::unique_ptr<SharedCatalog> catalog;
+    std::vector<std::unique_ptr<MainWindow>> windows;   // Destroyed before the catalog
+
+    QVector<UiAction> actions;     // Interactions, in order
+    QVector<UiAction> dialogs;     // Dialog answers, in order
+    int nextDialog = 0;            // Next answer to hand out
+    QString password;
+    QString scriptName;
+
+    QMap<QString, QVector<qint64>> samples;   // "op widget" -> latency (ns)
+    int diverged = 0;              // Interactions that could not be replayed
+    int dialogMisses = 0;          // Dialogs without a matching answer
+
+    /**************************************************************
+     * Helper functions (internal use only)
+     *
+     * loadScript()  - reads the script into actions and dialogs.
+     * copyData()    - copies the data files into workDir.
+     * perform()     - sends one interaction; false if it cannot be
+     *                 replayed (message on err).
+     * typeText()    - types into a line edit until it shows text.
+     * settle()      - waits until the event queue has drained.
+     * answer()      - answers a modal dialog from dialogs.
+     * printReport() - prints the latency table.
+     * percentile()  - nearest-rank percentile of sorted samples.
+     **************************************************************/
+    bool loadScript(const QString &fileName, QTextStream &err);
+    bool copyData(const QString &dataDir, QTextStream &err);
+    bool perform(const UiAction &action, QString &label, QTextStream &err);
+    void typeText(MainWindow *window, QLineEdit *edit, const QString &text);
+    void settle();
+    void answer(QDialog *dialog);
+    void printReport(qint64 elapsedNs, QTextStream &out) const;
+    static qint64 percentile(const QVector<qint64> &sorted, double p);
+};
+
+#endif // UIREPLAY_H
@@ -0,0 +1,49 @@
+/******************************************************************
+ * uireplaymain.cpp
+ *
+ * This file contains the entry point of the UI replay tool
+ * (Cafeteria_UiReplay). It replays a script recorded with
+ * CAFETERIA_UI_RECORD against real customer windows and prints
+ * latency percentiles per interaction (see uireplay.h).
+ *
+ * Unless QT_QPA_PLATFORM says otherwise, the windows are created on
+ * the "offscreen" platform, so no display is needed:
+ *
+ *   Cafeteria_UiReplay --data kiosk/ --repeat 5 lunch.jsonl
+ *
+ ******************************************************************/
+
+#include "uireplay.h"
+#include "tracer.h"
+#include <QApplication>
+
+/******************************************************************
+ * main --
+ *   Program entry point of the replay tool.
+ *
+ * Parameters:
+ *   argc - number of command-line arguments
+ *   argv - array of C-strings containing the arguments
+ *
+ * Returns:
+ *   int - exit code from UiReplay::run()
+ ******************************************************************/
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    // Record trace spans if CAFETERIA_TRACE names an output file
+    Tracer::initFromEnvironment();
+
+    QApplication app(argc, argv);
+    int result;
+    {
+        UiReplay replay;
+        result = replay.run(app.arguments());
+    }
+
+    Tracer::flush();
+    return result;
+}
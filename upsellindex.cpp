@@ -0,0 +1,307 @@
+/******************************************************************
+ * ENSC-151 GROUP 30 – Cafeteria Ordering System
+ *
+ * upsellindex.cpp
+ *
+ * This file implements UpsellIndex: incremental updates of the
+ * sparse co-occurrence matrix, cart suggestions and seeding from
+ * the order logs.
+ *
+ ******************************************************************/
+
+#include "upsellindex.h"
+#include <QFile>
+#include <QRegularExpression>
+#include <QVarLengthArray>
+#include <algorithm>
+
+namespace {
+
+/******************************************************************
+ * splitCsvLine --
+ *   Split one order log line into fields. Quoted fields may hold
+ *   commas and doubled quotes (see csvField() in
+ *   checkoutpipeline.cpp).
+ ******************************************************************/
+QStringList splitCsvLine(const QString &line)
+{
+    QStringList fields;
+    QString field;
+    bool quoted = false;
+    for (int i = 0; i < line.size(); ++i) {
+        QChar ch = line[i];
+        if (quoted) {
+            if (ch == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                field += '"';
+                ++i;
+            } else if (ch == '"') {
+                quoted = false;
+            } else {
+                field += ch;
+            }
+        } else if (ch == '"') {
+            quoted = true;
+        } else if (ch == ',') {
+            fields << field;
+            field.clear();
+        } else {
+            field += ch;
+        }
+    }
+    fields << field;
+    return fields;
+}
+
+} // namespace
+
+/******************************************************************
+ * UpsellIndex::idOf --
+ *   Row of an item, added on first sight.
+ ******************************************************************/
+int UpsellIndex::idOf(const QString &name)
+{
+    auto it = ids.constFind(name);
+    if (it != ids.constEnd()) {
+        return it.value();
+    }
+    int id = int(rows.size());
+    ids.insert(name, id);
+    names << name;
+    rows.append(Row());
+    return id;
+}
+
+/******************************************************************
+ * UpsellIndex::addOrder --
+ *   Count one order: every item's order count and every pair of
+ *   its items, in both directions. Each pair count only grows, so
+ *   a row's top list is kept by moving the one changed partner up
+ *   (at most TOP_PER_ITEM steps) instead of re-sorting the row.
+ *
+ * Parameters:
+ *   items - item names of the order
+ *
+ * Modifies:
+ *   - rows (new rows for new items), orders
+ *
+ * Returns: nothing
+ ******************************************************************/
+void UpsellIndex::addOrder(const QStringList &items)
+{
+    QVarLengthArray<int, 16> order;
+    for (const QString &name : items) {
+        int id = idOf(name);
+        if (std::find(order.begin(), order.end(), id) == order.end()) {
+            order.append(id);
+        }
+    }
+    if (order.isEmpty()) {
+        return;
+    }
+
+    ++orders;
+    for (int a : order) {
+        Row &row = rows[a];
+        ++row.orders;
+        for (int b : order) {
+            if (b != a) {
+                raise(row, b, ++row.together[b]);
+            }
+        }
+    }
+}
+
+/******************************************************************
+ * UpsellIndex::raise --
+ *   partner's count in row went up to count: update it in the top
+ *   list (or let it in, replacing the weakest) and move it up past
+ *   weaker entries.
+ ******************************************************************/
+void UpsellIndex::raise(Row &row, int partner, int count)
+{
+    int i = 0;
+    while (i < row.top.size() && row.top[i].first != partner) {
+        ++i;
+    }
+    if (i < row.top.size()) {
+        row.top[i].second = count;
+    } else if (row.top.size() < TOP_PER_ITEM) {
+        row.top.append(qMakePair(partner, count));
+    } else if (count > row.top.last().second) {
+        row.top.last() = qMakePair(partner, count);
+        i = int(row.top.size()) - 1;
+    } else {
+        return;
+    }
+
+    while (i > 0 && row.top[i - 1].second < row.top[i].second) {
+        std::swap(row.top[i - 1], row.top[i]);
+        --i;
+    }
+}
+
+/******************************************************************
+ * UpsellIndex::rebuildTop --
+ *   Recompute a row's top list from all its pairs.
+ ******************************************************************/
+void UpsellIndex::rebuildTop(Row &row)
+{
+    row.top.clear();
+    for (auto it = row.together.constBegin(); it != row.together.constEnd(); ++it) {
+        row.top.append(qMakePair(it.key(), it.value()));
+    }
+    int kept = qMin(int(row.top.size()), int(TOP_PER_ITEM));
+    std::partial_sort(row.top.begin(), row.top.begin() + kept, row.top.end(),
+                      [](const QPair<int, int> &a, const QPair<int, int> &b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
+    row.top.resize(kept);
+}
+
+/******************************************************************
+ * UpsellIndex::merge --
+ *   Add the counts of another index. Rows are matched by item name
+ *   and every touched row's top list is recomputed.
+ *
+ * Parameters:
+ *   other - index to add
+ *
+ * Modifies:
+ *   - rows, orders
+ *
+ * Returns: nothing
+ ******************************************************************/
+void UpsellIndex::merge(const UpsellIndex &other)
+{
+    QVector<int> mapped;
+    mapped.reserve(other.names.size());
+    for (const QString &name : other.names) {
+        mapped.append(idOf(name));
+    }
+
+    for (int i = 0; i < other.rows.size(); ++i) {
+        const Row &from = other.rows[i];
+        Row &row = rows[mapped[i]];
+        row.orders += from.orders;
+        for (auto it = from.together.constBegin(); it != from.together.constEnd(); ++it) {
+            row.together[mapped[it.key()]] += it.value();
+        }
+        rebuildTop(row);
+    }
+    orders += other.orders;
+}
+
+/******************************************************************
+ * UpsellIndex::suggest --
+ *   Score the top partners of every cart item and return the best
+ *   ones that accept() allows.
+ *
+ * Parameters:
+ *   cart   - item names in the cart
+ *   count  - how many suggestions at most
+ *   accept - whether an item may be offered now
+ *
+ * Returns:
+ *   item names, best first (empty for an empty or unknown cart)
+ ******************************************************************/
+QStringList UpsellIndex::suggest(const QStringList &cart, int count,
+                                 const std::function<bool(const QString &)> &accept) const
+{
+    QVarLengthArray<int, 16> inCart;
+    for (const QString &name : cart) {
+        int id = ids.value(name, -1);
+        if (id >= 0) {
+            inCart.append(id);
+        }
+    }
+
+    QVarLengthArray<QPair<int, double>, 64> scores;
+    for (int a : inCart) {
+        const Row &row = rows[a];
+        for (const QPair<int, int> &partner : row.top) {
+            if (partner.second < MIN_TOGETHER) {
+                break;   // Sorted: the rest are rarer still
+            }
+            if (std::find(inCart.begin(), inCart.end(), partner.first) != inCart.end()) {
+                continue;
+            }
+            double score = double(partner.second) / row.orders;
+            auto it = std::find_if(scores.begin(), scores.end(), [&](const QPair<int, double> &entry) {
+                return entry.first == partner.first;
+            });
+            if (it != scores.end()) {
+                it->second += score;
+            } else {
+                scores.append(qMakePair(partner.first, score));
+            }
+        }
+    }
+
+    std::sort(scores.begin(), scores.end(), [](const QPair<int, double> &a, const QPair<int, double> &b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+
+    QStringList result;
+    for (const QPair<int, double> &entry : scores) {
+        if (result.size() >= count) {
+            break;
+        }
+        if (accept(names[entry.first])) {
+            result << names[entry.first];
+        }
+    }
+    return result;
+}
+
+/******************************************************************
+ * UpsellIndex::readOrderLog --
+ *   Count every order in an order log. The header line and lines
+ *   without items are skipped. Lines are read raw from the file,
+ *   so its position is known exactly and reading stops at limit.
+ *
+ * Parameters:
+ *   fileName - order log (CSV)
+ *   limit    - file size to read up to, or -1 for all of it
+ *
+ * Modifies:
+ *   - rows, orders
+ *
+ * Returns:
+ *   true if the file was read
+ ******************************************************************/
+bool UpsellIndex::readOrderLog(const QString &fileName, qint64 limit)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    if (limit < 0) {
+        limit = file.size();
+    }
+
+    static const QRegularExpression ITEM_PATTERN("^\\d+x (.+)$");
+    const int ITEMS_FIELD = 5;   // time,order,total,coupon,auth,items
+
+    QStringList items;
+    while (file.pos() < limit && !file.atEnd()) {
+        QByteArray line = file.readLine();
+        while (line.endsWith('\n') || line.endsWith('\r')) {
+            line.chop(1);
+        }
+        QStringList fields = splitCsvLine(QString::fromUtf8(line));
+        if (fields.size() <= ITEMS_FIELD || fields.first() == "time") {
+            continue;
+        }
+
+        items.clear();
+        const QStringList lines = fields[ITEMS_FIELD].split(';');
+        for (const QString &line : lines) {
+            QRegularExpressionMatch match = ITEM_PATTERN.match(line.trimmed());
+            if (match.hasMatch()) {
+                items << match.captured(1);
+            }
+        }
+        addOrder(items);
+    }
+    return true;
+}
@@ -0,0 +1,108 @@
+/******************************************************************
+ * upsellindex.h
+ *
+ * This header declares UpsellIndex, the "frequently bought
+ * together" data behind the upsell panel of the customer view.
+ *
+ * It is a sparse item-by-item co-occurrence matrix over completed
+ * orders: for every item, how many orders contained it and, for
+ * every other item, how many orders contained both. Only pairs that
+ * were actually bought together are stored. Each checkout adds its
+ * order in place (no rebuild), and every item keeps its TOP_PER_ITEM
+ * strongest partners sorted, so a suggestion for a cart looks at
+ * TOP_PER_ITEM entries per cart line and nothing else - a few
+ * microseconds, independent of the menu size and order history.
+ *
+ * A partner b of cart item a scores together(a, b) / orders(a),
+ * the share of a's orders that also had b; scores add up over the
+ * cart, so items that go with several cart lines come first.
+ *
+ ******************************************************************/
+
+#ifndef UPSELLINDEX_H
+#define UPSELLINDEX_H
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+/******************************************************************
+ * UpsellIndex
+ *
+ * Not thread-safe: used on the GUI thread (a worker may build a
+ * separate index from the order logs, see readOrderLog()).
+ ******************************************************************/
+class UpsellIndex
+{
+public:
+    static const int TOP_PER_ITEM = 8;   // Partners kept per item for queries
+    static const int MIN_TOGETHER = 2;   // Pairs seen fewer times are not suggested
+
+    /**************************************************************
+     * addOrder --
+     *   Counts one completed order (item names; repeats ignored).
+     *
+     * merge --
+     *   Adds every count of other (used once, when the order log
+     *   history arrives after this session's first orders).
+     *
+     * orderCount --
+     *   Orders counted so far.
+     **************************************************************/
+    void addOrder(const QStringList &items);
+    void merge(const UpsellIndex &other);
+    int orderCount() const { return orders; }
+
+    /**************************************************************
+     * suggest --
+     *   Up to count items to offer with the cart, best first.
+     *   Items in the cart are never suggested; accept() decides
+     *   whether an item may be offered now (category, schedule,
+     *   stock) and is only called for the best candidates.
+     **************************************************************/
+    QStringList suggest(const QStringList &cart, int count,
+                        const std::function<bool(const QString &)> &accept) const;
+
+    /**************************************************************
+     * readOrderLog --
+     *   Adds every order of an order log written by the checkout
+     *   pipeline ("time,order,total,coupon,auth,items" with items
+     *   like "2x Fries;1x Soda"). Only lines that start before
+     *   byte limit are read (-1: the whole file), so orders
+     *   appended after the caller took the file's size are not
+     *   counted twice. Returns false if the file cannot be read.
+     **************************************************************/
+    bool readOrderLog(const QString &fileName, qint64 limit = -1);
+
+private:
+    /**************************************************************
+     * Row
+     *
+     * One item's row of the matrix.
+     *
+     * Members:
+     *   orders   - orders that contained the item
+     *   together - partner id -> orders with both (sparse)
+     *   top      - the TOP_PER_ITEM largest entries of together,
+     *              largest first
+     **************************************************************/
+    struct Row {
+        int orders = 0;
+        QHash<int, int> together;
+        QVector<QPair<int, int>> top;
+    };
+
+    QHash<QString, int> ids;     // Item name -> row
+    QStringList names;           // Row -> item name
+    QVector<Row> rows;
+    int orders = 0;
+
+    int idOf(const QString &name);
+    static void raise(Row &row, int partner, int count);
+    static void rebuildTop(Row &row);
+};
+
+#endif // UPSELLINDEX_H